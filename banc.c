@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "traitementTexte.h"
+#include "corpus.h"
+
+/**
+ * @file
+ * @brief Banc d'essai du traitement de texte.
+ *
+ * "./banc [--phrases n] [--graine s]" génère un corpus de n phrases, l'analyse avec la grammaire de chaque phrase puis
+ * avec identification automatique de la langue, et affiche pour chaque passe le débit, le nombre d'allocations
+ * par phrase (avec "make ALLOCATIONS=1") et la proportion de phrases dont les actions sont exactement celles
+ * attendues. Les phrases écrites à la main de corpus_libres sont ensuite vérifiées de la même façon.
+ * "./banc --generer [--phrases n] [--graine s]" écrit seulement le corpus sur la sortie standard, au format
+ * "langue<TAB>phrase" de "./main --lot".
+ */
+
+/**
+ * @defgroup banc Banc d'essai
+ * @brief Débit, allocations et exactitude de l'analyse sur un corpus généré.
+ * @{
+ */
+
+static unsigned long nb_allocations = 0;
+
+#ifdef BANC_COMPTER_ALLOCATIONS
+//Compteur d'allocations : "make ALLOCATIONS=1" lie le banc avec -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,
+//qui redirige les appels du banc et de l'analyse vers ces versions qui comptent les appels.
+void *__real_malloc(size_t taille);
+void *__real_calloc(size_t nombre, size_t taille);
+void *__real_realloc(void *p, size_t taille);
+
+void *__wrap_malloc(size_t taille) {
+    nb_allocations++;
+    return __real_malloc(taille);
+}
+
+void *__wrap_calloc(size_t nombre, size_t taille) {
+    nb_allocations++;
+    return __real_calloc(nombre, taille);
+}
+
+void *__wrap_realloc(void *p, size_t taille) {
+    nb_allocations++;
+    return __real_realloc(p, taille);
+}
+#define ALLOCATIONS_COMPTEES true
+#else
+#define ALLOCATIONS_COMPTEES false
+#endif
+
+#define ERREURS_AFFICHEES 5    //Nombre de phrases mal analysées affichées par passe.
+
+static double secondes(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double) t.tv_sec + (double) t.tv_nsec / 1e9;
+}
+
+static void afficherAction(const char *titre, const ActionData *a) {
+    ActionTexte t;
+    action_versTexte(a, &t);
+    fprintf(stderr, "    %s [%s|%s|%s|%s]\n", titre, t.action, t.param1, t.param2, t.type);
+}
+
+/**
+ * @brief Analyse chaque phrase et compare les actions obtenues aux actions attendues. Les premières phrases mal
+ * analysées sont affichées sur la sortie d'erreur.
+ * @param automatique true pour analyser avec GRAMMAIRE_AUTO, false avec la grammaire de chaque phrase.
+ * @return Le nombre de phrases correctement analysées.
+ */
+static int verifier(const PhraseCorpus *corpus, int nb_phrases, bool automatique) {
+    Queue q = createQueue();
+    int correctes = 0, erreurs_affichees = 0;
+
+    for (int i = 0; i < nb_phrases; i++) {
+        const PhraseCorpus *p = &corpus[i];
+        ActionData obtenues[CORPUS_ACTIONS_MAX];
+        int nb_obtenues = 0;
+
+        analyserPhrase(automatique ? &GRAMMAIRE_AUTO : grammaire_langue(p->langue), p->texte, &q);
+        bool correcte = (q.size == p->nb_actions);
+        while (!isQueueEmpty(&q)) {
+            ActionData a = dequeue(&q);
+            if (nb_obtenues < CORPUS_ACTIONS_MAX) {
+                correcte = correcte && corpus_actionsEgales(&a, &p->attendues[nb_obtenues]);
+                obtenues[nb_obtenues++] = a;
+            }
+        }
+        if (correcte) {
+            correctes++;
+        } else if (erreurs_affichees++ < ERREURS_AFFICHEES) {
+            fprintf(stderr, "  Phrase mal analysée : %s\n", p->texte);
+            for (int j = 0; j < p->nb_actions; j++) {
+                afficherAction("attendue :", &p->attendues[j]);
+            }
+            for (int j = 0; j < nb_obtenues; j++) {
+                afficherAction("obtenue :", &obtenues[j]);
+            }
+        }
+    }
+    destroyQueue(&q);
+    return correctes;
+}
+
+/**
+ * @brief Analyse tout le corpus et affiche le résultat de la passe. Le corpus est analysé une première fois pour
+ * mesurer le débit et les allocations, puis une seconde fois pour comparer les actions obtenues aux actions attendues.
+ * @param automatique true pour analyser avec GRAMMAIRE_AUTO, false avec la grammaire de chaque phrase.
+ */
+static void passe(const PhraseCorpus *corpus, int nb_phrases, size_t nb_octets, bool automatique) {
+    Queue q = createQueue();
+
+    unsigned long allocations = nb_allocations;
+    double duree = secondes();
+    for (int i = 0; i < nb_phrases; i++) {
+        analyserPhrase(automatique ? &GRAMMAIRE_AUTO : grammaire_langue(corpus[i].langue), corpus[i].texte, &q);
+        while (!isQueueEmpty(&q)) {
+            dequeue(&q);
+        }
+    }
+    duree = secondes() - duree;
+    allocations = nb_allocations - allocations;
+    destroyQueue(&q);
+
+    int correctes = verifier(corpus, nb_phrases, automatique);
+    printf("%-10s : %9.0f phrases/s, %6.1f Mo/s, ", automatique ? "auto" : "fr/es",
+           nb_phrases / duree, nb_octets / duree / 1e6);
+    if (ALLOCATIONS_COMPTEES) {
+        printf("%.3f allocation(s)/phrase, ", (double) allocations / nb_phrases);
+    }
+    printf("%.2f %% correctes (%d/%d)\n", 100.0 * correctes / nb_phrases, correctes, nb_phrases);
+}
+
+/**
+ * @brief Vérifie les phrases écrites à la main (corpus_libres), hors mesure : leurs mots courants et leurs fautes
+ * de frappe ne figurent pas dans le corpus généré.
+ */
+static void passeLibre(bool automatique) {
+    int nb_phrases;
+    const PhraseCorpus *libres = corpus_libres(&nb_phrases);
+    int correctes = verifier(libres, nb_phrases, automatique);
+
+    printf("%-10s : %.2f %% correctes (%d/%d)\n", automatique ? "libre auto" : "libre", 100.0 * correctes / nb_phrases,
+           correctes, nb_phrases);
+}
+
+int main(int argc, char *argv[]) {
+    int nb_phrases = 100000;
+    unsigned int graine = 1;
+    bool generer = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--generer") == 0) {
+            generer = true;
+        } else if (strcmp(argv[i], "--phrases") == 0 && i + 1 < argc) {
+            nb_phrases = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--graine") == 0 && i + 1 < argc) {
+            graine = (unsigned int) strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "Usage : %s [--generer] [--phrases <n>] [--graine <s>]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (nb_phrases <= 0) {
+        return 0;
+    }
+
+    PhraseCorpus *corpus = malloc((size_t) nb_phrases * sizeof(PhraseCorpus));
+    size_t nb_octets = 0;
+    if (corpus == NULL) {
+        fprintf(stderr, "Erreur: corpus trop grand.\n");
+        return 1;
+    }
+    for (int i = 0; i < nb_phrases; i++) {
+        corpus_generer(&corpus[i], &graine);
+        nb_octets += strlen(corpus[i].texte);
+    }
+
+    if (generer) {
+        for (int i = 0; i < nb_phrases; i++) {
+            printf("%s\t%s\n", grammaire_langue(corpus[i].langue)->code, corpus[i].texte);
+        }
+    } else {
+        printf("Corpus : %d phrases, %.1f Mo\n", nb_phrases, nb_octets / 1e6);
+        Queue q = createQueue();
+        analyserPhrase(&GRAMMAIRE_AUTO, corpus[0].texte, &q);    //Construit l'index du lexique hors mesure.
+        destroyQueue(&q);
+        passe(corpus, nb_phrases, nb_octets, false);
+        passe(corpus, nb_phrases, nb_octets, true);
+        passeLibre(false);
+        passeLibre(true);
+    }
+    free(corpus);
+    return 0;
+}
+
+/**
+ * @}
+ */
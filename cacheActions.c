@@ -0,0 +1,311 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "cacheActions.h"
+#include "normalisation.h"
+
+/**
+ * @file
+ * @brief Ce fichier rassemble les fonctions du cache LRU des phrases analysées.
+ *
+ * La clé d'une phrase est sa langue et sa forme normalisée : les mots en minuscules et sans accents, séparés par
+ * une seule espace. C'est exactement ce que voit le moteur d'analyse, qui ignore la casse, les accents et la
+ * ponctuation, donc deux
+ * phrases de même clé produisent les mêmes actions. La recherche calcule le hachage et compare la clé
+ * directement sur la phrase reçue : un succès ne coûte ni allocation ni analyse.
+ *
+ * Les entrées sont rangées dans une table de hachage (chainage) et dans une liste doublement chainée, de la
+ * plus récemment utilisée à la plus ancienne. Le cache est protégé par un verrou et peut être partagé
+ * entre threads.
+ */
+
+/**
+ * @defgroup cache Cache des phrases analysées
+ * @brief Mémorisation des actions produites par les phrases les plus fréquentes.
+ * @{
+ */
+
+/**
+ * @brief Phrase mémorisée et actions qu'elle produit.
+ */
+typedef struct EntreeCache {
+    struct EntreeCache *plus_recente;     /**< Voisines dans la liste LRU. */
+    struct EntreeCache *plus_ancienne;
+    struct EntreeCache *suivante;         /**< Entrée suivante dans la même alvéole de la table. */
+    uint32_t hachage;
+    int langue;
+    char *cle;                            /**< Phrase normalisée. */
+    const Grammaire *grammaire;           /**< Grammaire renvoyée par l'analyse (langue identifiée). */
+    ActionData *actions;
+    int nb_actions;
+} EntreeCache;
+
+struct CacheActions {
+    EntreeCache **alveoles;
+    size_t nb_alveoles;                   /**< Puissance de 2, au moins le double de la capacité. */
+    EntreeCache *recente;                 /**< Tête de la liste LRU. */
+    EntreeCache *ancienne;                /**< Queue de la liste LRU, première évincée. */
+    size_t taille;
+    size_t capacite;
+    unsigned long succes;
+    unsigned long echecs;
+    pthread_mutex_t verrou;
+};
+
+static uint32_t hacherPhrase(int langue, const char *phrase) {    //FNV-1a de la langue et de la phrase normalisée.
+    uint32_t h = (2166136261u ^ (uint32_t) langue) * 16777619u;
+    bool premier = true;
+    Segment mot;
+
+    while (segment_suivant(&phrase, PONCTUATION_PHRASE, &mot)) {
+        if (!premier) {
+            h = (h ^ ' ') * 16777619u;
+        }
+        for (const char *c = mot.debut, *fin = mot.debut + mot.longueur; c < fin;) {
+            char forme[2];
+            size_t n = normaliser_caractere(&c, fin, forme);
+            for (size_t i = 0; i < n; i++) {
+                h = (h ^ (unsigned char) forme[i]) * 16777619u;
+            }
+        }
+        premier = false;
+    }
+    return h;
+}
+
+static bool memePhrase(const char *cle, const char *phrase) {    //La phrase a-t-elle cette forme normalisée ?
+    bool premier = true;
+    Segment mot;
+
+    while (segment_suivant(&phrase, PONCTUATION_PHRASE, &mot)) {
+        if (!premier && *cle++ != ' ') {
+            return false;
+        }
+        for (const char *c = mot.debut, *fin = mot.debut + mot.longueur; c < fin;) {
+            char forme[2];
+            size_t n = normaliser_caractere(&c, fin, forme);
+            for (size_t i = 0; i < n; i++, cle++) {
+                if (*cle == '\0' || *cle != forme[i]) {
+                    return false;
+                }
+            }
+        }
+        premier = false;
+    }
+    return *cle == '\0';
+}
+
+static char *normaliserPhrase(const char *phrase) {    //Forme normalisée allouée de la phrase.
+    size_t longueur = 0;
+    const char *curseur = phrase;
+    Segment mot;
+
+    while (segment_suivant(&curseur, PONCTUATION_PHRASE, &mot)) {
+        longueur += mot.longueur + 1;
+    }
+    char *cle = malloc(longueur + 1);
+    if (cle == NULL) {
+        return NULL;
+    }
+    char *c = cle;
+    curseur = phrase;
+    while (segment_suivant(&curseur, PONCTUATION_PHRASE, &mot)) {
+        if (c != cle) {
+            *c++ = ' ';
+        }
+        c += normaliser_texte(mot.debut, mot.longueur, c);
+    }
+    *c = '\0';
+    return cle;
+}
+
+static void detacherLRU(CacheActions *c, EntreeCache *e) {
+    if (e->plus_recente != NULL) {
+        e->plus_recente->plus_ancienne = e->plus_ancienne;
+    } else {
+        c->recente = e->plus_ancienne;
+    }
+    if (e->plus_ancienne != NULL) {
+        e->plus_ancienne->plus_recente = e->plus_recente;
+    } else {
+        c->ancienne = e->plus_recente;
+    }
+}
+
+static void placerEnTeteLRU(CacheActions *c, EntreeCache *e) {
+    e->plus_recente = NULL;
+    e->plus_ancienne = c->recente;
+    if (c->recente != NULL) {
+        c->recente->plus_recente = e;
+    } else {
+        c->ancienne = e;
+    }
+    c->recente = e;
+}
+
+static EntreeCache *chercherEntree(CacheActions *c, uint32_t h, int langue, const char *phrase) {
+    for (EntreeCache *e = c->alveoles[h & (c->nb_alveoles - 1)]; e != NULL; e = e->suivante) {
+        if (e->hachage == h && e->langue == langue && memePhrase(e->cle, phrase)) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void libererEntree(EntreeCache *e) {
+    free(e->cle);
+    free(e->actions);
+    free(e);
+}
+
+static void evincerPlusAncienne(CacheActions *c) {
+    EntreeCache *e = c->ancienne;
+    EntreeCache **lien = &c->alveoles[e->hachage & (c->nb_alveoles - 1)];
+
+    while (*lien != e) {
+        lien = &(*lien)->suivante;
+    }
+    *lien = e->suivante;
+    detacherLRU(c, e);
+    libererEntree(e);
+    c->taille--;
+}
+
+/**
+ * @brief Crée un cache vide.
+ * @param capacite Nombre maximal de phrases mémorisées.
+ * @return Le cache, NULL si la capacité est nulle ou si l'allocation échoue.
+ */
+CacheActions *cache_creer(size_t capacite) {
+    if (capacite == 0) {
+        return NULL;
+    }
+    CacheActions *c = calloc(1, sizeof(CacheActions));
+    if (c == NULL) {
+        return NULL;
+    }
+    c->nb_alveoles = 1;
+    while (c->nb_alveoles < capacite * 2) {
+        c->nb_alveoles *= 2;
+    }
+    c->alveoles = calloc(c->nb_alveoles, sizeof(EntreeCache *));
+    if (c->alveoles == NULL) {
+        free(c);
+        return NULL;
+    }
+    c->capacite = capacite;
+    pthread_mutex_init(&c->verrou, NULL);
+    return c;
+}
+
+/**
+ * @brief Libère le cache et toutes les phrases mémorisées. Accepte NULL.
+ */
+void cache_detruire(CacheActions *c) {
+    if (c == NULL) {
+        return;
+    }
+    while (c->ancienne != NULL) {
+        evincerPlusAncienne(c);
+    }
+    pthread_mutex_destroy(&c->verrou);
+    free(c->alveoles);
+    free(c);
+}
+
+/**
+ * @brief Equivalent de analyserPhrase() qui passe par le cache : si la phrase a déjà été analysée, les actions
+ * mémorisées sont enfilées directement. Sinon la phrase est analysée puis mémorisée, en évinçant au besoin
+ * la phrase la moins récemment utilisée.
+ * @param c Cache, NULL pour analyser sans cache.
+ * @param g Grammaire de la langue de la phrase.
+ * @param phrase Phrase à analyser.
+ * @param q File dans laquelle sont enfilées les actions.
+ * @return Grammaire de la phrase, comme analyserPhrase().
+ */
+const Grammaire *cache_analyserPhrase(CacheActions *c, const Grammaire *g, const char *phrase, Queue *q) {
+    if (c == NULL) {
+        return analyserPhrase(g, phrase, q);
+    }
+    uint32_t h = hacherPhrase(g->langue, phrase);
+
+    pthread_mutex_lock(&c->verrou);
+    EntreeCache *e = chercherEntree(c, h, g->langue, phrase);
+    if (e != NULL) {
+        c->succes++;
+        detacherLRU(c, e);
+        placerEnTeteLRU(c, e);
+        reserveQueue(q, q->size + e->nb_actions);
+        for (int i = 0; i < e->nb_actions; i++) {
+            enqueue(q, e->actions[i]);
+        }
+        const Grammaire *grammaire = e->grammaire;
+        pthread_mutex_unlock(&c->verrou);
+        return grammaire;
+    }
+    c->echecs++;
+    pthread_mutex_unlock(&c->verrou);
+
+    //Analyse hors du verrou : les autres threads continuent à être servis pendant ce temps.
+    Queue resultat = createQueue();
+    const Grammaire *grammaire = analyserPhrase(g, phrase, &resultat);
+    e = malloc(sizeof(EntreeCache));
+    ActionData *actions = malloc((resultat.size > 0 ? resultat.size : 1) * sizeof(ActionData));
+    char *cle = normaliserPhrase(phrase);
+    int nb_actions = 0;
+    while (!isQueueEmpty(&resultat)) {
+        ActionData action = dequeue(&resultat);
+        enqueue(q, action);
+        if (actions != NULL) {
+            actions[nb_actions++] = action;
+        }
+    }
+    destroyQueue(&resultat);
+    if (e == NULL || actions == NULL || cle == NULL) {
+        free(e);
+        free(actions);
+        free(cle);
+        return grammaire;
+    }
+    e->hachage = h;
+    e->langue = g->langue;
+    e->cle = cle;
+    e->grammaire = grammaire;
+    e->actions = actions;
+    e->nb_actions = nb_actions;
+
+    pthread_mutex_lock(&c->verrou);
+    if (chercherEntree(c, h, g->langue, phrase) != NULL) {    //Déjà mémorisée entre temps par un autre thread.
+        pthread_mutex_unlock(&c->verrou);
+        libererEntree(e);
+        return grammaire;
+    }
+    EntreeCache **alveole = &c->alveoles[h & (c->nb_alveoles - 1)];
+    e->suivante = *alveole;
+    *alveole = e;
+    placerEnTeteLRU(c, e);
+    if (++c->taille > c->capacite) {
+        evincerPlusAncienne(c);
+    }
+    pthread_mutex_unlock(&c->verrou);
+    return grammaire;
+}
+
+/**
+ * @brief Renvoie le nombre de phrases servies par le cache (succès) et le nombre de phrases analysées (échecs).
+ */
+void cache_statistiques(CacheActions *c, unsigned long *succes, unsigned long *echecs) {
+    if (c == NULL) {
+        *succes = *echecs = 0;
+        return;
+    }
+    pthread_mutex_lock(&c->verrou);
+    *succes = c->succes;
+    *echecs = c->echecs;
+    pthread_mutex_unlock(&c->verrou);
+}
+
+/**
+ * @}
+ */
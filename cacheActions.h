@@ -0,0 +1,20 @@
+/**
+ * @file
+ * @brief Ce fichier contient les déclarations du cache des phrases déjà analysées.
+ * Une phrase déjà rencontrée (même langue, mêmes mots à la casse et à la ponctuation près) est servie
+ * depuis le cache, sans nouvelle analyse. Le cache est borné et évince la phrase la moins récemment utilisée.
+ */
+
+#ifndef CACHEACTIONS_H
+#define CACHEACTIONS_H
+
+#include "traitementTexte.h"
+
+typedef struct CacheActions CacheActions;
+
+CacheActions *cache_creer(size_t capacite);
+void cache_detruire(CacheActions *c);
+const Grammaire *cache_analyserPhrase(CacheActions *c, const Grammaire *g, const char *phrase, Queue *q);
+void cache_statistiques(CacheActions *c, unsigned long *succes, unsigned long *echecs);
+
+#endif
@@ -0,0 +1,235 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "carte.h"
+
+/**
+ * @file
+ * @brief Ce fichier rassemble les fonctions de la carte d'occupation.
+ */
+
+/**
+ * @defgroup carte Carte d'occupation
+ * @brief Obstacles de la scène sur une grille, et test de collision d'un déplacement.
+ * La distance signée de chaque cellule au bord des obstacles est précalculée une fois par scène (transformée en
+ * distance euclidienne exacte, en temps linéaire). Un déplacement est ensuite testé par bonds : là où l'obstacle le
+ * plus proche est à une distance d, aucun obstacle ne peut être atteint avant d'avoir parcouru d.
+ * @{
+ */
+
+#define DISTANCE_INFINIE 1e20    //Carré de distance d'une cellule sans obstacle de l'autre nature.
+
+/**
+ * @brief Crée une carte vide qui couvre [-demi_largeur, demi_largeur] x [-demi_hauteur, demi_hauteur].
+ * @return false si la mémoire manque.
+ */
+bool carte_creer(Carte *carte, int demi_largeur, int demi_hauteur) {
+    size_t nb;
+
+    carte->largeur = 2 * demi_largeur + 1;
+    carte->hauteur = 2 * demi_hauteur + 1;
+    carte->x_min = -demi_largeur;
+    carte->y_min = -demi_hauteur;
+    nb = (size_t) carte->largeur * (size_t) carte->hauteur;
+    carte->occupation = calloc(nb, 1);
+    carte->distance = malloc(nb * sizeof(float));
+    if (carte->occupation == NULL || carte->distance == NULL) {
+        carte_detruire(carte);
+        return false;
+    }
+    for (size_t k = 0; k < nb; k++) {
+        carte->distance[k] = (float) sqrt(DISTANCE_INFINIE);
+    }
+    return true;
+}
+
+void carte_detruire(Carte *carte) {
+    free(carte->occupation);
+    free(carte->distance);
+    carte->occupation = NULL;
+    carte->distance = NULL;
+    carte->largeur = carte->hauteur = 0;
+}
+
+static void marquer(Carte *carte, int x, int y) {
+    int i = x - carte->x_min, j = y - carte->y_min;
+    if (i >= 0 && i < carte->largeur && j >= 0 && j < carte->hauteur) {
+        carte->occupation[(size_t) j * carte->largeur + i] = 1;
+    }
+}
+
+/**
+ * @brief Marque les cellules dont le centre est à l'intérieur de la boule (sans effet si elle est absente).
+ */
+void carte_ajouterBoule(Carte *carte, const BouleScene *boule) {
+    int r = boule->rayon, cx = boule->milieu[0], cy = boule->milieu[1];
+
+    if (r <= 0) {
+        return;
+    }
+    for (int y = cy - r; y <= cy + r; y++) {
+        for (int x = cx - r; x <= cx + r; x++) {
+            if ((x - cx) * (x - cx) + (y - cy) * (y - cy) < r * r) {
+                marquer(carte, x, y);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Transformée en distance d'une ligne (Felzenszwalb et Huttenlocher) : d[q] = min_p (q-p)² + f[p].
+ * @param v, z Tableaux de travail de n et n+1 éléments.
+ */
+static void transformee1D(const double *f, int n, double *d, int *v, double *z) {
+    int k = 0;
+
+    v[0] = 0;
+    z[0] = -INFINITY;
+    z[1] = INFINITY;
+    for (int q = 1; q < n; q++) {
+        double s = ((f[q] + (double) q * q) - (f[v[k]] + (double) v[k] * v[k])) / (2.0 * (q - v[k]));
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + (double) q * q) - (f[v[k]] + (double) v[k] * v[k])) / (2.0 * (q - v[k]));
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = INFINITY;
+    }
+    k = 0;
+    for (int q = 0; q < n; q++) {
+        while (z[k + 1] < q) {
+            k++;
+        }
+        d[q] = (double) (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+/**
+ * @brief Carré de la distance de chaque cellule à la cellule la plus proche dont l'occupation vaut cible :
+ * transformée des colonnes, puis des lignes.
+ */
+static void transformee(const Carte *carte, unsigned char cible, double *d2, double *f, double *d, int *v, double *z) {
+    int l = carte->largeur, h = carte->hauteur;
+
+    for (int i = 0; i < l; i++) {
+        for (int j = 0; j < h; j++) {
+            f[j] = (carte->occupation[(size_t) j * l + i] == cible) ? 0.0 : DISTANCE_INFINIE;
+        }
+        transformee1D(f, h, d, v, z);
+        for (int j = 0; j < h; j++) {
+            d2[(size_t) j * l + i] = d[j];
+        }
+    }
+    for (int j = 0; j < h; j++) {
+        double *ligne = d2 + (size_t) j * l;
+        memcpy(f, ligne, (size_t) l * sizeof(double));
+        transformee1D(f, l, ligne, v, z);
+    }
+}
+
+/**
+ * @brief Précalcule la distance signée au bord des obstacles, à appeler une fois les obstacles ajoutés.
+ * Le bord est pris à mi-chemin entre une cellule libre et une cellule occupée.
+ * @return false si la mémoire manque.
+ */
+bool carte_calculerDistances(Carte *carte) {
+    size_t nb = (size_t) carte->largeur * (size_t) carte->hauteur;
+    int n = (carte->largeur > carte->hauteur) ? carte->largeur : carte->hauteur;
+    double *vers_occupe = malloc(nb * sizeof(double));
+    double *vers_libre = malloc(nb * sizeof(double));
+    double *f = malloc((size_t) n * sizeof(double));
+    double *d = malloc((size_t) n * sizeof(double));
+    double *z = malloc((size_t) (n + 1) * sizeof(double));
+    int *v = malloc((size_t) n * sizeof(int));
+    bool ok = vers_occupe != NULL && vers_libre != NULL && f != NULL && d != NULL && z != NULL && v != NULL;
+
+    if (ok) {
+        transformee(carte, 1, vers_occupe, f, d, v, z);
+        transformee(carte, 0, vers_libre, f, d, v, z);
+        for (size_t k = 0; k < nb; k++) {
+            carte->distance[k] = carte->occupation[k] ? (float) -(sqrt(vers_libre[k]) - 0.5)
+                                                      : (float) (sqrt(vers_occupe[k]) - 0.5);
+        }
+    }
+    free(vers_occupe);
+    free(vers_libre);
+    free(f);
+    free(d);
+    free(z);
+    free(v);
+    return ok;
+}
+
+/**
+ * @brief Distance signée de (x,y) au bord des obstacles, lue dans la cellule qui le contient (à une cellule près).
+ * Hors de la carte, tous les obstacles sont au moins à la distance de la carte.
+ */
+double carte_distance(const Carte *carte, double x, double y) {
+    long i = lround(x - carte->x_min), j = lround(y - carte->y_min);
+
+    if (i < 0 || i >= carte->largeur || j < 0 || j >= carte->hauteur) {
+        double dx = fmax(fmax(carte->x_min - x, x - (carte->x_min + carte->largeur - 1)), 0.0);
+        double dy = fmax(fmax(carte->y_min - y, y - (carte->y_min + carte->hauteur - 1)), 0.0);
+        return hypot(dx, dy);
+    }
+    return carte->distance[(size_t) j * carte->largeur + i];
+}
+
+/**
+ * @brief Distance à parcourir depuis (x,y) dans la direction (ux,uy) pour sortir de la cellule qui le contient.
+ */
+static double sortieCellule(const Carte *carte, double x, double y, double ux, double uy) {
+    double cx = carte->x_min + lround(x - carte->x_min), cy = carte->y_min + lround(y - carte->y_min);
+    double tx = (ux > 0) ? (cx + 0.5 - x) / ux : (ux < 0) ? (cx - 0.5 - x) / ux : INFINITY;
+    double ty = (uy > 0) ? (cy + 0.5 - y) / uy : (uy < 0) ? (cy - 0.5 - y) / uy : INFINITY;
+    return fmax(fmin(tx, ty), 0.0);
+}
+
+/**
+ * @brief Teste le déplacement en ligne droite de (x0,y0) à (x1,y1). Loin des obstacles, le segment est parcouru
+ * par bonds de la distance libre lue dans la carte ; près d'eux, cellule par cellule. Le test coûte donc au plus
+ * une lecture par cellule traversée, et bien moins en terrain dégagé. Un obstacle est atteint quand le segment
+ * entre dans une cellule à plus de CARTE_TOLERANCE de son bord ; s'il part de l'intérieur d'un obstacle, il peut
+ * en sortir librement.
+ * @param fraction Si un obstacle est atteint, reçoit la part du segment (entre 0 et 1) parcourue avant lui.
+ * @return true si un obstacle est atteint.
+ */
+bool carte_collision(const Carte *carte, double x0, double y0, double x1, double y1, double *fraction) {
+    double longueur = hypot(x1 - x0, y1 - y0);
+    double ux = (longueur > 0.0) ? (x1 - x0) / longueur : 0.0, uy = (longueur > 0.0) ? (y1 - y0) / longueur : 0.0;
+    double s = 0.0, libre = 0.0;
+    bool dehors = false;
+
+    for (;;) {
+        double x = x0 + ux * s, y = y0 + uy * s;
+        double d = carte_distance(carte, x, y), pas, sur;
+        if (d < -CARTE_TOLERANCE && dehors) {
+            *fraction = libre / longueur;
+            return true;
+        }
+        if (s >= longueur) {
+            return false;
+        }
+        //La distance lue et la vraie diffèrent de moins de 0.92 (position dans la cellule, bord des obstacles pris à
+        //mi-chemin entre deux centres) : un bond de d - 2 ne peut pas entrer à plus d'une cellule dans un obstacle.
+        if (d > 2.5) {
+            pas = d - 2.0;
+            sur = s + pas;
+        } else {
+            pas = sortieCellule(carte, x, y, ux, uy) + 1e-9;
+            sur = fmax(s + pas - 1e-6, s);    //Juste avant la cellule suivante.
+        }
+        if (d >= -CARTE_TOLERANCE) {
+            dehors = true;
+            libre = fmin(sur, longueur);
+        }
+        s = fmin(s + pas, longueur);
+    }
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,36 @@
+/**
+ * @file
+ * @brief Ce fichier contient les déclarations de la carte d'occupation.
+ * Elle découpe la scène en cellules d'une unité (un pixel de l'image, une unité de turtle), marque celles occupées
+ * par les boules et précalcule pour chaque cellule sa distance à l'obstacle le plus proche, ce qui permet de tester
+ * un déplacement sans parcourir toutes ses cellules.
+ */
+
+#ifndef CARTE_H
+#define CARTE_H
+
+#include <stdbool.h>
+#include "traitementCommande.h"
+
+#define CARTE_TOLERANCE 1.0    //Pénétration dans un obstacle tolérée, en cellules : la précision de la carte.
+
+/**
+ * @brief Carte d'occupation dans la base de la modélisation (celle de changementDeBase) : la cellule (i,j) est
+ * centrée sur le point (x_min + i, y_min + j).
+ */
+typedef struct {
+    int largeur, hauteur;          /**< Nombre de cellules. */
+    int x_min, y_min;              /**< Coordonnées du centre de la cellule (0,0). */
+    unsigned char *occupation;     /**< 1 si la cellule est occupée, ligne par ligne depuis y_min. */
+    float *distance;               /**< Distance signée au bord des obstacles : positive dehors, négative dedans. */
+} Carte;
+
+bool carte_creer(Carte *carte, int demi_largeur, int demi_hauteur);
+void carte_detruire(Carte *carte);
+void carte_ajouterBoule(Carte *carte, const BouleScene *boule);
+bool carte_calculerDistances(Carte *carte);
+
+double carte_distance(const Carte *carte, double x, double y);
+bool carte_collision(const Carte *carte, double x0, double y0, double x1, double y1, double *fraction);
+
+#endif
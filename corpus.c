@@ -0,0 +1,500 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include "corpus.h"
+
+/**
+ * @file
+ * @brief Ce fichier rassemble le générateur de phrases de commande.
+ *
+ * Une phrase est une suite de 1 à CORPUS_ACTIONS_MAX sous-phrases reliées par "puis" ou "luego". Chaque sous-phrase
+ * est construite à partir d'une intention tirée au hasard (verbe, mesure, direction, objets, couleurs, négation),
+ * puis écrite avec l'une des tournures de la langue : infinitif ou impératif, nombre en chiffres ou en lettres,
+ * mesure avant ou après la direction, etc. Le vocabulaire est propre au générateur, indépendant du lexique,
+ * pour que la vérification de l'analyse ne soit pas circulaire.
+ */
+
+/**
+ * @defgroup corpus Générateur de phrases
+ * @brief Phrases de commande aléatoires dont les actions sont connues.
+ * @{
+ */
+
+/**
+ * @brief Formes d'un verbe : impératif, infinitif, et forme employée après la négation.
+ */
+typedef struct {
+    const char *imperatif;
+    const char *infinitif;
+    const char *negatif;
+} FormesVerbe;
+
+/**
+ * @brief Mot désignant un objet : genre et formes au singulier et au pluriel.
+ */
+typedef struct {
+    int code;
+    bool feminin;
+    const char *singulier;
+    const char *pluriel;
+} NomObjet;
+
+/**
+ * @brief Vocabulaire d'une langue pour le générateur.
+ */
+typedef struct {
+    int langue;
+    const char *separateur;
+    FormesVerbe verbes[VERBE_COMPTER + 1][2];    /**< Deux verbes synonymes par code (le second peut être NULL). */
+    NomObjet objets[8];
+    int nb_objets;
+    const char *couleurs[COULEUR_ORANGE + 1][4]; /**< Masculin, féminin, masculin pluriel, féminin pluriel. */
+    const char *directions[DIRECTION_DROITE + 1];
+} Langage;
+
+static const Langage langage_fr = {
+    LANGUE_FR, "puis",
+    {
+        [VERBE_AVANCER] = {{"avance", "avancer", "avance"}},
+        [VERBE_RECULER] = {{"recule", "reculer", "recule"}},
+        [VERBE_TOURNER] = {{"tourne", "tourner", "tourne"}},
+        [VERBE_LOCALISER] = {{"localise", "localiser", "localise"}, {"trouve", "trouver", "trouve"}},
+        [VERBE_CONTOURNER] = {{"contourne", "contourner", "contourne"}},
+        [VERBE_PASSER] = {{"passe", "passer", "passe"}},
+        [VERBE_COMPTER] = {{"compte", "compter", "compte"}},
+    },
+    {
+        {OBJET_BOULE, true, "boule", "boules"},
+        {OBJET_BOULE, true, "balle", "balles"},
+        {OBJET_CUBE, false, "cube", "cubes"},
+        {OBJET_CUBE, false, "carré", "carrés"},
+        {OBJET_OBJET, false, "objet", "objets"},
+        {OBJET_OBSTACLE, false, "obstacle", "obstacles"},
+    }, 6,
+    {
+        [COULEUR_ROUGE] = {"rouge", "rouge", "rouges", "rouges"},
+        [COULEUR_BLEU] = {"bleu", "bleue", "bleus", "bleues"},
+        [COULEUR_JAUNE] = {"jaune", "jaune", "jaunes", "jaunes"},
+        [COULEUR_ORANGE] = {"orange", "orange", "oranges", "oranges"},
+    },
+    {[DIRECTION_GAUCHE] = "gauche", [DIRECTION_DROITE] = "droite"},
+};
+
+static const Langage langage_es = {
+    LANGUE_ES, "luego",
+    {
+        [VERBE_AVANCER] = {{"avanza", "avanzar", "avances"}},
+        [VERBE_RECULER] = {{"retrocede", "retroceder", "retrocedas"}},
+        [VERBE_TOURNER] = {{"gira", "girar", "gires"}},
+        [VERBE_LOCALISER] = {{"localiza", "localizar", "localices"}, {"encuentra", "encontrar", "encuentres"}},
+        [VERBE_CONTOURNER] = {{"rodea", "rodear", "rodees"}},
+        [VERBE_PASSER] = {{"pasa", "pasar", "pases"}},
+        [VERBE_COMPTER] = {{"cuenta", "contar", "cuentes"}},
+    },
+    {
+        {OBJET_BOULE, true, "bola", "bolas"},
+        {OBJET_BOULE, true, "pelota", "pelotas"},
+        {OBJET_CUBE, false, "cubo", "cubos"},
+        {OBJET_CUBE, false, "cuadrado", "cuadrados"},
+        {OBJET_OBJET, false, "objeto", "objetos"},
+        {OBJET_OBSTACLE, false, "obstáculo", "obstáculos"},
+    }, 6,
+    {
+        [COULEUR_ROUGE] = {"rojo", "roja", "rojos", "rojas"},
+        [COULEUR_BLEU] = {"azul", "azul", "azules", "azules"},
+        [COULEUR_JAUNE] = {"amarillo", "amarilla", "amarillos", "amarillas"},
+        [COULEUR_ORANGE] = {"naranja", "naranja", "naranjas", "naranjas"},
+    },
+    {[DIRECTION_GAUCHE] = "izquierda", [DIRECTION_DROITE] = "derecha"},
+};
+
+/**
+ * @brief Phrase en cours d'écriture.
+ */
+typedef struct {
+    PhraseCorpus *p;
+    size_t longueur;
+    unsigned int *graine;
+    const Langage *l;
+} Redaction;
+
+static int hasard(Redaction *r, int n) {    //Entier entre 0 et n - 1.
+    return rand_r(r->graine) % n;
+}
+
+static void ecrire(Redaction *r, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(r->p->texte + r->longueur, sizeof(r->p->texte) - r->longueur, format, args);
+    va_end(args);
+    if (n > 0) {
+        r->longueur += (size_t) n;
+        if (r->longueur >= sizeof(r->p->texte)) {
+            r->longueur = sizeof(r->p->texte) - 1;
+        }
+    }
+}
+
+/**
+ * @brief Ecrit un nombre (1 à 9999) en lettres françaises, sans traits d'union ("quatre vingt dix sept").
+ */
+static void nombreFr(Redaction *r, int n) {
+    static const char *const unites[] = {"", "un", "deux", "trois", "quatre", "cinq", "six", "sept", "huit", "neuf",
+                                         "dix", "onze", "douze", "treize", "quatorze", "quinze", "seize"};
+    static const char *const dizaines[] = {"vingt", "trente", "quarante", "cinquante", "soixante"};
+
+    if (n >= 1000) {
+        if (n / 1000 > 1) {
+            nombreFr(r, n / 1000);
+            ecrire(r, " ");
+        }
+        ecrire(r, "mille");
+        if (n % 1000 != 0) {
+            ecrire(r, " ");
+            nombreFr(r, n % 1000);
+        }
+    } else if (n >= 100) {
+        if (n / 100 > 1) {
+            ecrire(r, "%s ", unites[n / 100]);
+        }
+        ecrire(r, (n / 100 > 1 && n % 100 == 0) ? "cents" : "cent");
+        if (n % 100 != 0) {
+            ecrire(r, " ");
+            nombreFr(r, n % 100);
+        }
+    } else if (n >= 80) {
+        ecrire(r, n == 80 ? "quatre vingts" : "quatre vingt ");
+        if (n > 80) {
+            nombreFr(r, n - 80);
+        }
+    } else if (n >= 70) {
+        ecrire(r, n == 71 ? "soixante et " : "soixante ");
+        nombreFr(r, n - 60);
+    } else if (n >= 20) {
+        ecrire(r, "%s", dizaines[n / 10 - 2]);
+        if (n % 10 == 1) {
+            ecrire(r, " et un");
+        } else if (n % 10 != 0) {
+            ecrire(r, " %s", unites[n % 10]);
+        }
+    } else if (n > 16) {
+        ecrire(r, "dix %s", unites[n - 10]);
+    } else {
+        ecrire(r, "%s", unites[n]);
+    }
+}
+
+/**
+ * @brief Ecrit un nombre (1 à 9999) en lettres espagnoles ("ciento veintidós", "treinta y cinco").
+ */
+static void nombreEs(Redaction *r, int n) {
+    static const char *const unites[] = {"", "un", "dos", "tres", "cuatro", "cinco", "seis", "siete", "ocho", "nueve",
+                                         "diez", "once", "doce", "trece", "catorce", "quince", "dieciséis",
+                                         "diecisiete", "dieciocho", "diecinueve", "veinte", "veintiún", "veintidós",
+                                         "veintitrés", "veinticuatro", "veinticinco", "veintiséis", "veintisiete",
+                                         "veintiocho", "veintinueve"};
+    static const char *const dizaines[] = {"treinta", "cuarenta", "cincuenta", "sesenta", "setenta", "ochenta",
+                                           "noventa"};
+    static const char *const centaines[] = {"", "ciento", "doscientos", "trescientos", "cuatrocientos", "quinientos",
+                                            "seiscientos", "setecientos", "ochocientos", "novecientos"};
+
+    if (n >= 1000) {
+        if (n / 1000 > 1) {
+            nombreEs(r, n / 1000);
+            ecrire(r, " ");
+        }
+        ecrire(r, "mil");
+        if (n % 1000 != 0) {
+            ecrire(r, " ");
+            nombreEs(r, n % 1000);
+        }
+    } else if (n >= 100) {
+        ecrire(r, "%s", n == 100 ? "cien" : centaines[n / 100]);
+        if (n % 100 != 0) {
+            ecrire(r, " ");
+            nombreEs(r, n % 100);
+        }
+    } else if (n >= 30) {
+        ecrire(r, "%s", dizaines[n / 10 - 3]);
+        if (n % 10 != 0) {
+            ecrire(r, " y %s", unites[n % 10]);
+        }
+    } else {
+        ecrire(r, "%s", unites[n]);
+    }
+}
+
+static void nombre(Redaction *r, int n) {    //En chiffres ou en lettres.
+    if (hasard(r, 2) == 0) {
+        ecrire(r, "%d", n);
+    } else if (r->l->langue == LANGUE_FR) {
+        nombreFr(r, n);
+    } else {
+        nombreEs(r, n);
+    }
+}
+
+static void direction(Redaction *r, int code) {
+    static const char *const fr[] = {"à ", "vers la ", "sur la "};
+    static const char *const es[] = {"a la ", "hacia la "};
+    if (r->l->langue == LANGUE_FR) {
+        ecrire(r, "%s%s", fr[hasard(r, 3)], r->l->directions[code]);
+    } else {
+        ecrire(r, "%s%s", es[hasard(r, 2)], r->l->directions[code]);
+    }
+}
+
+/**
+ * @brief Ecrit "de 3 mètres", "cuarenta grados"... et remplit la mesure attendue.
+ */
+static void mesure(Redaction *r, ActionData *a, Mesure type) {
+    static const struct { const char *fr; const char *es; const char *fr_un; const char *es_un; double facteur; } unites[] = {
+        {"mètres", "metros", "mètre", "metro", 1},
+        {"centimètres", "centímetros", NULL, NULL, 0.01},
+        {"millimètres", "milímetros", NULL, NULL, 0.001},
+        {"degrés", "grados", "degré", "grado", 1},
+    };
+    int u = (type == MESURE_ANGLE) ? 3 : hasard(r, 3);
+    int n = (type == MESURE_ANGLE) ? 1 + hasard(r, 360) : (u == 0 ? 1 + hasard(r, 9999) : 2 + hasard(r, 998));
+    bool fr = (r->l->langue == LANGUE_FR);
+
+    if (fr || hasard(r, 2) == 0) {
+        ecrire(r, "de ");
+    }
+    nombre(r, n);
+    if (n == 1) {
+        ecrire(r, " %s", fr ? unites[u].fr_un : unites[u].es_un);
+    } else {
+        ecrire(r, " %s", fr ? unites[u].fr : unites[u].es);
+    }
+    a->mesure = (unsigned char) type;
+    a->valeur = (double) n * unites[u].facteur;
+}
+
+/**
+ * @brief Ecrit un objet avec son article et éventuellement sa couleur ("la boule bleue", "los cubos").
+ * @param article false pour écrire l'objet sans article ("le nombre de boules").
+ * @param prefixe "jusqu'", "hasta "... ou NULL : l'article est alors contracté si besoin ("jusqu'au cube").
+ */
+static void objet(Redaction *r, bool pluriel, bool article, unsigned char *code, unsigned char *couleur,
+                  const char *prefixe) {
+    const NomObjet *o = &r->l->objets[hasard(r, r->l->nb_objets)];
+    int c = hasard(r, COULEUR_ORANGE + 1);    //COULEUR_AUCUNE une fois sur cinq.
+    const char *mot = pluriel ? o->pluriel : o->singulier;
+    const char *determinant;
+
+    if (r->l->langue == LANGUE_FR) {
+        if (pluriel) {
+            determinant = "les ";
+        } else if (mot[0] == 'o') {
+            determinant = "l'";
+        } else {
+            determinant = o->feminin ? "la " : "le ";
+        }
+        if (prefixe != NULL) {
+            ecrire(r, "%s", prefixe);
+            if (!pluriel && !o->feminin && mot[0] != 'o') {
+                determinant = "au ";
+            } else {
+                ecrire(r, "à ");
+            }
+        }
+    } else {
+        if (prefixe != NULL) {
+            ecrire(r, "%s", prefixe);
+        }
+        determinant = pluriel ? (o->feminin ? "las " : "los ") : (o->feminin ? "la " : "el ");
+    }
+    ecrire(r, "%s%s", article ? determinant : "", mot);
+    if (c != COULEUR_AUCUNE) {
+        ecrire(r, " %s", r->l->couleurs[c][(pluriel ? 2 : 0) + (o->feminin ? 1 : 0)]);
+    }
+    *code = (unsigned char) o->code;
+    *couleur = (unsigned char) c;
+}
+
+/**
+ * @brief Ecrit le verbe, à la forme négative ou non.
+ */
+static void verbe(Redaction *r, ActionData *a) {
+    const FormesVerbe *v = &r->l->verbes[a->opcode][0];
+    if (v[1].imperatif != NULL && hasard(r, 2) == 0) {
+        v = &v[1];
+    }
+
+    if (!a->negation) {
+        ecrire(r, "%s ", hasard(r, 2) == 0 ? v->imperatif : v->infinitif);
+    } else if (r->l->langue == LANGUE_ES) {
+        ecrire(r, "no %s ", v->negatif);
+    } else if (strchr("aeiou", v->negatif[0]) != NULL) {
+        ecrire(r, "n'%s pas ", v->negatif);
+    } else {
+        ecrire(r, "ne %s pas ", v->negatif);
+    }
+}
+
+/**
+ * @brief Ecrit une sous-phrase tirée au hasard et remplit l'action attendue.
+ */
+static void sousPhrase(Redaction *r, ActionData *a) {
+    bool fr = (r->l->langue == LANGUE_FR);
+    static const ActionData vide = {0};
+
+    *a = vide;
+    a->opcode = (unsigned char) (VERBE_AVANCER + hasard(r, VERBE_COMPTER));
+    a->negation = (hasard(r, 8) == 0);
+    a->langue = (unsigned char) r->l->langue;
+    verbe(r, a);
+
+    switch (a->opcode) {
+        case VERBE_AVANCER:
+            if (hasard(r, 3) == 0) {    //"avance jusqu'à la boule bleue"
+                objet(r, false, true, &a->objet, &a->couleur, fr ? "jusqu'" : "hasta ");
+                break;
+            }
+            //fallthrough
+        case VERBE_RECULER:
+            if (a->opcode == VERBE_AVANCER && hasard(r, 4) == 0) {
+                a->direction = (unsigned char) (DIRECTION_GAUCHE + hasard(r, 2));
+                direction(r, a->direction);
+                ecrire(r, " ");
+            }
+            mesure(r, a, MESURE_DISTANCE);
+            break;
+        case VERBE_TOURNER:
+            a->direction = (unsigned char) (DIRECTION_GAUCHE + hasard(r, 2));
+            switch (hasard(r, 3)) {
+                case 0:    //"tourne à gauche"
+                    direction(r, a->direction);
+                    break;
+                case 1:    //"tourne à gauche de 90 degrés"
+                    direction(r, a->direction);
+                    ecrire(r, " ");
+                    mesure(r, a, MESURE_ANGLE);
+                    break;
+                default:   //"tourne de 90 degrés à gauche"
+                    mesure(r, a, MESURE_ANGLE);
+                    ecrire(r, " ");
+                    direction(r, a->direction);
+            }
+            break;
+        case VERBE_LOCALISER:
+            objet(r, false, true, &a->objet, &a->couleur, NULL);
+            if (hasard(r, 2) == 0) {    //"localise la boule bleue ou le cube"
+                ecrire(r, fr ? " ou " : " o ");
+                objet(r, false, true, &a->objet2, &a->couleur2, NULL);
+            }
+            break;
+        case VERBE_CONTOURNER:
+            a->direction = (unsigned char) (DIRECTION_GAUCHE + hasard(r, 2));
+            if (hasard(r, 2) == 0) {    //"contourne la boule jaune par la gauche"
+                objet(r, false, true, &a->objet, &a->couleur, NULL);
+                ecrire(r, fr ? " par la %s" : " por la %s", r->l->directions[a->direction]);
+            } else {                    //"contourne par la droite l'obstacle orange"
+                ecrire(r, fr ? "par la %s " : "por la %s ", r->l->directions[a->direction]);
+                objet(r, false, true, &a->objet, &a->couleur, NULL);
+            }
+            break;
+        case VERBE_PASSER:    //"passe entre la boule bleue et le cube rouge"
+            ecrire(r, "entre ");
+            objet(r, false, true, &a->objet, &a->couleur, NULL);
+            ecrire(r, fr ? " et " : " y ");
+            objet(r, false, true, &a->objet2, &a->couleur2, NULL);
+            break;
+        case VERBE_COMPTER:    //"compte les boules bleues", "compte le nombre de cubes"
+            if (hasard(r, 2) == 0) {
+                ecrire(r, fr ? "le nombre de " : "el número de ");
+                objet(r, true, false, &a->objet, &a->couleur, NULL);
+            } else {
+                objet(r, true, true, &a->objet, &a->couleur, NULL);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Génère une phrase aléatoire, en français ou en espagnol, et les actions qu'elle doit produire.
+ * @param p Reçoit la phrase et les actions attendues.
+ * @param graine Etat du générateur (rand_r), avancé à chaque appel : une même graine redonne le même corpus.
+ */
+void corpus_generer(PhraseCorpus *p, unsigned int *graine) {
+    Redaction r = {p, 0, graine, NULL};
+
+    r.l = (hasard(&r, 2) == 0) ? &langage_fr : &langage_es;
+    p->langue = r.l->langue;
+    p->texte[0] = '\0';
+    p->nb_actions = 1 + hasard(&r, CORPUS_ACTIONS_MAX);
+    for (int i = 0; i < p->nb_actions; i++) {
+        if (i > 0) {
+            ecrire(&r, " %s ", r.l->separateur);
+        }
+        sousPhrase(&r, &p->attendues[i]);
+    }
+}
+
+/**
+ * @brief Phrases écrites à la main, hors des tournures du générateur : mots courants proches d'un mot-clé
+ * ("para", "mira", "route", "boucle"...), mots inconnus et fautes de frappe. Un mot courant ne doit remplir
+ * aucune case de l'action ; une faute de frappe ne doit remplir qu'une case restée vide.
+ */
+static const PhraseCorpus phrases_libres[] = {
+    {"avanza de 2 metros para llegar", LANGUE_ES,
+     {{.opcode = VERBE_AVANCER, .mesure = MESURE_DISTANCE, .valeur = 2, .langue = LANGUE_ES}}, 1},
+    {"mira la pelota azul", LANGUE_ES,
+     {{.objet = OBJET_BOULE, .couleur = COULEUR_BLEU, .langue = LANGUE_ES}}, 1},
+    {"hola avanza de 2 metros", LANGUE_ES,
+     {{.opcode = VERBE_AVANCER, .mesure = MESURE_DISTANCE, .valeur = 2, .langue = LANGUE_ES}}, 1},
+    {"avanza hasta la casa", LANGUE_ES,
+     {{.opcode = VERBE_AVANCER, .langue = LANGUE_ES}}, 1},
+    {"sigue la calle y gira a la derecha", LANGUE_ES,
+     {{.opcode = VERBE_TOURNER, .direction = DIRECTION_DROITE, .langue = LANGUE_ES}}, 1},
+    {"pasa contra la bola azul", LANGUE_ES,
+     {{.opcode = VERBE_PASSER, .objet2 = OBJET_BOULE, .couleur2 = COULEUR_BLEU, .langue = LANGUE_ES}}, 1},
+    {"prends la route puis recule de 3 mètres", LANGUE_FR,
+     {{.langue = LANGUE_FR},
+      {.opcode = VERBE_RECULER, .mesure = MESURE_DISTANCE, .valeur = 3, .langue = LANGUE_FR}}, 2},
+    {"fais une boucle autour de la boule bleue", LANGUE_FR,
+     {{.objet = OBJET_BOULE, .couleur = COULEUR_BLEU, .langue = LANGUE_FR}}, 1},
+    {"va vers la salle puis avance de 2 mètres", LANGUE_FR,
+     {{.langue = LANGUE_FR},
+      {.opcode = VERBE_AVANCER, .mesure = MESURE_DISTANCE, .valeur = 2, .langue = LANGUE_FR}}, 2},
+    {"retourne à gauche", LANGUE_FR,
+     {{.direction = DIRECTION_GAUCHE, .langue = LANGUE_FR}}, 1},
+    {"avance de 2 mètres tourme", LANGUE_FR,
+     {{.opcode = VERBE_AVANCER, .mesure = MESURE_DISTANCE, .valeur = 2, .langue = LANGUE_FR}}, 1},
+    {"localise la boule bleue rouje", LANGUE_FR,
+     {{.opcode = VERBE_LOCALISER, .objet = OBJET_BOULE, .couleur = COULEUR_BLEU, .langue = LANGUE_FR}}, 1},
+    {"localise la boule rouje", LANGUE_FR,
+     {{.opcode = VERBE_LOCALISER, .objet = OBJET_BOULE, .couleur = COULEUR_ROUGE, .langue = LANGUE_FR}}, 1},
+    {"avnce de 2 mètres", LANGUE_FR,
+     {{.opcode = VERBE_AVANCER, .mesure = MESURE_DISTANCE, .valeur = 2, .langue = LANGUE_FR}}, 1},
+    {"gria a la derecha", LANGUE_ES,
+     {{.opcode = VERBE_TOURNER, .direction = DIRECTION_DROITE, .langue = LANGUE_ES}}, 1},
+    {"localiza la pelotta amarilla", LANGUE_ES,
+     {{.opcode = VERBE_LOCALISER, .objet = OBJET_BOULE, .couleur = COULEUR_JAUNE, .langue = LANGUE_ES}}, 1},
+};
+
+/**
+ * @brief Donne les phrases écrites à la main et leurs actions attendues.
+ * @param nb_phrases Reçoit le nombre de phrases.
+ */
+const PhraseCorpus *corpus_libres(int *nb_phrases) {
+    *nb_phrases = (int) (sizeof(phrases_libres) / sizeof(phrases_libres[0]));
+    return phrases_libres;
+}
+
+/**
+ * @brief Compare deux actions champ par champ (les distances converties à 1e-9 près).
+ */
+bool corpus_actionsEgales(const ActionData *a, const ActionData *b) {
+    return a->opcode == b->opcode && a->mesure == b->mesure && fabs(a->valeur - b->valeur) <= 1e-9
+        && a->direction == b->direction && a->objet == b->objet && a->couleur == b->couleur
+        && a->objet2 == b->objet2 && a->couleur2 == b->couleur2 && a->langue == b->langue
+        && a->negation == b->negation;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,32 @@
+/**
+ * @file
+ * @brief Ce fichier contient les déclarations du générateur de phrases de commande.
+ * Chaque phrase est tirée au hasard parmi toutes les tournures acceptées par le traitement de texte, en français
+ * ou en espagnol, et accompagnée des ActionData qu'elle doit produire : elle sert à la fois de charge de travail
+ * et de référence pour vérifier l'analyse. Quelques phrases écrites à la main (corpus_libres) complètent ce corpus
+ * avec des mots que le générateur n'emploie jamais.
+ */
+
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include "traitementTexte.h"
+
+#define CORPUS_LONGUEUR_PHRASE 512    //Taille maximale d'une phrase générée, '\0' compris.
+#define CORPUS_ACTIONS_MAX 4          //Nombre maximal de sous-phrases d'une phrase générée.
+
+/**
+ * @brief Phrase générée et actions attendues.
+ */
+typedef struct {
+    char texte[CORPUS_LONGUEUR_PHRASE];
+    int langue;                                   /**< LANGUE_FR ou LANGUE_ES. */
+    ActionData attendues[CORPUS_ACTIONS_MAX];     /**< Action de chaque sous-phrase, dans l'ordre. */
+    int nb_actions;
+} PhraseCorpus;
+
+void corpus_generer(PhraseCorpus *p, unsigned int *graine);
+const PhraseCorpus *corpus_libres(int *nb_phrases);
+bool corpus_actionsEgales(const ActionData *a, const ActionData *b);
+
+#endif
@@ -0,0 +1,658 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "lexique.h"
+#include "normalisation.h"
+
+/**
+ * @file
+ * @brief Ce fichier rassemble le lexique des mots-clés français et espagnols et son index de recherche.
+ *
+ * Les tables de vocabulaire de chaque langue sont entièrement définies à la compilation. Un index par hachage (adressage
+ * ouvert, sondage linéaire) est construit une seule fois au premier appel, de façon sûre entre threads,
+ * puis n'est plus jamais modifié : une recherche coûte la normalisation du mot (minuscules, sans accents), un hachage et en moyenne une comparaison,
+ * quelle que soit la taille du vocabulaire.
+ *
+ * Pour retrouver un mot mal écrit ("avnce", "tounre"), chaque verbe, objet et couleur est aussi indexé par les
+ * empreintes de ses variantes privées d'une lettre (de deux pour les mots longs) : un mot à une ou deux fautes près
+ * partage au moins une variante avec le mot-clé. Seuls les mots-clés retrouvés par les variantes du mot sont
+ * examinés, l'ensemble de leurs lettres en écarte la plupart sans calcul, et la distance d'édition n'est calculée
+ * que sur les quelques candidats restants. Les mots courants proches d'un mot-clé ("para", "route") ne sont jamais
+ * corrigés.
+ */
+
+/**
+ * @defgroup lexique Lexique des mots-clés
+ * @brief Classification des mots d'une phrase en une seule recherche.
+ * @{
+ */
+
+#define FR LANGUE_FR
+#define ES LANGUE_ES
+
+//Vocabulaire de chaque langue. Un mot commun aux deux langues ("entre") figure dans chaque table.
+//Pour chaque code, le premier mot de la table est celui utilisé pour l'afficher (lexique_nom).
+static const EntreeLexique vocabulaire_fr[] = {
+    //Verbes
+    {"avancer", CAT_VERBE, FR, 0, VERBE_AVANCER, "avancer", 0},
+    {"avance", CAT_VERBE, FR, 0, VERBE_AVANCER, "avancer", 0},
+    {"reculer", CAT_VERBE, FR, 0, VERBE_RECULER, "reculer", 0},
+    {"recule", CAT_VERBE, FR, 0, VERBE_RECULER, "reculer", 0},
+    {"tourner", CAT_VERBE, FR, 0, VERBE_TOURNER, "tourner", 0},
+    {"tourne", CAT_VERBE, FR, 0, VERBE_TOURNER, "tourner", 0},
+    {"localiser", CAT_VERBE, FR, 0, VERBE_LOCALISER, "localiser", 0},
+    {"localise", CAT_VERBE, FR, 0, VERBE_LOCALISER, "localiser", 0},
+    {"trouver", CAT_VERBE, FR, 0, VERBE_LOCALISER, "trouver", 0},
+    {"trouve", CAT_VERBE, FR, 0, VERBE_LOCALISER, "trouver", 0},
+    {"contourner", CAT_VERBE, FR, 0, VERBE_CONTOURNER, "contourner", 0},
+    {"contourne", CAT_VERBE, FR, 0, VERBE_CONTOURNER, "contourner", 0},
+    {"passer", CAT_VERBE, FR, 0, VERBE_PASSER, "passer", 0},
+    {"passe", CAT_VERBE, FR, 0, VERBE_PASSER, "passer", 0},
+    {"compter", CAT_VERBE, FR, 0, VERBE_COMPTER, "compter", 0},
+    {"compte", CAT_VERBE, FR, 0, VERBE_COMPTER, "compter", 0},
+
+    //Objets
+    {"cube", CAT_OBJET, FR, 0, OBJET_CUBE, "cube", 0},
+    {"carré", CAT_OBJET, FR, 0, OBJET_CUBE, "carré", 0},
+    {"boule", CAT_OBJET, FR, 0, OBJET_BOULE, "boule", 0},
+    {"balle", CAT_OBJET, FR, 0, OBJET_BOULE, "balle", 0},
+    {"objet", CAT_OBJET, FR, 0, OBJET_OBJET, "objet", 0},
+    {"obstacle", CAT_OBJET, FR, 0, OBJET_OBSTACLE, "obstacle", 0},
+    {"cubes", CAT_OBJET, FR, 1, OBJET_CUBE, "cube", 0},
+    {"carrés", CAT_OBJET, FR, 1, OBJET_CUBE, "carré", 0},
+    {"boules", CAT_OBJET, FR, 1, OBJET_BOULE, "boule", 0},
+    {"balles", CAT_OBJET, FR, 1, OBJET_BOULE, "balle", 0},
+    {"objets", CAT_OBJET, FR, 1, OBJET_OBJET, "objet", 0},
+    {"obstacles", CAT_OBJET, FR, 1, OBJET_OBSTACLE, "obstacle", 0},
+
+    //Couleurs
+    {"rouge", CAT_COULEUR, FR, 0, COULEUR_ROUGE, "rouge", 0},
+    {"bleu", CAT_COULEUR, FR, 0, COULEUR_BLEU, "bleu", 0},
+    {"bleue", CAT_COULEUR, FR, 0, COULEUR_BLEU, "bleu", 0},
+    {"jaune", CAT_COULEUR, FR, 0, COULEUR_JAUNE, "jaune", 0},
+    {"orange", CAT_COULEUR, FR, 0, COULEUR_ORANGE, "orange", 0},
+    {"rouges", CAT_COULEUR, FR, 1, COULEUR_ROUGE, "rouge", 0},
+    {"bleus", CAT_COULEUR, FR, 1, COULEUR_BLEU, "bleu", 0},
+    {"bleues", CAT_COULEUR, FR, 1, COULEUR_BLEU, "bleu", 0},
+    {"jaunes", CAT_COULEUR, FR, 1, COULEUR_JAUNE, "jaune", 0},
+    {"oranges", CAT_COULEUR, FR, 1, COULEUR_ORANGE, "orange", 0},
+
+    //Directions
+    {"gauche", CAT_DIRECTION, FR, 0, DIRECTION_GAUCHE, "gauche", 0},
+    {"droite", CAT_DIRECTION, FR, 0, DIRECTION_DROITE, "droite", 0},
+
+    //Unités, la valeur est le facteur de conversion vers l'unité de base
+    {"mètres", CAT_UNITE_DISTANCE, FR, 0, 0, "mètres", 1},
+    {"mètre", CAT_UNITE_DISTANCE, FR, 0, 0, "mètres", 1},
+    {"centimètres", CAT_UNITE_DISTANCE, FR, 0, 0, "mètres", 0.01},
+    {"millimètres", CAT_UNITE_DISTANCE, FR, 0, 0, "mètres", 0.001},
+    {"degrés", CAT_UNITE_ANGLE, FR, 0, 0, "degrés", 1},
+    {"degré", CAT_UNITE_ANGLE, FR, 0, 0, "degrés", 1},
+
+    //Connecteurs
+    {"puis", CAT_SEPARATEUR, FR, 0, 0, "puis", 0},
+    {"entre", CAT_ENTRE, FR, 0, 0, "entre", 0},
+    {"et", CAT_ET, FR, 0, 0, "et", 0},
+    {"ou", CAT_OU, FR, 0, 0, "ou", 0},
+    {"ne", CAT_NEGATION, FR, 0, 0, "ne", 0},
+    {"n", CAT_NEGATION, FR, 0, 0, "ne", 0},
+
+    //Nombres
+    {"un", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "un", 1},
+    {"deux", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "deux", 2},
+    {"trois", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "trois", 3},
+    {"quatre", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "quatre", 4},
+    {"cinq", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "cinq", 5},
+    {"six", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "six", 6},
+    {"sept", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "sept", 7},
+    {"huit", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "huit", 8},
+    {"neuf", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "neuf", 9},
+    {"dix", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "dix", 10},
+    {"onze", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "onze", 11},
+    {"douze", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "douze", 12},
+    {"treize", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "treize", 13},
+    {"quatorze", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "quatorze", 14},
+    {"quinze", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "quinze", 15},
+    {"seize", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "seize", 16},
+    {"vingt", CAT_NOMBRE, FR, 0, NOMBRE_VINGT, "vingt", 20},
+    {"vingts", CAT_NOMBRE, FR, 0, NOMBRE_VINGT, "vingts", 20},
+    {"trente", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "trente", 30},
+    {"quarante", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "quarante", 40},
+    {"cinquante", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "cinquante", 50},
+    {"soixante", CAT_NOMBRE, FR, 0, NOMBRE_SIMPLE, "soixante", 60},
+    {"cent", CAT_NOMBRE, FR, 0, NOMBRE_CENT, "cent", 100},
+    {"cents", CAT_NOMBRE, FR, 0, NOMBRE_CENT, "cents", 100},
+    {"mille", CAT_NOMBRE, FR, 0, NOMBRE_MILLE, "mille", 1000},
+    {"milles", CAT_NOMBRE, FR, 0, NOMBRE_MILLE, "milles", 1000},
+};
+
+static const EntreeLexique vocabulaire_es[] = {
+    //Verbes
+    {"avanzar", CAT_VERBE, ES, 0, VERBE_AVANCER, "avanzar", 0},
+    {"avanza", CAT_VERBE, ES, 0, VERBE_AVANCER, "avanzar", 0},
+    {"avances", CAT_VERBE, ES, 0, VERBE_AVANCER, "avanzar", 0},
+    {"retroceder", CAT_VERBE, ES, 0, VERBE_RECULER, "retroceder", 0},
+    {"retrocede", CAT_VERBE, ES, 0, VERBE_RECULER, "retroceder", 0},
+    {"retrocedas", CAT_VERBE, ES, 0, VERBE_RECULER, "retroceder", 0},
+    {"girar", CAT_VERBE, ES, 0, VERBE_TOURNER, "girar", 0},
+    {"gira", CAT_VERBE, ES, 0, VERBE_TOURNER, "girar", 0},
+    {"gires", CAT_VERBE, ES, 0, VERBE_TOURNER, "girar", 0},
+    {"localizar", CAT_VERBE, ES, 0, VERBE_LOCALISER, "localizar", 0},
+    {"localiza", CAT_VERBE, ES, 0, VERBE_LOCALISER, "localizar", 0},
+    {"localices", CAT_VERBE, ES, 0, VERBE_LOCALISER, "localizar", 0},
+    {"encontrar", CAT_VERBE, ES, 0, VERBE_LOCALISER, "encontrar", 0},
+    {"encuentra", CAT_VERBE, ES, 0, VERBE_LOCALISER, "encontrar", 0},
+    {"encuentres", CAT_VERBE, ES, 0, VERBE_LOCALISER, "encontrar", 0},
+    {"rodear", CAT_VERBE, ES, 0, VERBE_CONTOURNER, "rodear", 0},
+    {"rodea", CAT_VERBE, ES, 0, VERBE_CONTOURNER, "rodear", 0},
+    {"rodées", CAT_VERBE, ES, 0, VERBE_CONTOURNER, "rodear", 0},
+    {"pasar", CAT_VERBE, ES, 0, VERBE_PASSER, "pasar", 0},
+    {"pasa", CAT_VERBE, ES, 0, VERBE_PASSER, "pasar", 0},
+    {"pases", CAT_VERBE, ES, 0, VERBE_PASSER, "pasar", 0},
+    {"contar", CAT_VERBE, ES, 0, VERBE_COMPTER, "contar", 0},
+    {"cuenta", CAT_VERBE, ES, 0, VERBE_COMPTER, "contar", 0},
+    {"cuentes", CAT_VERBE, ES, 0, VERBE_COMPTER, "contar", 0},
+
+    //Objets
+    {"cubo", CAT_OBJET, ES, 0, OBJET_CUBE, "cubo", 0},
+    {"cuadrado", CAT_OBJET, ES, 0, OBJET_CUBE, "cuadrado", 0},
+    {"bola", CAT_OBJET, ES, 0, OBJET_BOULE, "bola", 0},
+    {"pelota", CAT_OBJET, ES, 0, OBJET_BOULE, "pelota", 0},
+    {"objeto", CAT_OBJET, ES, 0, OBJET_OBJET, "objeto", 0},
+    {"obstaculo", CAT_OBJET, ES, 0, OBJET_OBSTACLE, "obstaculo", 0},
+    {"cubos", CAT_OBJET, ES, 1, OBJET_CUBE, "cubo", 0},
+    {"cuadrados", CAT_OBJET, ES, 1, OBJET_CUBE, "cuadrado", 0},
+    {"bolas", CAT_OBJET, ES, 1, OBJET_BOULE, "bola", 0},
+    {"pelotas", CAT_OBJET, ES, 1, OBJET_BOULE, "pelota", 0},
+    {"objetos", CAT_OBJET, ES, 1, OBJET_OBJET, "objeto", 0},
+    {"obstaculos", CAT_OBJET, ES, 1, OBJET_OBSTACLE, "obstaculo", 0},
+
+    //Couleurs
+    {"rojo", CAT_COULEUR, ES, 0, COULEUR_ROUGE, "rojo", 0},
+    {"roja", CAT_COULEUR, ES, 0, COULEUR_ROUGE, "rojo", 0},
+    {"azul", CAT_COULEUR, ES, 0, COULEUR_BLEU, "azul", 0},
+    {"amarillo", CAT_COULEUR, ES, 0, COULEUR_JAUNE, "amarillo", 0},
+    {"amarilla", CAT_COULEUR, ES, 0, COULEUR_JAUNE, "amarillo", 0},
+    {"naranja", CAT_COULEUR, ES, 0, COULEUR_ORANGE, "naranja", 0},
+    {"rojos", CAT_COULEUR, ES, 1, COULEUR_ROUGE, "rojo", 0},
+    {"rojas", CAT_COULEUR, ES, 1, COULEUR_ROUGE, "rojo", 0},
+    {"azules", CAT_COULEUR, ES, 1, COULEUR_BLEU, "azul", 0},
+    {"amarillos", CAT_COULEUR, ES, 1, COULEUR_JAUNE, "amarillo", 0},
+    {"amarillas", CAT_COULEUR, ES, 1, COULEUR_JAUNE, "amarillo", 0},
+    {"naranjas", CAT_COULEUR, ES, 1, COULEUR_ORANGE, "naranja", 0},
+
+    //Directions
+    {"izquierda", CAT_DIRECTION, ES, 0, DIRECTION_GAUCHE, "izquierda", 0},
+    {"derecha", CAT_DIRECTION, ES, 0, DIRECTION_DROITE, "derecha", 0},
+
+    //Unités, la valeur est le facteur de conversion vers l'unité de base
+    {"metros", CAT_UNITE_DISTANCE, ES, 0, 0, "metros", 1},
+    {"metro", CAT_UNITE_DISTANCE, ES, 0, 0, "metros", 1},
+    {"centimetros", CAT_UNITE_DISTANCE, ES, 0, 0, "metros", 0.01},
+    {"milimetros", CAT_UNITE_DISTANCE, ES, 0, 0, "metros", 0.001},
+    {"grados", CAT_UNITE_ANGLE, ES, 0, 0, "grados", 1},
+    {"grado", CAT_UNITE_ANGLE, ES, 0, 0, "grados", 1},
+
+    //Connecteurs
+    {"luego", CAT_SEPARATEUR, ES, 0, 0, "luego", 0},
+    {"entre", CAT_ENTRE, ES, 0, 0, "entre", 0},
+    {"y", CAT_ET, ES, 0, 0, "y", 0},
+    {"o", CAT_OU, ES, 0, 0, "o", 0},
+    {"no", CAT_NEGATION, ES, 0, 0, "no", 0},
+
+    //Nombres
+    {"un", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "un", 1},
+    {"uno", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "uno", 1},
+    {"dos", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "dos", 2},
+    {"tres", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "tres", 3},
+    {"cuatro", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "cuatro", 4},
+    {"cinco", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "cinco", 5},
+    {"seis", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "seis", 6},
+    {"siete", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "siete", 7},
+    {"ocho", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "ocho", 8},
+    {"nueve", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "nueve", 9},
+    {"diez", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "diez", 10},
+    {"once", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "once", 11},
+    {"doce", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "doce", 12},
+    {"trece", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "trece", 13},
+    {"catorce", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "catorce", 14},
+    {"quince", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "quince", 15},
+    {"dieciseis", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "dieciseis", 16},
+    {"diecisiete", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "diecisiete", 17},
+    {"dieciocho", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "dieciocho", 18},
+    {"diecinueve", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "diecinueve", 19},
+    {"veinte", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veinte", 20},
+    {"veintiun", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veintiun", 21},
+    {"veintiuno", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veintiuno", 21},
+    {"veintidos", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veintidos", 22},
+    {"veintitres", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veintitres", 23},
+    {"veinticuatro", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veinticuatro", 24},
+    {"veinticinco", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veinticinco", 25},
+    {"veintiseis", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veintiseis", 26},
+    {"veintisiete", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veintisiete", 27},
+    {"veintiocho", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veintiocho", 28},
+    {"veintinueve", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "veintinueve", 29},
+    {"treinta", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "treinta", 30},
+    {"cuarenta", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "cuarenta", 40},
+    {"cincuenta", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "cincuenta", 50},
+    {"sesenta", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "sesenta", 60},
+    {"setenta", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "setenta", 70},
+    {"ochenta", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "ochenta", 80},
+    {"noventa", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "noventa", 90},
+    {"cien", CAT_NOMBRE, ES, 0, NOMBRE_CENT, "cien", 100},
+    {"ciento", CAT_NOMBRE, ES, 0, NOMBRE_CENT, "ciento", 100},
+    {"doscientos", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "doscientos", 200},
+    {"trescientos", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "trescientos", 300},
+    {"cuatrocientos", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "cuatrocientos", 400},
+    {"quinientos", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "quinientos", 500},
+    {"seiscientos", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "seiscientos", 600},
+    {"setecientos", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "setecientos", 700},
+    {"ochocientos", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "ochocientos", 800},
+    {"novecientos", CAT_NOMBRE, ES, 0, NOMBRE_SIMPLE, "novecientos", 900},
+    {"mil", CAT_NOMBRE, ES, 0, NOMBRE_MILLE, "mil", 1000},
+};
+
+#undef FR
+#undef ES
+
+//Ajouter une langue revient à ajouter sa table de vocabulaire ici.
+static const struct {
+    const EntreeLexique *mots;
+    size_t nb_mots;
+} vocabulaires[] = {
+    {vocabulaire_fr, sizeof(vocabulaire_fr) / sizeof(vocabulaire_fr[0])},
+    {vocabulaire_es, sizeof(vocabulaire_es) / sizeof(vocabulaire_es[0])},
+};
+
+#define NB_VOCABULAIRES (sizeof(vocabulaires) / sizeof(vocabulaires[0]))
+#define TAILLE_INDEX 1024    //Puissance de 2, au moins deux fois le nombre total d'entrées.
+#define LONGUEUR_CLE_MAX 32  //Taille maximale de la forme normalisée d'un mot-clé, '\0' compris.
+
+#define LONGUEUR_APPROCHE_MIN 4    //Les mots plus courts ne sont jamais corrigés ("de", "pas", "les"...).
+#define LONGUEUR_TOLERANCE_2 8     //Les mots de cette longueur et au-delà sont corrigés à deux erreurs près.
+#define TAILLE_VARIANTES 8192      //Puissance de 2, au moins deux fois le nombre de variantes des mots corrigibles.
+#define VARIANTES_MAX (1 + (LONGUEUR_CLE_MAX - 1) + (LONGUEUR_CLE_MAX - 1) * (LONGUEUR_CLE_MAX - 2) / 2)
+
+static const EntreeLexique *index_lexique[TAILLE_INDEX];    //NULL pour une case vide.
+static char index_cles[TAILLE_INDEX][LONGUEUR_CLE_MAX];     //Forme normalisée du mot de chaque case.
+static pthread_once_t index_initialise = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Mot-clé pouvant être corrigé (verbe, objet ou couleur).
+ */
+typedef struct {
+    const EntreeLexique *entree;
+    const char *cle;              /**< Forme normalisée, dans index_cles. */
+    uint32_t lettres;             /**< Voir lettresMot(). */
+} MotApproche;
+
+/**
+ * @brief Case de l'index des variantes : empreinte d'une variante et mot-clé dont elle provient.
+ */
+typedef struct {
+    uint32_t empreinte;
+    int mot;                      /**< Indice dans mots_approche, -1 pour une case vide. */
+} VarianteApproche;
+
+static MotApproche mots_approche[TAILLE_INDEX];
+static int nb_mots_approche;
+static VarianteApproche index_variantes[TAILLE_VARIANTES];
+
+/**
+ * @brief Mots courants, sans accent, jamais corrigés en mot-clé : ce sont de vrais mots et non des fautes de frappe
+ * ("para" n'est pas "pasa", "route" n'est pas "rouge"). Rangés par ordre alphabétique.
+ */
+static const char *const mots_courants[] = {
+    "boucle",      //fr
+    "calle",       //es
+    "casa",        //es
+    "contra",      //es
+    "hola",        //es
+    "mira",        //es
+    "mirar",       //es
+    "para",        //es
+    "parar",       //es
+    "pare",        //es
+    "paso",        //es
+    "poule",       //fr
+    "retourne",    //fr
+    "route",       //fr
+    "salle",       //fr
+};
+
+#define NB_MOTS_COURANTS (sizeof(mots_courants) / sizeof(mots_courants[0]))
+
+static uint32_t hacher(const char *mot, size_t longueur) {    //FNV-1a.
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < longueur; i++) {
+        h ^= (unsigned char) mot[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Lettres présentes dans un mot normalisé : un bit par lettre de 'a' à 'z', un bit pour tout autre octet.
+ * Une opération d'édition change au plus deux bits, d'où une borne inférieure de la distance sans calcul.
+ */
+static uint32_t lettresMot(const char *mot, size_t longueur) {
+    uint32_t lettres = 0;
+    for (size_t i = 0; i < longueur; i++) {
+        unsigned char c = (unsigned char) mot[i];
+        lettres |= (c >= 'a' && c <= 'z') ? 1u << (c - 'a') : 1u << 26;
+    }
+    return lettres;
+}
+
+/**
+ * @brief Empreintes des variantes d'un mot normalisé : le mot lui-même, puis le mot privé d'une lettre, puis de deux
+ * lettres si suppressions vaut 2. Deux mots à distance d'édition au plus d ont une variante commune obtenue en
+ * supprimant au plus d lettres de chacun : seuls les mots-clés qui partagent une variante avec le mot cherché sont
+ * comparés. Le nombre de variantes ne dépend que de la longueur du mot (au plus VARIANTES_MAX).
+ * @return Nombre d'empreintes écrites.
+ */
+static int variantesMot(const char *mot, size_t longueur, int suppressions, uint32_t *empreintes) {
+    char v[LONGUEUR_CLE_MAX];
+    int n = 0;
+
+    empreintes[n++] = hacher(mot, longueur);
+    for (size_t i = 0; suppressions >= 1 && i < longueur; i++) {
+        memcpy(v, mot, i);
+        memcpy(v + i, mot + i + 1, longueur - i - 1);
+        empreintes[n++] = hacher(v, longueur - 1);
+        for (size_t j = i; suppressions >= 2 && j + 1 < longueur; j++) {    //Supprime aussi la lettre j + 1 du mot.
+            memcpy(v + i, mot + i + 1, j - i);
+            memcpy(v + j, mot + j + 2, longueur - j - 2);
+            empreintes[n++] = hacher(v, longueur - 2);
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Range une variante d'un mot-clé dans l'index des variantes, sauf si elle y est déjà pour ce mot-clé.
+ * @return false si l'index est plein.
+ */
+static bool indexerVariante(uint32_t empreinte, int mot) {
+    uint32_t h = empreinte & (TAILLE_VARIANTES - 1);
+    for (uint32_t essais = 0; essais < TAILLE_VARIANTES; essais++) {
+        VarianteApproche *v = &index_variantes[h];
+        if (v->mot < 0) {
+            *v = (VarianteApproche) {empreinte, mot};
+            return true;
+        }
+        if (v->mot == mot && v->empreinte == empreinte) {
+            return true;
+        }
+        h = (h + 1) & (TAILLE_VARIANTES - 1);
+    }
+    return false;
+}
+
+static int comparerMots(const void *a, const void *b) {
+    return strcmp(*(const char *const *) a, *(const char *const *) b);
+}
+
+/**
+ * @brief Distance d'édition entre deux mots (insertion, suppression, substitution et inversion de deux lettres
+ * voisines comptent 1), calculée seulement jusqu'à une borne : seules les cases à moins de borne de la diagonale
+ * sont calculées.
+ * @return La distance, ou borne + 1 dès qu'elle dépasse la borne.
+ */
+static int distanceBornee(const char *a, size_t la, const char *b, size_t lb, int borne) {
+    int lignes[3][LONGUEUR_CLE_MAX + 1];
+    int *avant = lignes[0], *precedente = lignes[1], *courante = lignes[2];
+    const int infini = borne + 1;
+
+    if ((int) (la > lb ? la - lb : lb - la) > borne) {
+        return infini;
+    }
+    for (size_t j = 0; j <= lb; j++) {
+        precedente[j] = ((int) j > borne) ? infini : (int) j;
+    }
+    for (int i = 1; i <= (int) la; i++) {
+        int jmin = (i - borne > 1) ? i - borne : 1;
+        int jmax = (i + borne < (int) lb) ? i + borne : (int) lb;
+        int minimum = infini;
+
+        courante[0] = (i > borne) ? infini : i;
+        courante[jmin - 1] = (jmin == 1) ? courante[0] : infini;
+        if (jmin == 1) {
+            minimum = courante[0];
+        }
+        for (int j = jmin; j <= jmax; j++) {
+            int d = precedente[j - 1] + (a[i - 1] != b[j - 1]);
+            if (precedente[j] + 1 < d) {
+                d = precedente[j] + 1;
+            }
+            if (courante[j - 1] + 1 < d) {
+                d = courante[j - 1] + 1;
+            }
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1] && avant[j - 2] + 1 < d) {
+                d = avant[j - 2] + 1;
+            }
+            courante[j] = (d > infini) ? infini : d;
+            if (d < minimum) {
+                minimum = d;
+            }
+        }
+        if (jmax < (int) lb) {
+            courante[jmax + 1] = infini;
+        }
+        if (minimum > borne) {
+            return infini;
+        }
+        int *libre = avant;
+        avant = precedente;
+        precedente = courante;
+        courante = libre;
+    }
+    return precedente[lb] > borne ? infini : precedente[lb];
+}
+
+static void construireIndex(void) {
+    size_t nb_entrees = 0;
+    for (size_t v = 0; v < NB_VOCABULAIRES; v++) {
+        nb_entrees += vocabulaires[v].nb_mots;
+    }
+    if (nb_entrees * 2 > TAILLE_INDEX) {
+        fprintf(stderr, "Erreur: l'index du lexique est trop petit.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    //Les mots sont indexés par leur forme normalisée : "mètres" est aussi trouvé pour "metres" ou "MÈTRES".
+    for (size_t v = 0; v < NB_VOCABULAIRES; v++) {
+        for (size_t i = 0; i < vocabulaires[v].nb_mots; i++) {
+            const EntreeLexique *e = &vocabulaires[v].mots[i];
+            char cle[LONGUEUR_CLE_MAX];
+            size_t longueur = strlen(e->mot);
+            if (longueur >= LONGUEUR_CLE_MAX) {
+                fprintf(stderr, "Erreur: le mot-clé \"%s\" est trop long.\n", e->mot);
+                exit(EXIT_FAILURE);
+            }
+            longueur = normaliser_texte(e->mot, longueur, cle);
+            cle[longueur] = '\0';
+
+            uint32_t h = hacher(cle, longueur) & (TAILLE_INDEX - 1);
+            while (index_lexique[h] != NULL) {
+                h = (h + 1) & (TAILLE_INDEX - 1);
+            }
+            index_lexique[h] = e;
+            memcpy(index_cles[h], cle, longueur + 1);
+
+        }
+    }
+
+    //Mots-clés pouvant être corrigés, et index de leurs variantes. Un mot-clé assez long pour être comparé à un mot
+    //de LONGUEUR_TOLERANCE_2 lettres ou plus est indexé avec ses variantes à deux lettres de moins.
+    for (size_t i = 0; i < TAILLE_VARIANTES; i++) {
+        index_variantes[i].mot = -1;
+    }
+    for (size_t h = 0; h < TAILLE_INDEX; h++) {
+        const EntreeLexique *e = index_lexique[h];
+        if (e != NULL && (e->categorie == CAT_VERBE || e->categorie == CAT_OBJET || e->categorie == CAT_COULEUR)) {
+            size_t longueur = strlen(index_cles[h]);
+            uint32_t empreintes[VARIANTES_MAX];
+            int n = variantesMot(index_cles[h], longueur, (longueur + 2 >= LONGUEUR_TOLERANCE_2) ? 2 : 1, empreintes);
+            mots_approche[nb_mots_approche] = (MotApproche) {e, index_cles[h], lettresMot(index_cles[h], longueur)};
+            for (int i = 0; i < n; i++) {
+                if (!indexerVariante(empreintes[i], nb_mots_approche)) {
+                    fprintf(stderr, "Erreur: l'index des variantes du lexique est trop petit.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            nb_mots_approche++;
+        }
+    }
+    for (size_t i = 1; i < NB_MOTS_COURANTS; i++) {
+        if (strcmp(mots_courants[i - 1], mots_courants[i]) >= 0) {
+            fprintf(stderr, "Erreur: les mots courants du lexique ne sont pas rangés par ordre alphabétique.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/**
+ * @brief Cherche un mot dans le lexique.
+ * @param mot Début du mot (pas forcément terminé par '\0'), en UTF-8. La casse et les accents sont ignorés.
+ * @param longueur Nombre d'octets du mot.
+ * @param langues Masque des langues acceptées (LANGUE_FR, LANGUE_ES ou LANGUE_TOUTES).
+ * @return L'entrée du lexique correspondante, NULL si le mot n'est pas un mot-clé.
+ */
+const EntreeLexique *lexique_chercher(const char *mot, size_t longueur, int langues) {
+    return lexique_chercherLangues(mot, longueur, langues, NULL);
+}
+
+/**
+ * @brief Comme lexique_chercher(), mais donne aussi toutes les langues dans lesquelles le mot existe, pour
+ * identifier la langue d'une phrase au fil de son analyse.
+ * @param langues_mot Reçoit le masque des langues du mot parmi les langues acceptées (0 si le mot est inconnu).
+ * NULL si l'information n'est pas utile.
+ */
+const EntreeLexique *lexique_chercherLangues(const char *mot, size_t longueur, int langues, int *langues_mot) {
+    const EntreeLexique *trouvee = NULL;
+    char cle[2 * LONGUEUR_CLE_MAX];    //Une forme normalisée fait au moins la moitié du mot.
+    pthread_once(&index_initialise, construireIndex);
+
+    if (langues_mot != NULL) {
+        *langues_mot = 0;
+    }
+    if (longueur > sizeof(cle)) {
+        return NULL;
+    }
+    longueur = normaliser_texte(mot, longueur, cle);
+    if (longueur >= LONGUEUR_CLE_MAX) {
+        return NULL;
+    }
+    uint32_t h = hacher(cle, longueur) & (TAILLE_INDEX - 1);
+    while (index_lexique[h] != NULL) {
+        const EntreeLexique *e = index_lexique[h];
+        if ((e->langues & langues) && memcmp(index_cles[h], cle, longueur) == 0 && index_cles[h][longueur] == '\0') {
+            if (langues_mot == NULL) {
+                return e;
+            }
+            if (trouvee == NULL) {
+                trouvee = e;
+            }
+            *langues_mot |= e->langues & langues;
+        }
+        h = (h + 1) & (TAILLE_INDEX - 1);
+    }
+    return trouvee;
+}
+
+/**
+ * @brief Cherche le verbe, l'objet ou la couleur le plus proche d'un mot mal écrit. La distance tolérée est 1 pour
+ * les mots de 4 à 7 lettres, 2 au-delà. Si plusieurs mots-clés de sens différents sont à la même distance,
+ * le mot n'est pas corrigé. Les mots courants (mots_courants) ne sont jamais corrigés.
+ * Seuls les mots-clés qui partagent une variante avec le mot (variantesMot) sont comparés : le coût d'une
+ * recherche dépend de la longueur du mot, pas de la taille du vocabulaire.
+ * @param mot Début du mot (pas forcément terminé par '\0'), en UTF-8. La casse et les accents sont ignorés.
+ * @param longueur Nombre d'octets du mot.
+ * @param langues Masque des langues acceptées.
+ * @return L'entrée du lexique la plus proche, NULL si aucune n'est assez proche.
+ */
+const EntreeLexique *lexique_chercherApproche(const char *mot, size_t longueur, int langues) {
+    char cle[2 * LONGUEUR_CLE_MAX];
+    const char *courant = cle;
+    const EntreeLexique *trouvee = NULL;
+    bool ambigu = false;
+    uint32_t empreintes[VARIANTES_MAX];
+    pthread_once(&index_initialise, construireIndex);
+
+    if (longueur > sizeof(cle)) {
+        return NULL;
+    }
+    longueur = normaliser_texte(mot, longueur, cle);
+    if (longueur < LONGUEUR_APPROCHE_MIN || longueur >= LONGUEUR_CLE_MAX) {
+        return NULL;
+    }
+    cle[longueur] = '\0';
+    if (bsearch(&courant, mots_courants, NB_MOTS_COURANTS, sizeof(mots_courants[0]), comparerMots) != NULL) {
+        return NULL;
+    }
+    int tolerance = (longueur < LONGUEUR_TOLERANCE_2) ? 1 : 2;
+    uint32_t lettres = lettresMot(cle, longueur);
+    int nb_variantes = variantesMot(cle, longueur, tolerance, empreintes);
+
+    for (int v = 0; v < nb_variantes; v++) {
+        for (uint32_t h = empreintes[v] & (TAILLE_VARIANTES - 1); index_variantes[h].mot >= 0; h = (h + 1) & (TAILLE_VARIANTES - 1)) {
+            if (index_variantes[h].empreinte != empreintes[v]) {
+                continue;
+            }
+            const MotApproche *m = &mots_approche[index_variantes[h].mot];
+            if (!(m->entree->langues & langues) || (__builtin_popcount(lettres ^ m->lettres) + 1) / 2 > tolerance) {
+                continue;
+            }
+            int d = distanceBornee(cle, longueur, m->cle, strlen(m->cle), tolerance);
+            if (d > tolerance) {
+                continue;
+            }
+            if (d < tolerance) {    //Plus proche que tout ce qui a été trouvé : seuls les mots à cette distance comptent.
+                tolerance = d;
+                trouvee = NULL;
+                ambigu = false;
+            }
+            if (trouvee == NULL) {
+                trouvee = m->entree;
+            } else if (trouvee->categorie != m->entree->categorie || trouvee->code != m->entree->code) {
+                ambigu = true;
+            }
+        }
+    }
+    return ambigu ? NULL : trouvee;
+}
+
+/**
+ * @brief Donne le mot qui désigne un code du lexique dans une langue, pour afficher une action.
+ * C'est le premier mot de la table de la langue ayant cette catégorie, ce code et ce nombre.
+ * @param categorie Catégorie du code (CAT_VERBE, CAT_OBJET, CAT_COULEUR, CAT_DIRECTION).
+ * @param code Code dans la catégorie (CodeVerbe, CodeObjet...).
+ * @param langue Langue du mot (LANGUE_FR ou LANGUE_ES).
+ * @param pluriel Forme au pluriel (objets et couleurs).
+ * @return Le mot, NULL si aucun mot de la langue ne correspond.
+ */
+const char *lexique_nom(Categorie categorie, int code, int langue, bool pluriel) {
+    for (size_t v = 0; v < NB_VOCABULAIRES; v++) {
+        for (size_t i = 0; i < vocabulaires[v].nb_mots; i++) {
+            const EntreeLexique *e = &vocabulaires[v].mots[i];
+            if (e->categorie == categorie && e->code == code && (e->langues & langue) && e->pluriel == pluriel) {
+                return e->mot;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Indique si une entrée (éventuellement NULL) appartient à une catégorie.
+ */
+bool lexique_est(const EntreeLexique *entree, Categorie categorie) {
+    return entree != NULL && entree->categorie == categorie;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,104 @@
+/**
+ * @file
+ * @brief Ce fichier contient les déclarations du lexique de mots-clés utilisé par le traitement de texte.
+ * Chaque mot-clé connu (verbe, objet, couleur, direction, unité, connecteur...) est associé en une seule
+ * recherche à sa catégorie, aux langues dans lesquelles il existe et à sa forme canonique (lemme).
+ */
+
+#ifndef LEXIQUE_H
+#define LEXIQUE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Langues reconnues, utilisables comme masque de bits.
+ */
+typedef enum {
+    LANGUE_FR = 1,
+    LANGUE_ES = 2,
+    LANGUE_TOUTES = LANGUE_FR | LANGUE_ES
+} Langue;
+
+/**
+ * @brief Catégorie grammaticale d'un mot-clé.
+ */
+typedef enum {
+    CAT_AUCUNE = 0,
+    CAT_VERBE,          /**< avancer, gira... (code : CodeVerbe) */
+    CAT_OBJET,          /**< boule, pelota... (code : CodeObjet) */
+    CAT_COULEUR,        /**< bleu, azul... (code : CodeCouleur) */
+    CAT_DIRECTION,      /**< gauche, derecha... (code : CodeDirection) */
+    CAT_UNITE_DISTANCE, /**< mètres, metros... (valeur : facteur vers les mètres) */
+    CAT_UNITE_ANGLE,    /**< degrés, grados... */
+    CAT_SEPARATEUR,     /**< puis, luego : fin de sous-phrase */
+    CAT_ENTRE,          /**< entre */
+    CAT_ET,             /**< et, y */
+    CAT_OU,             /**< ou, o */
+    CAT_NEGATION,       /**< ne, n, no */
+    CAT_NOMBRE          /**< deux, cien... (valeur : valeur du mot, code : CodeNombre) */
+} Categorie;
+
+typedef enum {
+    VERBE_AUCUN = 0,
+    VERBE_AVANCER,
+    VERBE_RECULER,
+    VERBE_TOURNER,
+    VERBE_LOCALISER,
+    VERBE_CONTOURNER,
+    VERBE_PASSER,
+    VERBE_COMPTER
+} CodeVerbe;
+
+typedef enum {
+    OBJET_AUCUN = 0,
+    OBJET_CUBE,
+    OBJET_BOULE,
+    OBJET_OBJET,
+    OBJET_OBSTACLE
+} CodeObjet;
+
+typedef enum {
+    COULEUR_AUCUNE = 0,
+    COULEUR_ROUGE,
+    COULEUR_BLEU,
+    COULEUR_JAUNE,
+    COULEUR_ORANGE
+} CodeCouleur;
+
+typedef enum {
+    DIRECTION_AUCUNE = 0,
+    DIRECTION_GAUCHE,
+    DIRECTION_DROITE
+} CodeDirection;
+
+/**
+ * @brief Rôle d'un mot-nombre dans un nombre composé.
+ */
+typedef enum {
+    NOMBRE_SIMPLE = 0,  /**< S'ajoute au nombre en cours. */
+    NOMBRE_VINGT,       /**< "vingt" : multiplie l'unité qui le précède ("quatre vingt"). */
+    NOMBRE_CENT,        /**< Multiplie les unités en cours ("deux cent"). */
+    NOMBRE_MILLE        /**< Multiplie tout le nombre en cours ("trois mille"). */
+} CodeNombre;
+
+/**
+ * @brief Entrée du lexique.
+ */
+typedef struct {
+    const char *mot;         /**< Forme écrite dans les ActionData. La recherche ignore sa casse et ses accents. */
+    unsigned char categorie; /**< Categorie du mot. */
+    unsigned char langues;   /**< Masque des langues (Langue) dans lesquelles le mot existe. */
+    unsigned char pluriel;   /**< 1 pour les objets et couleurs au pluriel. */
+    int code;                /**< Code propre à la catégorie (CodeVerbe, CodeObjet...). */
+    const char *lemme;       /**< Forme canonique du mot. */
+    double valeur;           /**< Valeur numérique associée (facteur d'une unité, valeur d'un nombre). */
+} EntreeLexique;
+
+const EntreeLexique *lexique_chercher(const char *mot, size_t longueur, int langues);
+const EntreeLexique *lexique_chercherLangues(const char *mot, size_t longueur, int langues, int *langues_mot);
+const EntreeLexique *lexique_chercherApproche(const char *mot, size_t longueur, int langues);
+const char *lexique_nom(Categorie categorie, int code, int langue, bool pluriel);
+bool lexique_est(const EntreeLexique *entree, Categorie categorie);
+
+#endif
@@ -4,10 +4,16 @@
 #include <string.h>
 #include <ctype.h>
 #include <unistd.h>
+#include <glob.h>
 
 #include "traitementImage.h"
 #include "traitementTexte.h"
 #include "traitementCommande.h"
+#include "traitementLot.h"
+#include "simulation.h"
+#include "rendu.h"
+#include "planification.h"
+#include "trajectoire.h"
 
 
 /**
@@ -24,7 +30,20 @@
  * @section usage Usage
  * - Inclure les headers "traitementImage.h", "traitementTexte.h" et "traitementCommande.h" dans votre projet.
  * - Utiliser les differentes fonctions de traitement.
+ * - Ou lier la bibliothèque libmobot (libmobot.a ou libmobot.so, interface mobot.h), qui n'écrit rien sur le terminal.
  * - Avoir un sous dossier "images" avec les images .txt .jpeg et .gif 
+ * - "./main --lot phrases.tsv --sortie actions.jsonl" analyse un fichier de phrases "langue<TAB>phrase" sur tous les coeurs.
+ * - "./main --flux" affiche chaque action dès que sa sous-phrase est dictée, sans attendre la fin de la phrase.
+ * - "./main --simuler" exécute chaque phrase de l'entrée standard dans la pièce vide, sans Python, et affiche la position finale du robot.
+ * - "./main --simuler --image images/IMG_5389.txt --rendu sorties/essai" fait de même dans la scène de l'image, et dessine chaque trajectoire dans sorties/essai_<n>.png.
+ * - Avec "--obstacles", les boules arrêtent le robot au lieu d'être traversées.
+ * - Avec "--planifier", le robot contourne les autres boules pour aller vers une boule ou autour d'elle, comme dans la modélisation.
+ * - Avec "--journal essai.traj", chaque simulation est enregistrée dans un journal de trajectoire que "./rejeu essai.traj" retrace, vérifie ou dessine.
+ *   "./main --journal essai.traj" enregistre de même chaque modélisation du menu.
+ * - Le robot avance à "--vitesse" unités/s et tourne à "--vitesse-angulaire" degrés/s, par pas de "--pas" secondes. Avec "--temps-reel <facteur>", la simulation
+ *   attend le temps réel correspondant (2 : deux fois plus vite que le robot) ; 0, la valeur par défaut sans Python, l'exécute aussi vite que possible.
+ *   "./main --temps-reel 0" affiche de même les modélisations du menu sans attendre.
+ * - "./main --simuler-lot phrases.tsv --images images --tirages 100 --bruit-distance 0.02 --bruit-angle 1" simule chaque phrase dans la pièce vide et dans chaque image du dossier, sur tous les coeurs, et donne la dispersion des positions finales sous erreur d'odométrie.
  *
  * @section features Fonctionnalités
  * - Detection d'objets de couleurs orange,bleu ou jaune dans une image.
@@ -59,6 +78,69 @@
  * @endcode
  */
 
+/**
+ * @brief Affiche le compte rendu du traitement d'une image : ses caractéristiques, puis les boules détectées, leurs
+ * milieux et leurs rayons.
+ */
+static void afficherImage(const ResultatImage *r) {
+    const ObjetImage *objets[] = {&r->bleu, &r->jaune, &r->orange};
+    const char *noms[] = {"\x1B[34mBleu", "\x1B[33mJaune", "\x1B[38;5;208mOrange"};
+    bool aucun = !r->bleu.detecte && !r->jaune.detecte && !r->orange.detecte;
+
+    printf("\n\n");
+    printf("\x1B[1m---------------TRAITEMENT D'IMAGE--------------\x1B[0m\n\n");
+    printf("\x1B[4mCARACTERISTIQUES IMAGE:\x1B[0m\n\n");
+    printf("Largeur : %d\n", r->largeur);
+    printf("Hauteur : %d\n", r->hauteur);
+    printf("Nbcompo : %d\n", r->nbcompo);
+    printf("\n");
+
+    printf("\x1B[4mDETECTIONS DES OBJETS :\x1B[0m\n\n");
+    for (int c = 0; c < 3; c++) {
+        if (objets[c]->detecte) {
+            printf("Objet de couleur %s\x1B[0m détecté!\n", noms[c]);
+        }
+    }
+    if (aucun) {
+        printf("\x1B[31m\x1B[1mAucun objet détecté!\x1B[0m\n");
+    }
+
+    printf("\n\x1B[4mCALCULS DES MILIEUX :\x1B[0m\n\n");
+    for (int c = 0; c < 3; c++) {
+        if (objets[c]->detecte) {
+            printf("Le milieu de l'objet %s\x1B[0m est de coordonnées : [%d,%d]\n", noms[c], objets[c]->milieu[0], objets[c]->milieu[1]);
+        }
+    }
+    if (aucun) {
+        printf("\x1B[31m\x1B[1mCalcul des milieux impossible il n'y a pas d'objet!\x1B[0m\n");
+    }
+
+    printf("\n\x1B[4mRAYON DES OBJETS\x1B[0m\n\n");
+    for (int c = 0; c < 3; c++) {
+        if (objets[c]->detecte) {
+            printf("Le rayon de l'objet de couleur %s\x1B[0m est : %d\n", noms[c], objets[c]->rayon);
+        }
+    }
+    if (aucun) {
+        printf("\x1B[31m\x1B[1mCalcul des rayons impossible il n'y a pas d'objet!\x1B[0m\n");
+    }
+    printf("-----------------------------------------------\n\n");
+}
+
+/**
+ * @brief Traite une image pour le menu et affiche son compte rendu (afficherImage).
+ * @return false si l'image n'a pas pu être traitée ; le message d'erreur est affiché.
+ */
+static bool traiterImage(const char *nomfichier, ResultatImage *r) {
+    StatutImage statut = analyserImage(nomfichier, r);
+
+    if (statut != IMAGE_OK) {
+        printf("\x1B[31mErreur: %s n'est pas une image lisible.\x1B[0m\n", nomfichier);
+        return false;
+    }
+    afficherImage(r);
+    return true;
+}
 
 void main_img(){
     printf("\n\x1B[1m---------------CHARGEMENT DU FICHIER--------------\x1B[0m\n\n");
@@ -76,14 +158,13 @@ void main_img(){
         }
     }
 
-    int hauteur,largeur;
-    int rayon_bleu, rayon_jaune, rayon_orange;//-1 si pas de rayon
-    int *milieu_bleu, *milieu_jaune, *milieu_orange;//liste vide si existe pas
-    main_it(&hauteur, &largeur, &rayon_bleu, &rayon_jaune, &rayon_orange,&milieu_bleu, &milieu_jaune, &milieu_orange, nomfichier);
-
-    int *coin_HD = (int*)malloc(2 * sizeof(int));
-    coin_HD[0] = hauteur;
-    coin_HD[1] = largeur;
+    ResultatImage image;
+    if (!traiterImage(nomfichier, &image)) {
+        return;
+    }
+    int coin_HD[2] = {image.largeur, image.hauteur};
+    int *milieu_bleu = image.bleu.milieu, *milieu_jaune = image.jaune.milieu, *milieu_orange = image.orange.milieu;
+    int rayon_bleu = image.bleu.rayon, rayon_jaune = image.jaune.rayon, rayon_orange = image.orange.rayon;    //-1 si pas de rayon
 
     changementDeBase(coin_HD, milieu_bleu, milieu_jaune, milieu_orange);
    
@@ -107,11 +188,9 @@ void main_txt(){
 
     
     char phrase[1000];
-    char lang[3];
     Queue myQueue = createQueue();
-    char *mat[5][4];
-    int mat_compt = 0;
-    int i,j;
+    ActionData *actions;
+    int nb_actions = 0;
     
     int *coin_HD = (int*)malloc(2 * sizeof(int));
     coin_HD[0] = 150;
@@ -121,51 +200,28 @@ void main_txt(){
     while ((b = getchar()) != '\n' && b != EOF) { }
 
     printf("\x1B[1m---------------TRAITEMENT DE TEXTE--------------\x1B[0m\n\n");
-    printf("\x1B[4mCHOIX DE LA LANGUE:\x1B[0m\n\n");
-
-    printf("Choisissez la langue avec laquelle gérer la phrase.\nEntrez 'es' pour espagnol et 'fr' pour français : ");
-    fgets(lang, sizeof(lang), stdin); // Lee la elección del idioma, incluyendo '\n'
-
-    // Limpia el buffer de entrada si es necesario
-    if (strlen(lang) == 2 && lang[1] != '\n') {
-        int c;
-        while ((c = getchar()) != '\n' && c != EOF) { }
-    }
-
-    printf("\n");
     printf("\x1B[4mPHRASE A TRAITER:\x1B[0m\n\n");
-    printf("Ecrivez la phrase à traiter:\n");
+    printf("Ecrivez la phrase à traiter, en français ou en espagnol:\n");
     fgets(phrase, sizeof(phrase), stdin);
     phrase[strcspn(phrase, "\n")] = 0; // Remueve el salto de línea al final
 
-    if (strcmp(lang, "es") == 0) {
-        afficher_Action_es(phrase, &myQueue); // Procesa y encola las subfrases
-    } else if (strcmp(lang, "fr") == 0) {
-        afficher_Action_fr(phrase, &myQueue);
-    }
+    const Grammaire *langue = analyserPhrase(&GRAMMAIRE_AUTO, phrase, &myQueue); // Detecta el idioma, procesa y encola las subfrases
+    printf("\nLangue détectée : %s\n", langue == &GRAMMAIRE_ES ? "espagnol" : "français");
 
     printf("\n");
     printf("\x1B[4mSEPARATION EN MOTS-CLES:\x1B[0m\n");
-    while (!isQueueEmpty(myQueue) && mat_compt < 5) {
+    actions = malloc(myQueue.size * sizeof(ActionData));
+    while (!isQueueEmpty(&myQueue)) {
         ActionData action = dequeue(&myQueue);
+        ActionTexte texte;
+        action_versTexte(&action, &texte);
         printf("\nAction: %s\nParametre 1: %s\nParametre 2: %s\nType de phrase: %s\n",
-               action.action, action.param1, action.param2, action.type);
-        mat[mat_compt][0] = strdup(action.action);
-        mat[mat_compt][1] = strdup(action.param1);
-        mat[mat_compt][2] = strdup(action.param2);
-        mat[mat_compt][3] = strdup(action.type);
-        mat_compt++;
+               texte.action, texte.param1, texte.param2, texte.type);
+        actions[nb_actions++] = action;
     }
+    destroyQueue(&myQueue);
     printf("\n");
 
-/*
-    for(i = 0; i < mat_compt; i++) {
-        for(j = 0; j < 4; j++) {
-            printf("\t%s\t", mat[i][j]);
-        }
-        printf("\n");
-    }   
-*/
 
     printf("-----------------------------------------------\n\n");
 
@@ -174,7 +230,8 @@ void main_txt(){
     }
     printf("\n");
 
-   modeliserActions(nomfichier,mat,mat_compt, coin_HD, rayon_bleu, rayon_jaune, rayon_orange, milieu_bleu, milieu_jaune, milieu_orange);
+    modeliserActions(nomfichier, actions, nb_actions, coin_HD, rayon_bleu, rayon_jaune, rayon_orange, milieu_bleu, milieu_jaune, milieu_orange);
+    free(actions);
 
 }
 
@@ -196,21 +253,18 @@ void main_imgtxt(){
         }
     }
 
-    int hauteur,largeur;
-    int rayon_bleu, rayon_jaune, rayon_orange;//-1 si pas de rayon
-    int *milieu_bleu, *milieu_jaune, *milieu_orange;//liste vide si existe pas
-    main_it(&hauteur, &largeur, &rayon_bleu, &rayon_jaune, &rayon_orange,&milieu_bleu, &milieu_jaune, &milieu_orange, nomfichier);
-
-    int *coin_HD = (int*)malloc(2 * sizeof(int));
-    coin_HD[0] = hauteur;
-    coin_HD[1] = largeur;
+    ResultatImage image;
+    if (!traiterImage(nomfichier, &image)) {
+        return;
+    }
+    int coin_HD[2] = {image.largeur, image.hauteur};
+    int *milieu_bleu = image.bleu.milieu, *milieu_jaune = image.jaune.milieu, *milieu_orange = image.orange.milieu;
+    int rayon_bleu = image.bleu.rayon, rayon_jaune = image.jaune.rayon, rayon_orange = image.orange.rayon;    //-1 si pas de rayon
 
     char phrase[1000];
-    char lang[3];
     Queue myQueue = createQueue();
-    char *mat[5][4];
-    int mat_compt = 0;
-    int i,j;
+    ActionData *actions;
+    int nb_actions = 0;
     char boucle ='\0';
 
     changementDeBase(coin_HD, milieu_bleu,  milieu_jaune,  milieu_orange);
@@ -229,56 +283,28 @@ void main_imgtxt(){
     printf("\n\n");
 
     printf("\x1B[1m---------------TRAITEMENT DE TEXTE--------------\x1B[0m\n\n");
-    printf("\x1B[4mCHOIX DE LA LANGUE:\x1B[0m\n\n");
-
-
-
-   printf("Choisissez la langue avec laquelle gérer la phrase.\nEntrez 'es' pour espagnol et 'fr' pour français : ");
-    fgets(lang, sizeof(lang), stdin); // Lee la elección del idioma, incluyendo '\n'
-
-    // Limpia el buffer de entrada si es necesario
-    if (strlen(lang) == 2 && lang[1] != '\n') {
-        int c;
-        while ((c = getchar()) != '\n' && c != EOF) { }
-    }
-
-    printf("\n");
     printf("\x1B[4mPHRASE A TRAITER:\x1B[0m\n\n");
-    printf("Ecrivez la phrase à traiter:\n");
+    printf("Ecrivez la phrase à traiter, en français ou en espagnol:\n");
     fgets(phrase, sizeof(phrase), stdin);
     phrase[strcspn(phrase, "\n")] = 0; // Remueve el salto de línea al final
 
-    if (strcmp(lang, "es") == 0) {
-        afficher_Action_es(phrase, &myQueue); // Procesa y encola las subfrases
-    } else if (strcmp(lang, "fr") == 0) {
-        afficher_Action_fr(phrase, &myQueue);
-    }
+    const Grammaire *langue = analyserPhrase(&GRAMMAIRE_AUTO, phrase, &myQueue); // Detecta el idioma, procesa y encola las subfrases
+    printf("\nLangue détectée : %s\n", langue == &GRAMMAIRE_ES ? "espagnol" : "français");
 
     printf("\n");
     printf("\x1B[4mSEPARATION EN MOTS-CLES:\x1B[0m\n");
-    while (!isQueueEmpty(myQueue) && mat_compt < 5) {
+    actions = malloc(myQueue.size * sizeof(ActionData));
+    while (!isQueueEmpty(&myQueue)) {
         ActionData action = dequeue(&myQueue);
+        ActionTexte texte;
+        action_versTexte(&action, &texte);
         printf("\nAction: %s\nParametre 1: %s\nParametre 2: %s\nType de phrase: %s\n",
-               action.action, action.param1, action.param2, action.type);
-        mat[mat_compt][0] = strdup(action.action);
-        mat[mat_compt][1] = strdup(action.param1);
-        mat[mat_compt][2] = strdup(action.param2);
-        mat[mat_compt][3] = strdup(action.type);
-        mat_compt++;
+               texte.action, texte.param1, texte.param2, texte.type);
+        actions[nb_actions++] = action;
     }
+    destroyQueue(&myQueue);
     printf("\n");
 
-
-    /*
-    for(i = 0; i < mat_compt; i++) {
-        for(j = 0; j < 4; j++) {
-            printf("\t%s\t", mat[i][j]);
-        }
-        printf("\n");
-    }   
-    */
-
-
     printf("-----------------------------------------------\n\n");
 
     printf("Appuyez sur la touche 'Entrée' pour continuer...");
@@ -286,37 +312,430 @@ void main_imgtxt(){
     }
     printf("\n");
 
-    modeliserActions(nomfichier,mat,mat_compt, coin_HD, rayon_bleu, rayon_jaune, rayon_orange, milieu_bleu, milieu_jaune, milieu_orange);
+    modeliserActions(nomfichier, actions, nb_actions, coin_HD, rayon_bleu, rayon_jaune, rayon_orange, milieu_bleu, milieu_jaune, milieu_orange);
+    free(actions);
 
 }
 
+/**
+ * @brief Affiche et défile les actions de la file, une par ligne.
+ */
+static void afficherActions(Queue *q) {
+    while (!isQueueEmpty(q)) {
+        ActionData action = dequeue(q);
+        ActionTexte texte;
+        action_versTexte(&action, &texte);
+        printf("Action: %s | Parametre 1: %s | Parametre 2: %s | Type de phrase: %s\n",
+               texte.action, texte.param1, texte.param2, texte.type);
+    }
+    fflush(stdout);
+}
 
-int main() {
-    printf("\n\x1B[1m---------------BIENVENUE DANS LE MENU PRINCIPAL--------------\x1B[0m\n\n");
+/**
+ * @brief Analyse l'entrée standard au fil de l'eau : chaque action est affichée dès que sa sous-phrase est
+ * terminée, sans attendre la fin de la phrase. Chaque ligne est une phrase.
+ * @param g Grammaire de la langue des phrases, ou GRAMMAIRE_AUTO.
+ */
+int main_flux(const Grammaire *g) {
+    char tampon[4096];
+    ssize_t lus;
+    Queue q = createQueue();
+    AnalyseurFlux *flux = analyseurFlux_creer(g, &q);
+    bool phrase_en_cours = false;
+
+    if (flux == NULL) {
+        return 1;
+    }
+    while ((lus = read(STDIN_FILENO, tampon, sizeof(tampon))) > 0) {
+        const char *debut = tampon, *fin = tampon + lus;
+        while (debut < fin) {
+            const char *ligne = memchr(debut, '\n', (size_t) (fin - debut));
+            const char *bout = (ligne != NULL) ? ligne : fin;
+            analyseurFlux_ajouter(flux, debut, (size_t) (bout - debut));
+            phrase_en_cours = true;
+            if (ligne != NULL) {
+                analyseurFlux_terminer(flux);
+                phrase_en_cours = false;
+                bout++;
+            }
+            debut = bout;
+            afficherActions(&q);
+        }
+    }
+    if (phrase_en_cours) {
+        analyseurFlux_terminer(flux);
+        afficherActions(&q);
+    }
+    analyseurFlux_detruire(flux);
+    destroyQueue(&q);
+    return 0;
+}
+
+/**
+ * @brief Construit la scène d'une image comme main_imgtxt, sans rien afficher : détection des boules
+ * (analyserImage) et changement de base (scene_depuisImage).
+ * @return false si l'image n'a pas pu être traitée ; la cause est écrite sur la sortie d'erreur.
+ */
+static bool sceneImage(const char *nomfichier, Scene *scene) {
+    ResultatImage image;
+    StatutImage statut = analyserImage(nomfichier, &image);
+
+    if (statut != IMAGE_OK) {
+        fprintf(stderr, "Erreur: %s %s.\n", nomfichier, statut == IMAGE_ERREUR_FICHIER ? "n'existe pas"
+                : statut == IMAGE_ERREUR_FORMAT ? "n'est pas une image .txt valide" : ": mémoire insuffisante");
+        return false;
+    }
+    scene_depuisImage(scene, &image);
+    return true;
+}
+
+/**
+ * @brief Simule chaque phrase de l'entrée standard (une par ligne) sans Python Turtle, et affiche la position
+ * finale du robot : "x y cap".
+ * @param g Grammaire de la langue des phrases, ou GRAMMAIRE_AUTO.
+ * @param nomfichier Image .txt de la scène (son .gif sert de fond), ou NULL pour la pièce vide de main_txt.
+ * @param rendu Si non NULL, la scène et la trajectoire de la phrase n sont écrites dans "<rendu>_<n>.png".
+ * @param ppm true pour écrire les rendus en PPM plutôt qu'en PNG.
+ * @param obstacles true pour arrêter le robot devant les boules ; le nombre de déplacements arrêtés est alors
+ * affiché après la position : "x y cap collisions".
+ * @param planifier true pour contourner les autres boules en allant vers une boule ou autour d'elle, comme la
+ * modélisation (planifierCommandes).
+ * @param fichier_journal Si non NULL, chaque simulation est enregistrée dans ce journal de trajectoire (rejeu).
+ * @param horloge Pas et vitesses des mouvements ; avec un facteur de temps réel non nul, chaque simulation dure
+ * son temps simulé divisé par ce facteur.
+ */
+int main_simulation(const Grammaire *g, char *nomfichier, const char *rendu, bool ppm, bool obstacles, bool planifier, const char *fichier_journal, const ParametresHorloge *horloge) {
+    const int coin_HD[2] = {150, 150};
+    char *ligne = NULL;
+    size_t taille = 0;
+    Queue q = createQueue();
+    Scene scene;
+    Simulation sim;
+    Carte carte;
+    Planificateur pl;
+    JournalTrajectoire journal;
+    FILE *f_journal = NULL;
+    Image fond = {0}, decor = {0}, image = {0};
+    ActionData *actions = NULL;
+    Commande *commandes = NULL, *planifiees = NULL;
+    int capacite = 0, numero = 0, erreur = 0;
+
+    if (nomfichier == NULL) {
+        scene_initialiser(&scene, coin_HD, -1, -1, -1, NULL, NULL, NULL);
+    } else if (!sceneImage(nomfichier, &scene)) {
+        return 1;
+    } else if (rendu != NULL) {
+        //Fond : l'image .gif de même nom, comme dans initialisation de modelisation.py.
+        char gif[1024];
+        snprintf(gif, sizeof(gif), "%s", nomfichier);
+        char *extension = strstr(gif, "txt");
+        if (extension != NULL) {
+            memcpy(extension, "gif", 3);
+        }
+        image_chargerGif(&fond, gif);
+    }
+    if ((rendu != NULL && !rendu_scene(&decor, &fond, &scene)) || (obstacles && !simulation_construireCarte(&carte, &scene))) {
+        fprintf(stderr, "Erreur: mémoire insuffisante.\n");
+        return 1;
+    }
+    if (planifier) {
+        planificateur_initialiser(&pl, &scene);
+    }
+    journal_initialiser(&journal);
+    if (fichier_journal != NULL && (f_journal = fopen(fichier_journal, "wb")) == NULL) {
+        perror(fichier_journal);
+        return 1;
+    }
+
+    while (getline(&ligne, &taille, stdin) != -1) {
+        int nb_actions = 0, nb_commandes;
+        ligne[strcspn(ligne, "\n")] = '\0';
+        analyserPhrase(g, ligne, &q);
+        if (q.size > capacite) {
+            capacite = q.size;
+            actions = realloc(actions, (size_t) capacite * sizeof(ActionData));
+            commandes = realloc(commandes, (size_t) capacite * COMMANDES_PAR_ACTION * sizeof(Commande));
+            planifiees = realloc(planifiees, (size_t) capacite * COMMANDES_PAR_ACTION * COMMANDES_PAR_PLANIFICATION * sizeof(Commande));
+            if (actions == NULL || commandes == NULL || planifiees == NULL) {
+                fprintf(stderr, "Erreur: mémoire insuffisante.\n");
+                return 1;
+            }
+        }
+        while (!isQueueEmpty(&q)) {
+            actions[nb_actions++] = dequeue(&q);
+        }
+        nb_commandes = traduireActions(&scene, actions, nb_actions, commandes);
+        if (planifier) {
+            nb_commandes = planifierCommandes(&pl, commandes, nb_commandes, planifiees);
+        }
+        simulation_initialiser(&sim, &scene);
+        simulation_horloge(&sim, horloge);
+        if (obstacles) {
+            simulation_obstacles(&sim, &carte);
+        }
+        numero++;
+        if (f_journal != NULL) {
+            journal_commencer(&journal, &sim, numero, nomfichier != NULL ? nomfichier : "piece vide");
+            simulation_journaliser(&sim, &journal);
+        }
+        if (rendu != NULL && image_copier(&image, &decor)) {
+            char chemin[1024];
+            simulation_tracer(&sim, rendu_segment, &image);
+            simulation_executer(&sim, planifier ? planifiees : commandes, nb_commandes);
+            rendu_robot(&image, &sim.pose);
+            snprintf(chemin, sizeof(chemin), "%s_%d.%s", rendu, numero, ppm ? "ppm" : "png");
+            if (!(ppm ? image_ecrirePpm(&image, chemin) : image_ecrirePng(&image, chemin))) {
+                erreur = 1;
+            }
+        } else {
+            simulation_executer(&sim, planifier ? planifiees : commandes, nb_commandes);
+        }
+        if (f_journal != NULL) {
+            journal_terminer(&journal, &sim);
+            if (!journal_ecrire(&journal, f_journal)) {
+                erreur = 1;
+            }
+        }
+        if (obstacles) {
+            printf("%.17g %.17g %.17g %d\n", sim.pose.x, sim.pose.y, simulation_cap(&sim), sim.collisions);
+        } else {
+            printf("%.17g %.17g %.17g\n", sim.pose.x, sim.pose.y, simulation_cap(&sim));
+        }
+    }
+    free(ligne);
+    free(actions);
+    free(commandes);
+    free(planifiees);
+    image_detruire(&fond);
+    image_detruire(&decor);
+    image_detruire(&image);
+    journal_detruire(&journal);
+    if (f_journal != NULL && fclose(f_journal) != 0) {
+        erreur = 1;
+    }
+    if (obstacles) {
+        carte_detruire(&carte);
+    }
+    destroyQueue(&q);
+    return erreur;
+}
+
+/**
+ * @brief Simule un fichier de phrases dans la pièce vide de main_txt et dans chaque image .txt d'un dossier
+ * (simulerLot).
+ * @param dossier Dossier des images, NULL pour la pièce vide seule.
+ */
+int main_simulationLot(const char *entree, const char *sortie, const char *dossier, const OptionsSimulationLot *options, int nb_threads) {
+    const int coin_HD[2] = {150, 150};
+    glob_t images = {0};
+    Scene *scenes;
+    const char **noms;
+    int nb_scenes = 1, resultat = 1;
+
+    if (dossier != NULL) {
+        char motif[1024];
+        snprintf(motif, sizeof(motif), "%s/*.txt", dossier);
+        if (glob(motif, 0, NULL, &images) != 0) {
+            fprintf(stderr, "Erreur: aucune image .txt dans %s.\n", dossier);
+            return 1;
+        }
+    }
+    scenes = malloc((images.gl_pathc + 1) * sizeof(Scene));
+    noms = malloc((images.gl_pathc + 1) * sizeof(char *));
+    if (scenes != NULL && noms != NULL) {
+        scene_initialiser(&scenes[0], coin_HD, -1, -1, -1, NULL, NULL, NULL);
+        noms[0] = "piece vide";
+        for (size_t i = 0; i < images.gl_pathc; i++) {
+            if (sceneImage(images.gl_pathv[i], &scenes[nb_scenes])) {
+                noms[nb_scenes++] = images.gl_pathv[i];
+            }
+        }
+        resultat = simulerLot(entree, sortie, scenes, noms, nb_scenes, options, nb_threads);
+    }
+    free(scenes);
+    free(noms);
+    if (dossier != NULL) {
+        globfree(&images);
+    }
+    return resultat;
+}
+
+/**
+ * @brief Menu interactif : propose les modélisations jusqu'à ce que l'utilisateur quitte ou que l'entrée standard
+ * soit fermée.
+ */
+void main_menu() {
     char choix;
 
-    do {
-        printf("Veuillez entrer le chiffre correspondant à l'action souhaitée: \n\n1- Modéliser une image.\n2- Se déplacer dans une pièce vide.\n3- Modéliser une image puis se déplacer dedans.\n4- Quitter ce programme.\n\n");
-        scanf(" %c", &choix);
-
-        switch (choix) {
-            case '1':
-                main_img();
-                break;
-            case '2':
-                main_txt();
-                break;
-            case '3':
-                main_imgtxt();
-                break;
-            case '4':
-                return 0;
-            default:
-                printf("Choix non valide.\n");
-                printf("-----------------------------------------------\n\n");
+    while (true) {
+        printf("\n\x1B[1m---------------BIENVENUE DANS LE MENU PRINCIPAL--------------\x1B[0m\n\n");
+        do {
+            printf("Veuillez entrer le chiffre correspondant à l'action souhaitée: \n\n1- Modéliser une image.\n2- Se déplacer dans une pièce vide.\n3- Modéliser une image puis se déplacer dedans.\n4- Quitter ce programme.\n\n");
+            if (scanf(" %c", &choix) != 1) {
+                return;
+            }
+
+            switch (choix) {
+                case '1':
+                    main_img();
+                    break;
+                case '2':
+                    main_txt();
+                    break;
+                case '3':
+                    main_imgtxt();
+                    break;
+                case '4':
+                    return;
+                default:
+                    printf("Choix non valide.\n");
+                    printf("-----------------------------------------------\n\n");
+            }
+        } while (choix < '1' || choix > '4');
+    }
+}
+
+/**
+ * @brief Lit une option d'horloge : "--pas <s>", "--vitesse <unités/s>", "--vitesse-angulaire <degrés/s>" ou
+ * "--temps-reel <facteur>" (0 : aussi vite que possible).
+ * @return true si l'option est une option d'horloge.
+ */
+static bool optionHorloge(const char *option, const char *valeur, ParametresHorloge *horloge) {
+    double v = atof(valeur);
+    double *champ = (strcmp(option, "--pas") == 0) ? &horloge->pas
+                  : (strcmp(option, "--vitesse") == 0) ? &horloge->vitesse_lineaire
+                  : (strcmp(option, "--vitesse-angulaire") == 0) ? &horloge->vitesse_angulaire
+                  : (strcmp(option, "--temps-reel") == 0) ? &horloge->facteur : NULL;
+
+    if (champ == NULL) {
+        return false;
+    }
+    if (v > 0.0 || (champ == &horloge->facteur && v == 0.0)) {
+        *champ = v;
+    } else {
+        fprintf(stderr, "Attention: %s %s ignoré, la valeur doit être positive.\n", option, valeur);
+    }
+    return true;
+}
+
+/**
+ * @brief Sans argument, lance le menu interactif ; les options d'horloge (optionHorloge) y règlent les mouvements
+ * de la modélisation, en temps réel par défaut, et "--journal <fichier>" enregistre chaque modélisation dans un journal
+ * de trajectoire.
+ * Avec "--lot <entree> [--sortie <fichier>] [--threads <n>] [--cache <n>]", analyse un fichier de phrases sans interaction.
+ * Avec "--flux [fr|es|auto]", analyse l'entrée standard au fil de l'eau (main_flux).
+ * Avec "--simuler [fr|es|auto] [--image <fichier.txt>] [--rendu <prefixe>] [--ppm] [--obstacles] [--planifier] [--journal <fichier>]
+ * [options d'horloge]", simule les phrases de l'entrée standard sans Python (main_simulation), aussi vite que possible par défaut.
+ * Avec "--simuler-lot <entree> [--images <dossier>] [--sortie <fichier>] [--threads <n>] [--tirages <n>] [--bruit-distance <s>]
+ * [--bruit-angle <s>] [--graine <n>] [--obstacles] [--planifier] [--journal <fichier>] [options d'horloge]", simule un fichier de phrases dans plusieurs scènes
+ * (main_simulationLot).
+ */
+int main(int argc, char *argv[]) {
+    ParametresHorloge horloge = {HORLOGE_PAS, HORLOGE_VITESSE_LINEAIRE, HORLOGE_VITESSE_ANGULAIRE, 0.0};
+
+    if (argc >= 3 && strcmp(argv[1], "--lot") == 0) {
+        const char *sortie = NULL;
+        int nb_threads = 0;
+        size_t taille_cache = 0;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "--sortie") == 0) {
+                sortie = argv[i + 1];
+            } else if (strcmp(argv[i], "--threads") == 0) {
+                nb_threads = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "--cache") == 0) {
+                taille_cache = (size_t) strtoul(argv[i + 1], NULL, 10);
+            }
+        }
+        return traiterLot(argv[2], sortie, nb_threads, taille_cache);
+    }
+    if (argc >= 2 && argc <= 3 && strcmp(argv[1], "--flux") == 0) {
+        const Grammaire *g = &GRAMMAIRE_AUTO;
+        if (argc == 3) {
+            g = (strcmp(argv[2], GRAMMAIRE_FR.code) == 0) ? &GRAMMAIRE_FR
+              : (strcmp(argv[2], GRAMMAIRE_ES.code) == 0) ? &GRAMMAIRE_ES : &GRAMMAIRE_AUTO;
         }
-    } while (choix < '1' || choix > '4');
+        return main_flux(g);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--simuler") == 0) {
+        const Grammaire *g = &GRAMMAIRE_AUTO;
+        char *image = NULL;
+        const char *rendu = NULL;
+        const char *journal = NULL;
+        bool ppm = false, obstacles = false, planifier = false;
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "--image") == 0 && i + 1 < argc) {
+                image = argv[++i];
+            } else if (strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+                journal = argv[++i];
+            } else if (strcmp(argv[i], "--rendu") == 0 && i + 1 < argc) {
+                rendu = argv[++i];
+            } else if (strcmp(argv[i], "--ppm") == 0) {
+                ppm = true;
+            } else if (strcmp(argv[i], "--obstacles") == 0) {
+                obstacles = true;
+            } else if (strcmp(argv[i], "--planifier") == 0) {
+                planifier = true;
+            } else if (i + 1 < argc && optionHorloge(argv[i], argv[i + 1], &horloge)) {
+                i++;
+            } else {
+                g = (strcmp(argv[i], GRAMMAIRE_FR.code) == 0) ? &GRAMMAIRE_FR
+                  : (strcmp(argv[i], GRAMMAIRE_ES.code) == 0) ? &GRAMMAIRE_ES : &GRAMMAIRE_AUTO;
+            }
+        }
+        return main_simulation(g, image, rendu, ppm, obstacles, planifier, journal, &horloge);
+    }
+    if (argc >= 3 && strcmp(argv[1], "--simuler-lot") == 0) {
+        OptionsSimulationLot options = {0, 0.0, 0.0, 1, false, false, NULL, horloge};
+        const char *sortie = NULL, *dossier = NULL;
+        int nb_threads = 0;
+        for (int i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "--obstacles") == 0) {
+                options.obstacles = true;
+            } else if (strcmp(argv[i], "--planifier") == 0) {
+                options.planifier = true;
+            } else if (i + 1 < argc) {
+                if (strcmp(argv[i], "--images") == 0) {
+                    dossier = argv[i + 1];
+                } else if (strcmp(argv[i], "--sortie") == 0) {
+                    sortie = argv[i + 1];
+                } else if (strcmp(argv[i], "--threads") == 0) {
+                    nb_threads = atoi(argv[i + 1]);
+                } else if (strcmp(argv[i], "--tirages") == 0) {
+                    options.nb_tirages = atoi(argv[i + 1]);
+                } else if (strcmp(argv[i], "--bruit-distance") == 0) {
+                    options.bruit_distance = atof(argv[i + 1]);
+                } else if (strcmp(argv[i], "--bruit-angle") == 0) {
+                    options.bruit_angle = atof(argv[i + 1]);
+                } else if (strcmp(argv[i], "--journal") == 0) {
+                    options.fichier_journal = argv[i + 1];
+                } else if (strcmp(argv[i], "--graine") == 0) {
+                    options.graine = (unsigned int) strtoul(argv[i + 1], NULL, 10);
+                } else {
+                    optionHorloge(argv[i], argv[i + 1], &options.horloge);
+                }
+                i++;
+            }
+        }
+        return main_simulationLot(argv[2], sortie, dossier, &options, nb_threads);
+    }
+    horloge.facteur = 1.0;
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 < argc && strcmp(argv[i], "--journal") == 0) {
+            if (!modelisation_journal(argv[i + 1])) {
+                perror(argv[i + 1]);
+                return 1;
+            }
+        } else if (i + 1 == argc || !optionHorloge(argv[i], argv[i + 1], &horloge)) {
+            fprintf(stderr, "Usage : %s [--pas <s>] [--vitesse <unités/s>] [--vitesse-angulaire <degrés/s>] [--temps-reel <facteur>] [--journal <fichier>]\n", argv[0]);
+            fprintf(stderr, "        %s [--lot <entree> [--sortie <fichier>] [--threads <n>] [--cache <n>]] [--flux [fr|es|auto]] [--simuler [fr|es|auto] [--image <fichier.txt>] [--rendu <prefixe>] [--ppm] [--obstacles] [--planifier] [--journal <fichier>]] [--simuler-lot <entree> [--images <dossier>] [--sortie <fichier>] [--threads <n>] [--tirages <n>] [--bruit-distance <s>] [--bruit-angle <s>] [--graine <n>] [--obstacles] [--planifier] [--journal <fichier>]]\n", argv[0]);
+            fprintf(stderr, "Les options d'horloge s'appliquent aussi à --simuler et --simuler-lot, où --temps-reel vaut 0 par défaut.\n");
+            return 1;
+        }
+    }
+    modelisation_horloge(&horloge);
 
-    main();
+    main_menu();
+    modelisation_journal(NULL);
+    return 0;
 }
 
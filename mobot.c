@@ -0,0 +1,235 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include "mobot.h"
+
+/**
+ * @file
+ * @brief Ce fichier rassemble les fonctions de la bibliothèque libmobot : une interface sans entrée ni sortie sur
+ * le terminal aux traitements d'image, de texte et à la simulation.
+ */
+
+/**
+ * @defgroup bibliotheque Bibliothèque libmobot
+ * @brief Contexte, comptes rendus et résultats des traitements intégrables à un autre programme.
+ * @{
+ */
+
+/**
+ * @brief Etat propre à un utilisateur de la bibliothèque : sa fonction de journal, et les tampons réutilisés d'un
+ * appel à l'autre.
+ */
+struct ContexteMobot {
+    JournalMobot journal;       /**< NULL : aucun message. */
+    void *donnees;              /**< Passé à journal. */
+    Queue file;                 /**< Actions de la dernière phrase analysée. */
+    ActionData *actions;
+    Commande *commandes;        /**< COMMANDES_PAR_ACTION places par action. */
+    int capacite;               /**< Actions que peuvent contenir actions et commandes. */
+};
+
+/**
+ * @brief Crée un contexte, silencieux tant que mobot_journal n'a pas été appelé.
+ * @return Le contexte, NULL si la mémoire manque.
+ */
+ContexteMobot *mobot_creer(void) {
+    ContexteMobot *ctx = calloc(1, sizeof(ContexteMobot));
+
+    if (ctx != NULL) {
+        ctx->file = createQueue();
+    }
+    return ctx;
+}
+
+/**
+ * @brief Libère un contexte et les résultats qui lui appartiennent.
+ */
+void mobot_detruire(ContexteMobot *ctx) {
+    if (ctx == NULL) {
+        return;
+    }
+    destroyQueue(&ctx->file);
+    free(ctx->actions);
+    free(ctx->commandes);
+    free(ctx);
+}
+
+/**
+ * @brief Change la fonction de journal du contexte ; NULL rend le contexte silencieux.
+ */
+void mobot_journal(ContexteMobot *ctx, JournalMobot fonction, void *donnees) {
+    ctx->journal = fonction;
+    ctx->donnees = donnees;
+}
+
+/**
+ * @brief Texte d'un compte rendu.
+ */
+const char *mobot_message(StatutMobot statut) {
+    switch (statut) {
+        case MOBOT_OK:
+            return "succès";
+        case MOBOT_ERREUR_ARGUMENT:
+            return "paramètre invalide";
+        case MOBOT_ERREUR_FICHIER:
+            return "fichier introuvable ou illisible";
+        case MOBOT_ERREUR_FORMAT:
+            return "image .txt invalide";
+        case MOBOT_ERREUR_MEMOIRE:
+            return "mémoire insuffisante";
+        case MOBOT_ERREUR_LANGUE:
+            return "langue inconnue";
+    }
+    return "compte rendu inconnu";
+}
+
+/**
+ * @brief Envoie un message à la fonction de journal du contexte. Le message n'est formaté que si elle existe.
+ */
+static void journaliser(const ContexteMobot *ctx, NiveauMobot niveau, const char *format, ...) {
+    char message[512];
+    va_list arguments;
+
+    if (ctx->journal == NULL) {
+        return;
+    }
+    va_start(arguments, format);
+    vsnprintf(message, sizeof(message), format, arguments);
+    va_end(arguments);
+    ctx->journal(ctx->donnees, niveau, message);
+}
+
+/**
+ * @brief Détecte les boules bleue, jaune et orange d'une image .txt (analyserImage).
+ */
+StatutMobot mobot_analyserImage(ContexteMobot *ctx, const char *fichier, ResultatImage *resultat) {
+    static const StatutMobot statuts[] = {
+        [IMAGE_OK] = MOBOT_OK, [IMAGE_ERREUR_FICHIER] = MOBOT_ERREUR_FICHIER,
+        [IMAGE_ERREUR_FORMAT] = MOBOT_ERREUR_FORMAT, [IMAGE_ERREUR_MEMOIRE] = MOBOT_ERREUR_MEMOIRE
+    };
+    StatutMobot statut;
+
+    if (ctx == NULL || fichier == NULL || resultat == NULL) {
+        return MOBOT_ERREUR_ARGUMENT;
+    }
+    statut = statuts[analyserImage(fichier, resultat)];
+    if (statut != MOBOT_OK) {
+        journaliser(ctx, MOBOT_JOURNAL_ERREUR, "%s : %s", fichier, mobot_message(statut));
+    } else {
+        journaliser(ctx, MOBOT_JOURNAL_INFO, "%s : %dx%d, boules bleue %s, jaune %s, orange %s", fichier,
+                    resultat->largeur, resultat->hauteur, resultat->bleu.detecte ? "oui" : "non",
+                    resultat->jaune.detecte ? "oui" : "non", resultat->orange.detecte ? "oui" : "non");
+    }
+    return statut;
+}
+
+/**
+ * @brief Construit la scène d'une image .txt, dans la base de la modélisation (scene_depuisImage).
+ */
+StatutMobot mobot_sceneImage(ContexteMobot *ctx, const char *fichier, Scene *scene) {
+    ResultatImage image;
+    StatutMobot statut;
+
+    if (scene == NULL) {
+        return MOBOT_ERREUR_ARGUMENT;
+    }
+    statut = mobot_analyserImage(ctx, fichier, &image);
+    if (statut == MOBOT_OK) {
+        scene_depuisImage(scene, &image);
+    }
+    return statut;
+}
+
+/**
+ * @brief Analyse une phrase dans les tampons du contexte, qui grandissent avec le nombre d'actions.
+ * @param langue "fr", "es", ou "auto" (ou NULL) pour identifier la langue.
+ */
+static StatutMobot analyser(ContexteMobot *ctx, const char *langue, const char *phrase, ResultatPhrase *resultat) {
+    const Grammaire *g = (langue == NULL || strcmp(langue, "auto") == 0) ? &GRAMMAIRE_AUTO
+                       : (strcmp(langue, GRAMMAIRE_FR.code) == 0) ? &GRAMMAIRE_FR
+                       : (strcmp(langue, GRAMMAIRE_ES.code) == 0) ? &GRAMMAIRE_ES : NULL;
+    int nb_actions = 0;
+
+    if (g == NULL) {
+        journaliser(ctx, MOBOT_JOURNAL_ERREUR, "langue \"%s\" inconnue", langue);
+        return MOBOT_ERREUR_LANGUE;
+    }
+    resultat->langue = analyserPhrase(g, phrase, &ctx->file);
+    if (ctx->file.size > ctx->capacite) {
+        int capacite = ctx->file.size;
+        ActionData *actions = realloc(ctx->actions, (size_t) capacite * sizeof(ActionData));
+        if (actions != NULL) {
+            ctx->actions = actions;
+        }
+        Commande *commandes = realloc(ctx->commandes, (size_t) capacite * COMMANDES_PAR_ACTION * sizeof(Commande));
+        if (commandes != NULL) {
+            ctx->commandes = commandes;
+        }
+        if (actions == NULL || commandes == NULL) {
+            while (!isQueueEmpty(&ctx->file)) {
+                dequeue(&ctx->file);
+            }
+            journaliser(ctx, MOBOT_JOURNAL_ERREUR, "%s", mobot_message(MOBOT_ERREUR_MEMOIRE));
+            return MOBOT_ERREUR_MEMOIRE;
+        }
+        ctx->capacite = capacite;
+    }
+    while (!isQueueEmpty(&ctx->file)) {
+        ctx->actions[nb_actions++] = dequeue(&ctx->file);
+    }
+    resultat->actions = ctx->actions;
+    resultat->nb_actions = nb_actions;
+    journaliser(ctx, MOBOT_JOURNAL_INFO, "\"%s\" : %d action(s), langue %s", phrase, nb_actions, resultat->langue->code);
+    return MOBOT_OK;
+}
+
+/**
+ * @brief Découpe une phrase en actions (analyserPhrase).
+ * @param langue "fr", "es", ou "auto" (ou NULL) pour identifier la langue.
+ * @param resultat Reçoit la langue et les actions ; les actions restent valides jusqu'au prochain appel avec ce
+ * contexte.
+ */
+StatutMobot mobot_analyserPhrase(ContexteMobot *ctx, const char *langue, const char *phrase, ResultatPhrase *resultat) {
+    if (ctx == NULL || phrase == NULL || resultat == NULL) {
+        return MOBOT_ERREUR_ARGUMENT;
+    }
+    return analyser(ctx, langue, phrase, resultat);
+}
+
+/**
+ * @brief Exécute une phrase dans une scène avec le simulateur, sans Python, comme "./main --simuler".
+ * @param scene Scène de départ, NULL pour la pièce vide de main_txt.
+ * @param langue "fr", "es", ou "auto" (ou NULL) pour identifier la langue.
+ */
+StatutMobot mobot_simulerPhrase(ContexteMobot *ctx, const Scene *scene, const char *langue, const char *phrase, ResultatSimulation *resultat) {
+    const int coin_HD[2] = {150, 150};
+    ResultatPhrase analyse;
+    Scene vide;
+    Simulation sim;
+    StatutMobot statut;
+
+    if (ctx == NULL || phrase == NULL || resultat == NULL) {
+        return MOBOT_ERREUR_ARGUMENT;
+    }
+    statut = analyser(ctx, langue, phrase, &analyse);
+    if (statut != MOBOT_OK) {
+        return statut;
+    }
+    if (scene == NULL) {
+        scene_initialiser(&vide, coin_HD, -1, -1, -1, NULL, NULL, NULL);
+        scene = &vide;
+    }
+    resultat->nb_commandes = traduireActions(scene, analyse.actions, analyse.nb_actions, ctx->commandes);
+    simulation_initialiser(&sim, scene);
+    simulation_executer(&sim, ctx->commandes, resultat->nb_commandes);
+    resultat->pose = sim.pose;
+    resultat->cap = simulation_cap(&sim);
+    resultat->duree = sim.temps;
+    return MOBOT_OK;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @brief Ce fichier contient l'interface de la bibliothèque libmobot (libmobot.a, libmobot.so).
+ * Elle donne accès à la détection des boules dans une image, à l'analyse des phrases et à la simulation des
+ * déplacements du robot, pour les intégrer à un autre programme, par exemple un service qui reste lancé.
+ * - Aucune fonction n'écrit sur le terminal : les messages passent par une fonction de journal optionnelle.
+ * - Chaque fonction renvoie un StatutMobot, et ses résultats dans une structure.
+ * - Tout l'état est dans un contexte (ContexteMobot) : plusieurs threads peuvent travailler en même temps, chacun
+ *   avec son propre contexte.
+ *
+ * @code
+ * ContexteMobot *ctx = mobot_creer();
+ * ResultatPhrase phrase;
+ * if (ctx != NULL && mobot_analyserPhrase(ctx, "auto", "avance de 2 mètres puis tourne à droite", &phrase) == MOBOT_OK) {
+ *     for (int i = 0; i < phrase.nb_actions; i++) {
+ *         ...phrase.actions[i]...
+ *     }
+ * }
+ * mobot_detruire(ctx);
+ * @endcode
+ */
+
+#ifndef MOBOT_H
+#define MOBOT_H
+
+#include "traitementImage.h"
+#include "traitementTexte.h"
+#include "traitementCommande.h"
+#include "simulation.h"
+
+/**
+ * @brief Compte rendu des fonctions de la bibliothèque.
+ */
+typedef enum {
+    MOBOT_OK = 0,
+    MOBOT_ERREUR_ARGUMENT,      /**< Paramètre NULL ou invalide. */
+    MOBOT_ERREUR_FICHIER,       /**< Le fichier n'a pas pu être ouvert. */
+    MOBOT_ERREUR_FORMAT,        /**< Le fichier n'est pas une image .txt complète. */
+    MOBOT_ERREUR_MEMOIRE,
+    MOBOT_ERREUR_LANGUE         /**< Code de langue inconnu. */
+} StatutMobot;
+
+/**
+ * @brief Gravité d'un message du journal.
+ */
+typedef enum {
+    MOBOT_JOURNAL_ERREUR = 0,
+    MOBOT_JOURNAL_INFO
+} NiveauMobot;
+
+/**
+ * @brief Fonction de journal : reçoit chaque message de la bibliothèque, sans retour à la ligne final.
+ */
+typedef void (*JournalMobot)(void *donnees, NiveauMobot niveau, const char *message);
+
+typedef struct ContexteMobot ContexteMobot;
+
+/**
+ * @brief Actions d'une phrase analysée.
+ */
+typedef struct {
+    const Grammaire *langue;        /**< Langue de la phrase, identifiée avec le code "auto". */
+    const ActionData *actions;      /**< Appartiennent au contexte : valides jusqu'à son prochain appel. */
+    int nb_actions;
+} ResultatPhrase;
+
+/**
+ * @brief Fin de la simulation d'une phrase.
+ */
+typedef struct {
+    Pose pose;          /**< Pose finale exacte. */
+    double cap;         /**< Cap final en degrés, comme tl.heading(). */
+    int nb_commandes;   /**< Commandes exécutées (traduireActions). */
+    double duree;       /**< Temps simulé, en secondes (horloge par défaut). */
+} ResultatSimulation;
+
+ContexteMobot *mobot_creer(void);
+void mobot_detruire(ContexteMobot *ctx);
+void mobot_journal(ContexteMobot *ctx, JournalMobot fonction, void *donnees);
+const char *mobot_message(StatutMobot statut);
+
+StatutMobot mobot_analyserImage(ContexteMobot *ctx, const char *fichier, ResultatImage *resultat);
+StatutMobot mobot_sceneImage(ContexteMobot *ctx, const char *fichier, Scene *scene);
+StatutMobot mobot_analyserPhrase(ContexteMobot *ctx, const char *langue, const char *phrase, ResultatPhrase *resultat);
+StatutMobot mobot_simulerPhrase(ContexteMobot *ctx, const Scene *scene, const char *langue, const char *phrase, ResultatSimulation *resultat);
+
+#endif
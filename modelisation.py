@@ -1,11 +1,121 @@
 #Auteur : Solal Danton Laloy
 
 import turtle as tl
+import tkinter
 import time
 import sys
+import math
+import os
+import traceback
+import struct
+import collections
 
 sc = tl.Screen() 
-tl.speed(2)
+
+
+
+class Horloge:
+    """
+    Horloge à pas fixe des mouvements du robot, réglée par le programme C (enregistrement HORLOGE) : le robot avance
+    à vitesse unités/s et tourne à vitesse_angulaire degrés/s. Les mouvements sont calculés d'un coup par la tortue
+    anonyme du module, cachée, comme dans simulation.c ; chacun est mis en file, puis affiché par la tortue robot
+    à chaque tick de sc.ontimer. Le temps simulé avance de pas en pas : à chaque tick, le robot est placé au dernier
+    pas atteint, le temps simulé valant le temps réel écoulé depuis le départ du robot multiplié par le facteur.
+    Avec un facteur nul, chaque mouvement est affiché d'un coup, sans attendre.
+    """
+    def __init__(self):
+        self.pas, self.vitesse, self.vitesse_angulaire, self.facteur = 0.01, 330.0, 300.0, 1.0
+        self.mouvements = collections.deque()    #(nombre de pas, etape) des mouvements pas encore affichés.
+        self.pas_ecoules = 0                     #Pas des mouvements entièrement affichés.
+        self.en_cours = False                    #Un tick est programmé.
+        self.depart = 0.0
+        self.apres = None                        #Appelé une fois le dernier mouvement affiché.
+
+    def demarrer(self):
+        """
+        Remet le temps simulé à zéro au départ du robot.
+        """
+        self.mouvements.clear()
+        self.pas_ecoules = 0
+        self.depart = time.monotonic()
+
+    def ajouter(self, duree, etape):
+        """
+        Met en file un mouvement de durée duree : etape(f) place le robot à la fraction f du mouvement, et exactement
+        à l'arrivée pour f = 1.
+        """
+        if self.facteur <= 0:
+            etape(1)
+            return
+        self.mouvements.append((math.ceil(duree / self.pas - 1e-9) if duree > 0 else 0, etape))
+        if not self.en_cours:
+            self.en_cours = True
+            sc.ontimer(self.tick, 0)
+
+    def tick(self):
+        """
+        Affiche les mouvements jusqu'au pas atteint par le temps réel, puis attend le pas suivant.
+        """
+        atteint = math.floor((time.monotonic() - self.depart) * self.facteur / self.pas)
+        while self.mouvements:
+            n, etape = self.mouvements[0]
+            k = atteint - self.pas_ecoules
+            if k < n:
+                etape(k / n)
+                break
+            etape(1)
+            self.mouvements.popleft()
+            self.pas_ecoules += n
+        sc.update()
+        if self.mouvements:
+            sc.ontimer(self.tick, max(1, round(1000 * self.pas / self.facteur)))
+            return
+        self.en_cours = False
+        if self.apres is not None:
+            apres, self.apres = self.apres, None
+            apres()
+
+horloge = Horloge()
+
+#Tortue visible du robot : elle suit la tortue anonyme, qui calcule les déplacements sans rien dessiner.
+robot = tl.Turtle(visible=False)
+
+
+
+def translater(deplacement, *arguments):
+    """
+    Déplace la tortue de calcul en ligne droite (tl.forward, tl.setx, tl.sety), puis met le trajet en file pour
+    le robot, qui le trace.
+    """
+    debut = tl.pos()
+    deplacement(*arguments)
+    fin = tl.pos()
+    horloge.ajouter(abs(fin - debut) / horloge.vitesse, lambda f: robot.goto(fin if f >= 1 else debut + (fin - debut) * f))
+
+
+
+def tourner(angle):
+    """
+    Tourne la tortue de calcul de angle degrés vers la gauche (tl.left), puis met la rotation en file pour le robot.
+    tl.right(a) est tourner(-a).
+    """
+    cap = tl.heading()
+    tl.left(angle)
+    fin = tl.heading()
+    horloge.ajouter(abs(angle) / horloge.vitesse_angulaire, lambda f: robot.setheading(fin if f >= 1 else cap + angle * f))
+
+
+
+def orienter(cap):
+    """
+    Oriente la tortue de calcul au cap donné (tl.setheading), par le plus court chemin comme turtle.
+    """
+    angle = (cap - tl.heading() + 180) % 360 - 180
+    debut = tl.heading()
+    tl.setheading(cap)
+    fin = tl.heading()
+    horloge.ajouter(abs(angle) / horloge.vitesse_angulaire, lambda f: robot.setheading(fin if f >= 1 else debut + angle * f))
+
 
 
 def initialisation(x_HD, y_HD,nom):
@@ -66,6 +176,7 @@ def initialisation(x_HD, y_HD,nom):
 def set_robot_position(x, y, angle):
     """
     Place le robot dans la position d'où est prise la photo, puis configure son apparence et l'apparence de son tracé.
+    La tortue anonyme, qui calcule ensuite les déplacements, est cachée et ne dessine plus.
 
     :param x: Coordonnée X du centre du robot.
     :type x: int
@@ -76,13 +187,61 @@ def set_robot_position(x, y, angle):
     """
     tl.up()
     tl.goto(x, y)
-    tl.shape()
-    tl.shapesize(2, 2)
-    tl.fillcolor("aqua")
     tl.setheading(angle)
-    tl.down()
-    tl.width(1) 
-    tl.color("aqua")      
+    tl.hideturtle()
+    robot.up()
+    robot.goto(tl.pos())
+    robot.setheading(tl.heading())
+    robot.shapesize(2, 2)
+    robot.fillcolor("aqua")
+    robot.down()
+    robot.width(1)
+    robot.color("aqua")
+    robot.showturtle()
+
+
+
+def borner():
+    """
+    Replace le robot dans l'arène s'il en est sorti.
+    """
+    if tl.xcor()>150:
+        translater(tl.setx, 150)
+    if tl.xcor()<-150:
+        translater(tl.setx, -150)
+    if tl.ycor()>150:
+        translater(tl.sety, 150)
+    if tl.ycor()<-150:
+        translater(tl.sety, -150)
+
+
+
+def parcourir(d, sens):
+    '''
+    Déplace le robot de d en ligne droite, en un seul tracé arrêté au bord de l'arène. La distance jusqu'au bord est
+    calculée directement à partir de la position et du cap, sans avancer pas à pas.
+
+    :param d: Distance à parcourir.
+    :type d: float
+    :param sens: 1 pour avancer, -1 pour reculer.
+    :type sens: int
+    '''
+    x, y = tl.pos()
+    if d > 0 and -150 <= x <= 150 and -150 <= y <= 150:
+        a = math.radians(tl.heading())
+        ux, uy = sens * math.cos(a), sens * math.sin(a)
+        limite = d
+        if ux > 0:
+            limite = min(limite, (150 - x) / ux)
+        elif ux < 0:
+            limite = min(limite, (-150 - x) / ux)
+        if uy > 0:
+            limite = min(limite, (150 - y) / uy)
+        elif uy < 0:
+            limite = min(limite, (-150 - y) / uy)
+        translater(tl.forward, sens * limite)
+    #Le cap est arrondi : le robot peut dépasser le bord d'une fraction d'unité, il est alors replacé dedans.
+    borner()
 
 
 
@@ -93,29 +252,8 @@ def avancer(d):
     :param d: Distance à parcourir.
     :type d: int
     '''
-    #Fais avancer le robot tant qu'il est dans la zone de l'image.
-    while d > 0:
-        if ((d>=95)and(-50<tl.xcor()<50) and (-50<tl.ycor()<50)):
-            tl.forward(90)
-            d-=95
-        elif ((d>=9)and(-140<tl.xcor()<140) and (-140<tl.ycor()<140)):
-            tl.forward(9)
-            d-=9 
-        elif ((d>=1)and(-150.1<tl.xcor()<150.1) and (-150.1<tl.ycor()<150.1)):
-            tl.forward(1)
-            d-=1          
-        else:
-            d=0 
-    #Dans le cas où le robot serait sorti de la zone de quelques millimètres, il est replacé dedans.
-    if tl.xcor()>150:
-        tl.setx(150)
-    if tl.xcor()<-150:
-        tl.setx(-150)
-    if tl.ycor()>150:
-        tl.sety(150)
-    if tl.ycor()<-150:
-        tl.sety(-150)
-        
+    parcourir(d, 1)
+
 
 
 def reculer(d):
@@ -125,26 +263,7 @@ def reculer(d):
     :param d: Distance à parcourir.
     :type d: int
     '''   
-    while d > 0:
-        if ((d>=95)and(-50<tl.xcor()<50) and (-50<tl.ycor()<50)):
-            tl.backward(90)
-            d-=95
-        elif ((d>=9)and(-140<tl.xcor()<140) and (-140<tl.ycor()<140)):
-            tl.backward(9)
-            d-=9 
-        elif ((d>=1)and(-151<tl.xcor()<151) and (-151<tl.ycor()<151)):
-            tl.backward(1)
-            d-=1
-        else:
-            d=0
-    if tl.xcor()>150:
-        tl.setx(150)
-    if tl.xcor()<-150:
-        tl.setx(-150)
-    if tl.ycor()>150:
-        tl.sety(150)
-    if tl.ycor()<-150:
-        tl.sety(-150)
+    parcourir(d, -1)
 
 
 
@@ -183,11 +302,11 @@ def gobj(couleur):
     #trouve l'angle entre le centre de la boule et le robot
     angle = tl.towards(couleur[0], couleur[1]) 
     #place le robot dans cette direction
-    tl.setheading(angle) 
+    orienter(angle)
     #calcul la distance entre le robot et le point le plus proche de la boule
     distance = tl.distance(couleur[0], couleur[1]) - couleur[2] 
     #fait avancer le robot jusqu'à ce point
-    tl.forward(distance) 
+    translater(tl.forward, distance)
 
 
 
@@ -207,27 +326,191 @@ def contobj(x,y,r,coul,sens):
     :type sens: int
     """
     gobj([x,y,r,coul])
-    tl.right(sens*90)
-    tl.forward(r)
-    tl.left(sens*90)
-    tl.forward(2*r)
-    tl.left(sens*90)
-    tl.forward(r)
-    tl.right(sens*90)
+    tourner(-(sens*90))
+    translater(tl.forward, r)
+    tourner(sens*90)
+    translater(tl.forward, 2*r)
+    tourner(sens*90)
+    translater(tl.forward, r)
+    tourner(-(sens*90))
    
           
 
+def debut_scene():
+    """
+    Efface la modélisation précédente et remet le robot dans son état de départ, puis désactive l'animation de
+    turtle : la scène est dessinée d'un coup, et les déplacements du robot sont affichés par l'horloge.
+    """
+    horloge.demarrer()
+    tl.reset()
+    robot.reset()
+    robot.hideturtle()
+    sc.tracer(0, 0)
+
+
+
+def fin_scene():
+    """
+    Affiche la scène dessinée depuis debut_scene et fait partir l'horloge du robot.
+    """
+    sc.update()
+    horloge.demarrer()
+
+
+
+#Protocole binaire du programme C (voir traitementCommande.h) : entête "MBOT", version, longueur du chemin du fond
+#et nombre d'enregistrements, puis le chemin du fond et les enregistrements de taille fixe.
+ENTETE = struct.Struct("<4sBxHI")
+ENREGISTREMENT = struct.Struct("<BBbxiiid")
+VERSION = 1
+GAUCHE, DROITE, AVANCER, RECULER, ALLER_OBJET, CONTOURNER, COMPTER, OBJET_INEXISTANT, LIGNE = range(9)
+SCENE, BOULE, DEPART, HORLOGE = 16, 17, 18, 19
+COULEURS = {2: 'blue', 3: 'yellow', 4: 'orange'}
+NOMS_BOULES = {2: 'BOULE BLEUE', 3: 'BOULE JAUNE', 4: 'BOULE ORANGE'}
+boules = {}
+
+
+
+def executer_enregistrement(fond, opcode, couleur, sens, a, b, c, valeur):
+    """
+    Exécute un enregistrement reçu du programme C : une étape de la scène ou une commande du robot.
+    gobj et contobj reçoivent la boule de la couleur demandée, décrite plus tôt dans le message.
+    """
+    if opcode == HORLOGE:
+        #Vitesses en millièmes d'unité (ou de degré) par seconde, pas en microsecondes.
+        horloge.vitesse, horloge.vitesse_angulaire, horloge.pas = a / 1000, b / 1000, c / 1e6
+        horloge.facteur = valeur
+    elif opcode == SCENE:
+        boules.clear()
+        debut_scene()
+        initialisation(a, b, fond)
+    elif opcode == BOULE:
+        boules[couleur] = [a, b, c, COULEURS[couleur]]
+        boule(a, b, c, COULEURS[couleur])
+    elif opcode == DEPART:
+        set_robot_position(0, b, 90)
+        fin_scene()
+    elif opcode == GAUCHE:
+        tourner(valeur)
+    elif opcode == DROITE:
+        tourner(-valeur)
+    elif opcode == AVANCER:
+        avancer(valeur)
+    elif opcode == RECULER:
+        reculer(valeur)
+    elif opcode == ALLER_OBJET:
+        gobj(boules[couleur])
+    elif opcode == CONTOURNER:
+        contobj(*boules[couleur], sens)
+    elif opcode == COMPTER:
+        if couleur in NOMS_BOULES:
+            print('---> IL Y A %d %s.' % (valeur, NOMS_BOULES[couleur]))
+        else:
+            print('---> IL Y A %d BOULES(S)).' % valeur)
+    elif opcode == OBJET_INEXISTANT:
+        print('---> OBJET INEXISTANT.')
+    elif opcode == LIGNE:
+        translater(tl.forward, valeur)
+
+
+
+def executer_messages(tampon):
+    """
+    Exécute les messages complets du tampon, jusqu'au premier dont le robot est encore en route : le message
+    suivant ne commence qu'une fois l'affichage de ses mouvements terminé.
+
+    :param tampon: Octets reçus du programme C.
+    :type tampon: bytes
+    :return: Les octets d'un message incomplet, à compléter par la suite de l'entrée.
+    :rtype: bytes
+    """
+    debut = 0
+    while len(tampon) - debut >= ENTETE.size and not horloge.mouvements:
+        magie, version, longueur_fond, nb = ENTETE.unpack_from(tampon, debut)
+        if magie != b"MBOT":
+            print("Message invalide, ignoré.", file=sys.stderr)
+            return b""
+        fin = debut + ENTETE.size + longueur_fond + nb * ENREGISTREMENT.size
+        if len(tampon) < fin:
+            break
+        if version == VERSION:
+            position = debut + ENTETE.size
+            fond = tampon[position:position + longueur_fond].decode(errors="replace")
+            for champs in ENREGISTREMENT.iter_unpack(tampon[position + longueur_fond:fin]):
+                try:
+                    executer_enregistrement(fond, *champs)
+                except Exception:
+                    traceback.print_exc()
+        else:
+            print("Message de version %d ignoré." % version, file=sys.stderr)
+        sc.update()
+        sys.stdout.flush()
+        debut = fin
+    return tampon[debut:]
+
+
+
+def executer_tout(tampon):
+    """
+    Exécute tous les messages complets du tampon, chacun une fois le robot du précédent arrivé.
+    """
+    reste = executer_messages(tampon)
+    if horloge.mouvements:
+        horloge.apres = lambda: executer_tout(reste)
+
+
+
+def serveur():
+    """
+    Reste ouvert et exécute chaque message reçu sur l'entrée standard dès qu'il est complet, sans bloquer la
+    fenêtre. Le programme C n'a ainsi à lancer Python, Tk et turtle qu'une fois par session. La fenêtre se ferme
+    quand l'entrée standard est fermée et que le robot est arrivé. Un message n'est exécuté qu'une fois le robot du
+    précédent arrivé ; pendant son exécution, l'entrée n'est pas surveillée, car les mises à jour de l'écran
+    traitent les événements de Tk.
+    """
+    racine = sc.getcanvas().winfo_toplevel()
+    entree = sys.stdin.fileno()
+    tampon = b""
+    fermee = False
+
+    def reprendre():
+        nonlocal tampon
+        if horloge.mouvements:
+            return
+        if not fermee:
+            racine.tk.deletefilehandler(entree)
+        tampon = executer_messages(tampon)
+        if horloge.mouvements:
+            horloge.apres = reprendre
+        elif fermee:
+            sc.bye()
+            return
+        if not fermee:
+            racine.tk.createfilehandler(entree, tkinter.READABLE, lire)
+
+    def lire(fichier, masque):
+        nonlocal tampon, fermee
+        donnees = os.read(entree, 65536)
+        if not donnees:
+            racine.tk.deletefilehandler(entree)
+            fermee = True
+        tampon += donnees
+        reprendre()
+
+    racine.tk.createfilehandler(entree, tkinter.READABLE, lire)
+    sc.mainloop()
+
+
+
 #Ne s'exécute que si ce code est exécuté en tant que code principal
 if __name__ == "__main__":
     #Assure que le robot est bien en mode standard.
     tl.mode("standard")
-    #Lis les fonctions envoyé par le .c
-    code_turtle = sys.stdin.read() 
-    #Exécute ces fonctions
-    exec(code_turtle)
-
-#Attend 3 secondes que le robot ait terminé.
-time.sleep(3)
-#La fenêtre se ferme en cliquant dessus.
-sc.exitonclick()
-
+    if "--serveur" in sys.argv[1:]:
+        #Exécute les messages envoyés par le .c au fil de la session.
+        serveur()
+    else:
+        #Lis et exécute les messages envoyés par le .c ; les mouvements sont affichés par la boucle de Tk.
+        executer_tout(sys.stdin.buffer.read())
+        #La fenêtre se ferme en cliquant dessus.
+        sc.exitonclick()
@@ -0,0 +1,97 @@
+#include <stddef.h>
+#include <string.h>
+#include "normalisation.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @file
+ * @brief Ce fichier rassemble les fonctions de normalisation du texte UTF-8.
+ *
+ * Les lettres majuscules ASCII sont passées en minuscules et les lettres latines accentuées (U+00C0 à U+00FF,
+ * Œ et œ) sont remplacées par leur lettre de base en minuscule. Tous les autres octets sont recopiés tels quels.
+ * Une forme normalisée n'est jamais plus longue que le texte d'origine, ce qui permet de normaliser sur place.
+ * Quand le processeur dispose de SSE2, le texte ASCII est traité par blocs de 16 octets.
+ */
+
+/**
+ * @defgroup normalisation Normalisation du texte
+ * @brief Minuscules et suppression des accents sur du texte UTF-8.
+ * @{
+ */
+
+//Forme normalisée des caractères U+00C0 à U+00FF, NULL si le caractère est recopié tel quel.
+static const char *const latin1[64] = {
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",      //U+00C0 à U+00CF
+    "d", "n", "o", "o", "o", "o", "o", NULL, "o", "u", "u", "u", "u", "y", NULL, "ss",    //U+00D0 à U+00DF
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",      //U+00E0 à U+00EF
+    "d", "n", "o", "o", "o", "o", "o", NULL, "o", "u", "u", "u", "u", "y", NULL, "y"      //U+00F0 à U+00FF
+};
+
+/**
+ * @brief Normalise un caractère UTF-8.
+ * @param src Position du caractère, avancée au caractère suivant.
+ * @param fin Fin du texte : le caractère n'est jamais lu au-delà.
+ * @param dest Reçoit la forme normalisée (au plus 2 octets, jamais plus que le caractère lu).
+ * @return Nombre d'octets écrits dans dest.
+ */
+size_t normaliser_caractere(const char **src, const char *fin, char *dest) {
+    const unsigned char *c = (const unsigned char *) *src;
+
+    if (c + 1 < (const unsigned char *) fin) {
+        const char *forme = NULL;
+        if (c[0] == 0xC3 && c[1] >= 0x80 && c[1] <= 0xBF) {
+            forme = latin1[c[1] - 0x80];
+        } else if (c[0] == 0xC5 && (c[1] == 0x92 || c[1] == 0x93)) {    //Œ, œ
+            forme = "oe";
+        }
+        if (forme != NULL) {
+            size_t n = strlen(forme);
+            memcpy(dest, forme, n);
+            *src += 2;
+            return n;
+        }
+    }
+    *dest = (c[0] >= 'A' && c[0] <= 'Z') ? c[0] + ('a' - 'A') : c[0];
+    *src += 1;
+    return 1;
+}
+
+/**
+ * @brief Normalise un texte UTF-8.
+ * @param src Texte à normaliser (pas forcément terminé par '\0').
+ * @param longueur Nombre d'octets du texte.
+ * @param dest Reçoit le texte normalisé, sans '\0' final. Il doit pouvoir contenir longueur octets et peut être
+ * égal à src.
+ * @return Nombre d'octets écrits dans dest.
+ */
+size_t normaliser_texte(const char *src, size_t longueur, char *dest) {
+    const char *fin = src + longueur;
+    char *d = dest;
+
+    while (src < fin) {
+#ifdef __SSE2__
+        //16 octets ASCII d'un coup : les octets entre 'A' et 'Z' reçoivent 0x20.
+        if (fin - src >= 16) {
+            __m128i bloc = _mm_loadu_si128((const __m128i *) src);
+            if (_mm_movemask_epi8(bloc) == 0) {
+                __m128i majuscules = _mm_and_si128(_mm_cmpgt_epi8(bloc, _mm_set1_epi8('A' - 1)),
+                                                   _mm_cmplt_epi8(bloc, _mm_set1_epi8('Z' + 1)));
+                bloc = _mm_add_epi8(bloc, _mm_and_si128(majuscules, _mm_set1_epi8('a' - 'A')));
+                _mm_storeu_si128((__m128i *) d, bloc);
+                src += 16;
+                d += 16;
+                continue;
+            }
+        }
+#endif
+        d += normaliser_caractere(&src, fin, d);
+    }
+    return (size_t) (d - dest);
+}
+
+/**
+ * @}
+ */
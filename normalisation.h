@@ -0,0 +1,15 @@
+/**
+ * @file
+ * @brief Ce fichier contient les déclarations de la normalisation du texte UTF-8 : passage en minuscules
+ * et suppression des accents ("MÈTRES", "Mètres" et "metres" ont la même forme normalisée "metres").
+ */
+
+#ifndef NORMALISATION_H
+#define NORMALISATION_H
+
+#include <stddef.h>
+
+size_t normaliser_caractere(const char **src, const char *fin, char *dest);
+size_t normaliser_texte(const char *src, size_t longueur, char *dest);
+
+#endif
@@ -0,0 +1,362 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "planification.h"
+
+/**
+ * @file
+ * @brief Ce fichier rassemble les fonctions du planificateur de trajectoires.
+ */
+
+/**
+ * @defgroup planification Planification de trajectoires
+ * @brief Plus courts chemins autour des boules, dans un graphe de visibilité.
+ * Chaque boule est élargie de PLANIFICATION_MARGE et entourée d'un polygone circonscrit : un chemin qui suit ses
+ * côtés ne touche pas la boule élargie. Les sommets, et les boules qui coupent chaque arête entre deux sommets, sont
+ * calculés une fois par scène. Une requête ne teste plus que les arêtes qui partent du robot ou arrivent au but,
+ * puis cherche le plus court chemin (Dijkstra) sur une cinquantaine de sommets.
+ * @{
+ */
+
+#define PI_PLANIFICATION 3.14159265358979323846
+#define BARRIERE_LONGUEUR 1e6    //Longueur de la demi-droite qui interdit le mauvais côté de contobj.
+
+/**
+ * @brief Indique si le segment [a,b] entre dans le disque de centre c et de rayon r (le toucher ne compte pas).
+ */
+static bool coupeDisque(const double a[2], const double b[2], const double c[2], double r) {
+    double dx = b[0] - a[0], dy = b[1] - a[1];
+    double l2 = dx * dx + dy * dy;
+    double t = (l2 > 0) ? ((c[0] - a[0]) * dx + (c[1] - a[1]) * dy) / l2 : 0.0;
+    double px, py;
+
+    t = fmin(fmax(t, 0.0), 1.0);
+    px = a[0] + t * dx - c[0];
+    py = a[1] + t * dy - c[1];
+    return px * px + py * py < r * r * (1.0 - 1e-9);
+}
+
+/**
+ * @brief Indique si les segments [a,b] et [c,d] se croisent.
+ */
+static bool coupeSegment(const double a[2], const double b[2], const double c[2], const double d[2]) {
+    double d1 = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+    double d2 = (b[0] - a[0]) * (d[1] - a[1]) - (b[1] - a[1]) * (d[0] - a[0]);
+    double d3 = (d[0] - c[0]) * (a[1] - c[1]) - (d[1] - c[1]) * (a[0] - c[0]);
+    double d4 = (d[0] - c[0]) * (b[1] - c[1]) - (d[1] - c[1]) * (b[0] - c[0]);
+    return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+}
+
+static double rayonElargi(const BouleScene *b) {
+    return b->rayon + PLANIFICATION_MARGE;
+}
+
+/**
+ * @brief Calcule le graphe de visibilité de la scène.
+ * @param scene Environnement modélisé ; il est copié.
+ */
+void planificateur_initialiser(Planificateur *pl, const Scene *scene) {
+    double rayon_polygone;
+    int n = 0;
+
+    pl->scene = *scene;
+    for (int c = COULEUR_BLEU; c <= COULEUR_ORANGE; c++) {
+        const BouleScene *b = &scene->boules[c];
+        if (b->rayon <= 0) {
+            continue;
+        }
+        rayon_polygone = rayonElargi(b) / cos(PI_PLANIFICATION / PLANIFICATION_COTES);
+        for (int k = 0; k < PLANIFICATION_COTES; k++) {
+            double angle = 2 * PI_PLANIFICATION * k / PLANIFICATION_COTES;
+            pl->sommets[n][0] = b->milieu[0] + rayon_polygone * cos(angle);
+            pl->sommets[n][1] = b->milieu[1] + rayon_polygone * sin(angle);
+            pl->boule[n] = (unsigned char) c;
+            n++;
+        }
+    }
+    pl->nb_sommets = n;
+
+    for (int i = 0; i < n; i++) {
+        pl->valide[i] = true;
+        for (int c = COULEUR_BLEU; c <= COULEUR_ORANGE; c++) {
+            const BouleScene *b = &scene->boules[c];
+            if (c != pl->boule[i] && b->rayon > 0) {
+                const double centre[2] = {b->milieu[0], b->milieu[1]};
+                pl->valide[i] = pl->valide[i] && !coupeDisque(pl->sommets[i], pl->sommets[i], centre, rayonElargi(b));
+            }
+        }
+        pl->obstacles[i][i] = 0;
+        for (int j = i + 1; j < n; j++) {
+            unsigned char masque = 0;
+            for (int c = COULEUR_BLEU; c <= COULEUR_ORANGE; c++) {
+                const BouleScene *b = &scene->boules[c];
+                const double centre[2] = {b->milieu[0], b->milieu[1]};
+                if (b->rayon > 0 && coupeDisque(pl->sommets[i], pl->sommets[j], centre, rayonElargi(b))) {
+                    masque |= (unsigned char) (1 << c);
+                }
+            }
+            pl->obstacles[i][j] = pl->obstacles[j][i] = masque;
+        }
+    }
+}
+
+/**
+ * @brief Requête en cours : boules évitées, demi-droite interdite éventuelle et position du robot.
+ */
+typedef struct {
+    const Planificateur *pl;
+    unsigned char evitees;          /**< Bit (1 << couleur) des boules à éviter. */
+    bool barriere;
+    double barriere_a[2], barriere_b[2];
+    double depart[2];
+} Requete;
+
+/**
+ * @brief Teste un segment qui part de a contre les boules évitées et la barrière. Une boule élargie qui contient
+ * déjà a (le robot vient de la toucher) est réduite au cercle qui passe par a : le robot peut s'en éloigner ou la
+ * longer, mais pas la traverser.
+ */
+static bool libre(const Requete *rq, const double a[2], const double b[2]) {
+    for (int c = COULEUR_BLEU; c <= COULEUR_ORANGE; c++) {
+        const BouleScene *boule = &rq->pl->scene.boules[c];
+        if (boule->rayon > 0 && (rq->evitees & (1 << c))) {
+            const double centre[2] = {boule->milieu[0], boule->milieu[1]};
+            double r = fmin(rayonElargi(boule), hypot(a[0] - centre[0], a[1] - centre[1]));
+            if (coupeDisque(a, b, centre, r)) {
+                return false;
+            }
+        }
+    }
+    return !(rq->barriere && coupeSegment(a, b, rq->barriere_a, rq->barriere_b));
+}
+
+/**
+ * @brief Arête entre deux noeuds : les sommets 0..nb_sommets-1 et le départ (nb_sommets).
+ * Les arêtes entre sommets utilisent les boules précalculées.
+ */
+static bool arete(const Requete *rq, int i, int j) {
+    const Planificateur *pl = rq->pl;
+    int n = pl->nb_sommets;
+
+    if (i == n || j == n) {
+        int k = (i == n) ? j : i;
+        return libre(rq, rq->depart, pl->sommets[k]);
+    }
+    if (pl->obstacles[i][j] & rq->evitees) {
+        return false;
+    }
+    return !(rq->barriere && coupeSegment(pl->sommets[i], pl->sommets[j], rq->barriere_a, rq->barriere_b));
+}
+
+/**
+ * @brief Plus court chemin du départ à un but, dans le graphe de visibilité.
+ * @param but Point d'arrivée de chaque noeud (but[k] est le point atteint en partant du noeud k) ; le chemin
+ * s'arrête là. Une arrivée à NAN est interdite depuis ce noeud.
+ * @param chemin Reçoit les points du chemin, sans le départ.
+ * @return Nombre de points du chemin, -1 s'il n'y a pas de chemin.
+ */
+static int plusCourtChemin(const Requete *rq, double but[][2], double chemin[][2]) {
+    const Planificateur *pl = rq->pl;
+    int n = pl->nb_sommets;
+    double distance[PLANIFICATION_SOMMETS + 1];
+    int precedent[PLANIFICATION_SOMMETS + 1];
+    bool fait[PLANIFICATION_SOMMETS + 1] = {false};
+    double meilleur = INFINITY;
+    int fin = -1, nb = 0, k, i;
+
+    for (i = 0; i <= n; i++) {
+        distance[i] = INFINITY;
+        precedent[i] = -1;
+    }
+    distance[n] = 0.0;
+    for (;;) {
+        int u = -1;
+        for (i = 0; i <= n; i++) {
+            if (!fait[i] && distance[i] < INFINITY && (u < 0 || distance[i] < distance[u])) {
+                u = i;
+            }
+        }
+        if (u < 0 || distance[u] >= meilleur) {
+            break;
+        }
+        fait[u] = true;
+        const double *p = (u == n) ? rq->depart : pl->sommets[u];
+        if (!isnan(but[u][0]) && libre(rq, p, but[u])) {
+            double total = distance[u] + hypot(but[u][0] - p[0], but[u][1] - p[1]);
+            if (total < meilleur) {
+                meilleur = total;
+                fin = u;
+            }
+        }
+        for (int v = 0; v < n; v++) {
+            if (!fait[v] && pl->valide[v] && arete(rq, u, v)) {
+                double d = distance[u] + hypot(pl->sommets[v][0] - p[0], pl->sommets[v][1] - p[1]);
+                if (d < distance[v]) {
+                    distance[v] = d;
+                    precedent[v] = u;
+                }
+            }
+        }
+    }
+    if (fin < 0) {
+        return -1;
+    }
+    for (k = fin; k != n; k = precedent[k]) {
+        nb++;
+    }
+    chemin[nb][0] = but[fin][0];
+    chemin[nb][1] = but[fin][1];
+    for (k = fin, i = nb - 1; k != n; k = precedent[k], i--) {
+        chemin[i][0] = pl->sommets[k][0];
+        chemin[i][1] = pl->sommets[k][1];
+    }
+    return nb + 1;
+}
+
+static void commencerRequete(Requete *rq, const Planificateur *pl, const Pose *pose) {
+    rq->pl = pl;
+    rq->evitees = 0;
+    for (int c = COULEUR_BLEU; c <= COULEUR_ORANGE; c++) {
+        rq->evitees |= (unsigned char) (1 << c);
+    }
+    rq->barriere = false;
+    rq->depart[0] = pose->x;
+    rq->depart[1] = pose->y;
+}
+
+/**
+ * @brief Chemin de gobj : le plus court chemin jusqu'au bord de la boule de la couleur, qui évite les autres.
+ * Le dernier tronçon vise le centre de la boule, comme gobj.
+ * @param chemin Reçoit au plus PLANIFICATION_POINTS_MAX points, sans la position du robot.
+ * @return Nombre de points du chemin, -1 si la boule est absente, si le robot la touche déjà ou s'il n'y a pas de
+ * chemin.
+ */
+int planificateur_allerObjet(const Planificateur *pl, const Pose *pose, int couleur, double chemin[][2]) {
+    const BouleScene *b = &pl->scene.boules[couleur];
+    double but[PLANIFICATION_SOMMETS + 1][2];
+    Requete rq;
+
+    if (b->rayon <= 0 || hypot(b->milieu[0] - pose->x, b->milieu[1] - pose->y) <= b->rayon) {
+        return -1;
+    }
+    commencerRequete(&rq, pl, pose);
+    rq.evitees &= (unsigned char) ~(1 << couleur);
+    for (int k = 0; k <= pl->nb_sommets; k++) {
+        const double *p = (k == pl->nb_sommets) ? rq.depart : pl->sommets[k];
+        double d = hypot(b->milieu[0] - p[0], b->milieu[1] - p[1]);
+        but[k][0] = but[k][1] = NAN;
+        if (d > b->rayon) {
+            but[k][0] = b->milieu[0] + (p[0] - b->milieu[0]) * (b->rayon / d);
+            but[k][1] = b->milieu[1] + (p[1] - b->milieu[1]) * (b->rayon / d);
+        }
+    }
+    return plusCourtChemin(&rq, but, chemin);
+}
+
+/**
+ * @brief Chemin de contobj : le plus court chemin jusqu'au point de la boule opposé au robot, en passant du côté
+ * demandé et en évitant toutes les boules.
+ * @param sens 1 pour passer à droite de la boule, -1 pour passer à gauche.
+ * @return Nombre de points du chemin, -1 si la boule est absente ou s'il n'y a pas de chemin.
+ */
+int planificateur_contourner(const Planificateur *pl, const Pose *pose, int couleur, int sens, double chemin[][2]) {
+    const BouleScene *b = &pl->scene.boules[couleur];
+    double but[PLANIFICATION_SOMMETS + 1][2];
+    double ux, uy, d;
+    Requete rq;
+
+    d = hypot(b->milieu[0] - pose->x, b->milieu[1] - pose->y);
+    if (b->rayon <= 0 || d == 0) {
+        return -1;
+    }
+    ux = (b->milieu[0] - pose->x) / d;
+    uy = (b->milieu[1] - pose->y) / d;
+    commencerRequete(&rq, pl, pose);
+    //Le mauvais côté est fermé par une demi-droite qui part du centre, perpendiculaire à la direction d'arrivée.
+    rq.barriere = true;
+    rq.barriere_a[0] = b->milieu[0];
+    rq.barriere_a[1] = b->milieu[1];
+    rq.barriere_b[0] = b->milieu[0] - sens * uy * BARRIERE_LONGUEUR;
+    rq.barriere_b[1] = b->milieu[1] + sens * ux * BARRIERE_LONGUEUR;
+    for (int k = 0; k <= pl->nb_sommets; k++) {
+        but[k][0] = b->milieu[0] + ux * rayonElargi(b);
+        but[k][1] = b->milieu[1] + uy * rayonElargi(b);
+    }
+    return plusCourtChemin(&rq, but, chemin);
+}
+
+/**
+ * @brief Ajoute la rotation qui oriente le robot au cap donné (en degrés, par le plus petit angle), et l'exécute.
+ */
+static int orienterVers(Simulation *sim, double cap, Commande *sortie) {
+    double angle = fmod(cap - simulation_cap(sim), 360.0);
+
+    if (angle > 180.0) {
+        angle -= 360.0;
+    } else if (angle <= -180.0) {
+        angle += 360.0;
+    }
+    sortie[0] = (Commande) {angle, COMMANDE_GAUCHE, COULEUR_AUCUNE, 0};
+    simulation_executer(sim, sortie, 1);
+    return 1;
+}
+
+/**
+ * @brief Ajoute les commandes qui orientent le robot vers un point puis l'y amènent en ligne droite, et les exécute.
+ */
+static int allerPoint(Simulation *sim, const double point[2], Commande *sortie) {
+    double dx = point[0] - sim->pose.x, dy = point[1] - sim->pose.y;
+    int n;
+
+    if (hypot(dx, dy) < 1e-9) {
+        return 0;
+    }
+    n = orienterVers(sim, atan2(dy, dx) * (180.0 / PI_PLANIFICATION), sortie);
+    sortie[n] = (Commande) {hypot(point[0] - sim->pose.x, point[1] - sim->pose.y), COMMANDE_LIGNE, COULEUR_AUCUNE, 0};
+    simulation_executer(sim, &sortie[n], 1);
+    return n + 1;
+}
+
+/**
+ * @brief Remplace les commandes COMMANDE_ALLER_OBJET et COMMANDE_CONTOURNER par les rotations et les lignes droites
+ * de leur chemin planifié. Les commandes sont simulées au fur et à mesure pour connaître la position du robot au
+ * début de chaque chemin. Une commande sans chemin (boule absente, robot enfermé) est gardée telle quelle.
+ * @param sortie Reçoit au plus nb_commandes * COMMANDES_PAR_PLANIFICATION commandes.
+ * @return Nombre de commandes écrites dans sortie.
+ */
+int planifierCommandes(const Planificateur *pl, const Commande *commandes, int nb_commandes, Commande *sortie) {
+    double chemin[PLANIFICATION_POINTS_MAX][2];
+    Simulation sim;
+    int n = 0;
+
+    simulation_initialiser(&sim, &pl->scene);
+    for (int i = 0; i < nb_commandes; i++) {
+        const Commande *c = &commandes[i];
+        const BouleScene *b = &pl->scene.boules[c->couleur];
+        //Direction d'arrivée sur la boule : contobj se termine tourné dans cette direction.
+        double cap = atan2(b->milieu[1] - sim.pose.y, b->milieu[0] - sim.pose.x) * (180.0 / PI_PLANIFICATION);
+        int nb_points = -1;
+
+        if (c->opcode == COMMANDE_ALLER_OBJET) {
+            nb_points = planificateur_allerObjet(pl, &sim.pose, c->couleur, chemin);
+        } else if (c->opcode == COMMANDE_CONTOURNER) {
+            nb_points = planificateur_contourner(pl, &sim.pose, c->couleur, c->sens, chemin);
+        }
+        if (nb_points < 0) {
+            sortie[n++] = *c;
+            simulation_executer(&sim, c, 1);
+            continue;
+        }
+        for (int k = 0; k < nb_points; k++) {
+            n += allerPoint(&sim, chemin[k], &sortie[n]);
+        }
+        if (c->opcode == COMMANDE_CONTOURNER) {
+            n += orienterVers(&sim, cap, &sortie[n]);
+        }
+    }
+    return n;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,37 @@
+/**
+ * @file
+ * @brief Ce fichier contient les déclarations du planificateur de trajectoires.
+ * Il remplace la ligne droite de gobj et le carré de contobj par le plus court chemin qui évite les autres boules :
+ * chaque boule, élargie d'une marge, est entourée d'un polygone dont les sommets forment un graphe de visibilité.
+ */
+
+#ifndef PLANIFICATION_H
+#define PLANIFICATION_H
+
+#include <stdbool.h>
+#include "simulation.h"
+
+#define PLANIFICATION_COTES 16       //Côtés du polygone qui entoure chaque boule.
+#define PLANIFICATION_MARGE 2.0      //Distance minimale entre le robot et une boule qu'il évite.
+#define PLANIFICATION_SOMMETS (PLANIFICATION_COTES * (COULEUR_ORANGE - COULEUR_BLEU + 1))
+#define PLANIFICATION_POINTS_MAX (PLANIFICATION_SOMMETS + 1)                  //Points d'un chemin planifié.
+#define COMMANDES_PAR_PLANIFICATION (2 * PLANIFICATION_POINTS_MAX + 1)       //Commandes d'un chemin planifié.
+
+/**
+ * @brief Graphe de visibilité d'une scène, calculé une fois pour toutes les requêtes.
+ */
+typedef struct {
+    Scene scene;
+    int nb_sommets;
+    double sommets[PLANIFICATION_SOMMETS][2];
+    unsigned char boule[PLANIFICATION_SOMMETS];       /**< Couleur de la boule entourée par le sommet. */
+    bool valide[PLANIFICATION_SOMMETS];               /**< false si le sommet est dans une autre boule élargie. */
+    unsigned char obstacles[PLANIFICATION_SOMMETS][PLANIFICATION_SOMMETS];    /**< Bit (1 << couleur) de chaque boule qui coupe l'arête. */
+} Planificateur;
+
+void planificateur_initialiser(Planificateur *pl, const Scene *scene);
+int planificateur_allerObjet(const Planificateur *pl, const Pose *pose, int couleur, double chemin[][2]);
+int planificateur_contourner(const Planificateur *pl, const Pose *pose, int couleur, int sens, double chemin[][2]);
+int planifierCommandes(const Planificateur *pl, const Commande *commandes, int nb_commandes, Commande *sortie);
+
+#endif
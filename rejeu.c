@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "simulation.h"
+#include "trajectoire.h"
+#include "rendu.h"
+
+/**
+ * @file
+ * @brief Relecture des journaux de trajectoire.
+ *
+ * "./rejeu journal.traj" affiche un résumé de chaque simulation enregistrée : numéro, nom, nombre de poses et de
+ * commandes, durée simulée, pose d'arrivée et collisions.
+ * - "--poses" affiche aussi chaque pose datée : "temps x y cap".
+ * - "--verifier" rejoue chaque simulation à partir de sa scène et de ses commandes, et vérifie qu'elle produit
+ *   exactement le même enregistrement.
+ * - "--rendu <prefixe>" dessine chaque simulation dans "<prefixe>_<n>.png" (".ppm" avec "--ppm"), n étant son rang
+ *   dans le journal.
+ * - "--numero <n>" ne traite que les simulations de numéro n.
+ */
+
+/**
+ * @defgroup rejeu Relecture des trajectoires
+ * @brief Résumé, vérification et rendu des simulations d'un journal.
+ * @{
+ */
+
+/**
+ * @brief Lit entièrement un fichier en mémoire.
+ * @return Contenu du fichier, NULL en cas d'erreur.
+ */
+static unsigned char *lireFichier(const char *nom, size_t *taille) {
+    FILE *f = fopen(nom, "rb");
+    unsigned char *contenu = NULL;
+    size_t capacite = 0;
+    size_t lus;
+
+    *taille = 0;
+    if (f == NULL) {
+        return NULL;
+    }
+    do {
+        if (*taille == capacite) {
+            capacite = (capacite > 0) ? 2 * capacite : 65536;
+            unsigned char *c = realloc(contenu, capacite);
+            if (c == NULL) {
+                free(contenu);
+                fclose(f);
+                return NULL;
+            }
+            contenu = c;
+        }
+        lus = fread(contenu + *taille, 1, capacite - *taille, f);
+        *taille += lus;
+    } while (lus > 0);
+    fclose(f);
+    return contenu;
+}
+
+/**
+ * @brief Cartes des obstacles des scènes déjà rejouées : un journal de simulations par lot alterne entre quelques
+ * scènes, dont la carte n'est construite qu'une fois.
+ */
+typedef struct {
+    Scene *scenes;
+    Carte *cartes;
+    int nb, capacite;
+} CartesRejeu;
+
+/**
+ * @brief Carte des obstacles d'une scène, construite à sa première demande.
+ * @return NULL si la mémoire manque.
+ */
+static const Carte *carteScene(CartesRejeu *c, const Scene *scene) {
+    for (int i = 0; i < c->nb; i++) {
+        if (memcmp(&c->scenes[i], scene, sizeof(Scene)) == 0) {
+            return &c->cartes[i];
+        }
+    }
+    if (c->nb == c->capacite) {
+        int capacite = (c->capacite > 0) ? 2 * c->capacite : 16;
+        Scene *scenes = realloc(c->scenes, (size_t) capacite * sizeof(Scene));
+        if (scenes != NULL) {
+            c->scenes = scenes;
+        }
+        Carte *cartes = realloc(c->cartes, (size_t) capacite * sizeof(Carte));
+        if (cartes != NULL) {
+            c->cartes = cartes;
+        }
+        if (scenes == NULL || cartes == NULL) {
+            return NULL;
+        }
+        c->capacite = capacite;
+    }
+    if (!simulation_construireCarte(&c->cartes[c->nb], scene)) {
+        return NULL;
+    }
+    c->scenes[c->nb] = *scene;
+    return &c->cartes[c->nb++];
+}
+
+/**
+ * @brief Rejoue une simulation et compare son enregistrement à celui du journal.
+ * @return true si les deux enregistrements sont identiques.
+ */
+static bool verifier(const TrajectoireLue *t, const unsigned char *octets, size_t taille, JournalTrajectoire *journal, CartesRejeu *c) {
+    const Carte *carte = t->obstacles ? carteScene(c, &t->scene) : NULL;
+    Simulation sim;
+
+    if (t->obstacles && carte == NULL) {
+        return false;
+    }
+    simulation_initialiser(&sim, &t->scene);
+    simulation_horloge(&sim, &t->horloge);
+    if (t->obstacles) {
+        simulation_obstacles(&sim, carte);
+    }
+    journal->longueur = 0;
+    journal_commencer(journal, &sim, t->numero, t->nom);
+    simulation_journaliser(&sim, journal);
+    simulation_executer(&sim, t->commandes, t->nb_commandes);
+    journal_terminer(journal, &sim);
+    return !journal->erreur && journal->longueur == taille && memcmp(journal->donnees, octets, taille) == 0;
+}
+
+/**
+ * @brief Dessine la scène, la trajectoire (les poses successives reliées) et le robot à l'arrivée. Le fond est
+ * l'image .gif de même nom que la simulation, s'il existe.
+ */
+static bool dessiner(const TrajectoireLue *t, const char *chemin, bool ppm) {
+    Image fond = {0}, image = {0};
+    char gif[TRAJECTOIRE_NOM_MAX];
+    char *extension;
+    bool ok;
+
+    snprintf(gif, sizeof(gif), "%s", t->nom);
+    extension = strstr(gif, "txt");
+    if (extension != NULL) {
+        memcpy(extension, "gif", 3);
+        image_chargerGif(&fond, gif);
+    }
+    ok = rendu_scene(&image, &fond, &t->scene);
+    if (ok) {
+        for (int i = 1; i < t->nb_poses; i++) {
+            rendu_segment(&image, t->poses[i - 1].x, t->poses[i - 1].y, t->poses[i].x, t->poses[i].y);
+        }
+        rendu_robot(&image, &t->arrivee);
+        ok = ppm ? image_ecrirePpm(&image, chemin) : image_ecrirePng(&image, chemin);
+    }
+    image_detruire(&fond);
+    image_detruire(&image);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    const char *fichier = NULL, *rendu = NULL;
+    bool poses = false, verification = false, ppm = false;
+    int numero = -1, rang = 0, differences = 0, erreur = 0;
+    unsigned char *octets;
+    size_t taille, position = 0;
+    JournalTrajectoire journal;
+    CartesRejeu cartes = {NULL, NULL, 0, 0};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--poses") == 0) {
+            poses = true;
+        } else if (strcmp(argv[i], "--verifier") == 0) {
+            verification = true;
+        } else if (strcmp(argv[i], "--ppm") == 0) {
+            ppm = true;
+        } else if (strcmp(argv[i], "--rendu") == 0 && i + 1 < argc) {
+            rendu = argv[++i];
+        } else if (strcmp(argv[i], "--numero") == 0 && i + 1 < argc) {
+            numero = atoi(argv[++i]);
+        } else if (fichier == NULL && argv[i][0] != '-') {
+            fichier = argv[i];
+        } else {
+            fichier = NULL;
+            break;
+        }
+    }
+    if (fichier == NULL) {
+        fprintf(stderr, "Usage : %s <journal> [--numero <n>] [--poses] [--verifier] [--rendu <prefixe>] [--ppm]\n", argv[0]);
+        return 1;
+    }
+    octets = lireFichier(fichier, &taille);
+    if (octets == NULL) {
+        perror(fichier);
+        return 1;
+    }
+    journal_initialiser(&journal);
+
+    while (position < taille) {
+        TrajectoireLue t;
+        long lus = trajectoire_lire(octets + position, taille - position, &t);
+        if (lus <= 0) {
+            fprintf(stderr, "Erreur: journal invalide ou tronqué à l'octet %zu.\n", position);
+            trajectoire_detruire(&t);
+            erreur = 1;
+            break;
+        }
+        rang++;
+        if (numero < 0 || t.numero == numero) {
+            Simulation arrivee = {.pose = t.arrivee};
+            printf("%d %s : %d poses, %d commandes, %.3f s, arrivée %.17g %.17g %.17g, %d collision(s)",
+                   t.numero, t.nom, t.nb_poses, t.nb_commandes, t.nb_poses > 0 ? t.poses[t.nb_poses - 1].temps : 0.0,
+                   t.arrivee.x, t.arrivee.y, simulation_cap(&arrivee), t.collisions);
+            if (verification) {
+                bool identique = verifier(&t, octets + position, (size_t) lus, &journal, &cartes);
+                printf(identique ? ", identique" : ", DIFFERENTE");
+                differences += identique ? 0 : 1;
+            }
+            printf("\n");
+            for (int i = 0; poses && i < t.nb_poses; i++) {
+                printf("%.3f %.3f %.3f %.3f\n", t.poses[i].temps, t.poses[i].x, t.poses[i].y, t.poses[i].cap);
+            }
+            if (rendu != NULL) {
+                char chemin[1024];
+                snprintf(chemin, sizeof(chemin), "%s_%d.%s", rendu, rang, ppm ? "ppm" : "png");
+                if (!dessiner(&t, chemin, ppm)) {
+                    erreur = 1;
+                }
+            }
+        }
+        trajectoire_detruire(&t);
+        position += (size_t) lus;
+    }
+    free(octets);
+    journal_detruire(&journal);
+    for (int i = 0; i < cartes.nb; i++) {
+        carte_detruire(&cartes.cartes[i]);
+    }
+    free(cartes.scenes);
+    free(cartes.cartes);
+    if (verification) {
+        fprintf(stderr, "%d simulation(s) rejouée(s) différemment.\n", differences);
+    }
+    return (erreur || differences > 0) ? 1 : 0;
+}
+
+/**
+ * @}
+ */
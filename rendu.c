@@ -0,0 +1,540 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "rendu.h"
+
+/**
+ * @file
+ * @brief Ce fichier rassemble les fonctions du rendu sans fenêtre.
+ */
+
+/**
+ * @defgroup rendu Rendu sans fenêtre
+ * @brief Dessin des scènes et des trajectoires dans une image en mémoire, écrite en PPM ou en PNG.
+ * Le repère est celui de turtle : l'origine au centre de l'image, l'axe y vers le haut. Comme la fenêtre de
+ * modelisation.py, l'image mesure (2*coin_HD[0]+50) x (2*coin_HD[1]+50) pixels et le fond y est centré.
+ * @{
+ */
+
+static const unsigned char BLANC[3] = {255, 255, 255};
+static const unsigned char VERT_FONCE[3] = {0, 100, 0};     //'DarkGreen' du contour.
+static const unsigned char ROUGE[3] = {255, 0, 0};          //Graduations.
+static const unsigned char AQUA[3] = {0, 255, 255};         //Robot et trajectoire.
+static const unsigned char COULEUR_BOULE[][3] = {[COULEUR_BLEU] = {0, 0, 255}, [COULEUR_JAUNE] = {255, 255, 0}, [COULEUR_ORANGE] = {255, 165, 0}};
+
+/**
+ * @brief (Re)dimensionne une image ; le tampon est conservé si la taille ne change pas, pour rendre des séries
+ * de scènes sans allocation.
+ * @param img Image vide (initialisée à zéro) ou déjà créée.
+ * @return false si la mémoire manque.
+ */
+bool image_creer(Image *img, int largeur, int hauteur) {
+    if (img->rgb == NULL || img->largeur != largeur || img->hauteur != hauteur) {
+        unsigned char *rgb = realloc(img->rgb, (size_t) largeur * hauteur * 3);
+        if (rgb == NULL) {
+            return false;
+        }
+        img->rgb = rgb;
+        img->largeur = largeur;
+        img->hauteur = hauteur;
+    }
+    return true;
+}
+
+void image_detruire(Image *img) {
+    free(img->rgb);
+    img->rgb = NULL;
+    img->largeur = img->hauteur = 0;
+}
+
+/**
+ * @brief Copie source dans destination, (re)dimensionnée si besoin.
+ * @return false si la mémoire manque.
+ */
+bool image_copier(Image *destination, const Image *source) {
+    if (!image_creer(destination, source->largeur, source->hauteur)) {
+        return false;
+    }
+    memcpy(destination->rgb, source->rgb, (size_t) source->largeur * source->hauteur * 3);
+    return true;
+}
+
+static void colorier(Image *img, int px, int py, const unsigned char couleur[3]) {
+    if (px >= 0 && px < img->largeur && py >= 0 && py < img->hauteur) {
+        memcpy(&img->rgb[((size_t) py * img->largeur + px) * 3], couleur, 3);
+    }
+}
+
+/**
+ * @brief Décode le flux LZW d'une image GIF en indices de palette.
+ * @return false si le flux est invalide.
+ */
+static bool decoderLzw(const unsigned char *donnees, size_t taille, int taille_min, unsigned char *indices, size_t nb_pixels) {
+    static const int CODES_MAX = 4096;
+    uint16_t prefixe[4096];
+    unsigned char suffixe[4096], pile[4097];
+    int effacer = 1 << taille_min, fin = effacer + 1;
+    int taille_code = taille_min + 1, prochain = effacer + 2, ancien = -1, premier = 0;
+    size_t bit = 0, ecrits = 0;
+
+    if (taille_min < 2 || taille_min > 8) {
+        return false;
+    }
+    for (int i = 0; i < effacer; i++) {
+        suffixe[i] = (unsigned char) i;
+    }
+    while (ecrits < nb_pixels && bit + taille_code <= taille * 8) {
+        int code = 0;
+        for (int i = 0; i < taille_code; i++, bit++) {
+            code |= ((donnees[bit / 8] >> (bit % 8)) & 1) << i;
+        }
+        if (code == effacer) {
+            taille_code = taille_min + 1;
+            prochain = effacer + 2;
+            ancien = -1;
+            continue;
+        }
+        if (code == fin) {
+            break;
+        }
+        if (ancien == -1) {
+            if (code >= effacer) {
+                return false;
+            }
+            indices[ecrits++] = (unsigned char) code;
+            ancien = premier = code;
+            continue;
+        }
+        int courant = code, hauteur = 0;
+        if (code >= prochain) {
+            if (code > prochain) {
+                return false;
+            }
+            pile[hauteur++] = (unsigned char) premier;
+            code = ancien;
+        }
+        while (code >= effacer) {
+            pile[hauteur++] = suffixe[code];
+            code = prefixe[code];
+        }
+        premier = code;
+        pile[hauteur++] = (unsigned char) premier;
+        while (hauteur > 0 && ecrits < nb_pixels) {
+            indices[ecrits++] = pile[--hauteur];
+        }
+        if (prochain < CODES_MAX) {
+            prefixe[prochain] = (uint16_t) ancien;
+            suffixe[prochain] = (unsigned char) premier;
+            prochain++;
+            if (prochain == (1 << taille_code) && taille_code < 12) {
+                taille_code++;
+            }
+        }
+        ancien = courant;
+    }
+    memset(indices + ecrits, 0, nb_pixels - ecrits);
+    return true;
+}
+
+/**
+ * @brief Décode la première image d'un fichier GIF (87a ou 89a, entrelacé ou non).
+ * @param img Reçoit l'image, à la taille de l'écran logique du GIF.
+ * @return false si le fichier est illisible ou n'est pas un GIF.
+ */
+bool image_chargerGif(Image *img, const char *chemin) {
+    FILE *f = fopen(chemin, "rb");
+    unsigned char *octets = NULL, *flux = NULL, *indices = NULL;
+    unsigned char palette[256][3] = {{0}};
+    bool ok = false;
+    long taille;
+
+    if (f == NULL) {
+        fprintf(stderr, "Erreur: impossible d'ouvrir %s.\n", chemin);
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    taille = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    octets = malloc((size_t) (taille > 0 ? taille : 1));
+    if (octets == NULL || fread(octets, 1, (size_t) taille, f) != (size_t) taille || taille < 13
+        || (memcmp(octets, "GIF87a", 6) != 0 && memcmp(octets, "GIF89a", 6) != 0)) {
+        goto fin;
+    }
+
+    const unsigned char *p = octets + 13, *bout = octets + taille;
+    int largeur = octets[6] | octets[7] << 8, hauteur = octets[8] | octets[9] << 8;
+    if (octets[10] & 0x80) {
+        int nb_couleurs = 2 << (octets[10] & 7);
+        if (p + 3 * nb_couleurs > bout) {
+            goto fin;
+        }
+        memcpy(palette, p, (size_t) nb_couleurs * 3);
+        p += 3 * nb_couleurs;
+    }
+    if (largeur <= 0 || hauteur <= 0 || !image_creer(img, largeur, hauteur)) {
+        goto fin;
+    }
+    for (int i = 0; i < largeur * hauteur; i++) {
+        memcpy(&img->rgb[(size_t) i * 3], palette[octets[11]], 3);
+    }
+
+    while (p < bout && *p != 0x3B) {
+        if (*p == 0x21) {    //Extension : ignorée.
+            p += 2;
+            while (p < bout && *p != 0) {
+                p += *p + 1;
+            }
+            p++;
+        } else if (*p == 0x2C && p + 11 <= bout) {
+            int gauche = p[1] | p[2] << 8, haut = p[3] | p[4] << 8;
+            int l = p[5] | p[6] << 8, h = p[7] | p[8] << 8;
+            bool entrelacee = p[9] & 0x40;
+            unsigned char (*couleurs)[3] = palette, locale[256][3];
+            if (p[9] & 0x80) {
+                int nb_couleurs = 2 << (p[9] & 7);
+                if (p + 10 + 3 * nb_couleurs >= bout) {    //La palette doit être suivie de la taille minimale des codes.
+                    goto fin;
+                }
+                memcpy(locale, p + 10, (size_t) nb_couleurs * 3);
+                couleurs = locale;
+                p += 3 * nb_couleurs;
+            }
+            p += 10;
+            int taille_min = *p++;
+            size_t taille_flux = 0;
+            flux = malloc((size_t) (bout - p));
+            indices = malloc((size_t) l * h + 1);
+            if (flux == NULL || indices == NULL) {
+                goto fin;
+            }
+            while (p < bout && *p != 0 && p + *p < bout) {
+                memcpy(flux + taille_flux, p + 1, *p);
+                taille_flux += *p;
+                p += *p + 1;
+            }
+            if (!decoderLzw(flux, taille_flux, taille_min, indices, (size_t) l * h)) {
+                goto fin;
+            }
+            //Ordre des lignes d'une image entrelacée : une sur 8 à partir de 0, puis de 4, une sur 4 à partir de 2, une sur 2 à partir de 1.
+            static const int debut_passe[] = {0, 4, 2, 1}, pas_passe[] = {8, 8, 4, 2};
+            int ligne = 0;
+            for (int passe = 0; passe < (entrelacee ? 4 : 1); passe++) {
+                int debut = entrelacee ? debut_passe[passe] : 0, pas = entrelacee ? pas_passe[passe] : 1;
+                for (int y = debut; y < h; y += pas, ligne++) {
+                    for (int x = 0; x < l; x++) {
+                        colorier(img, gauche + x, haut + y, couleurs[indices[(size_t) ligne * l + x]]);
+                    }
+                }
+            }
+            ok = true;
+            break;
+        } else {
+            break;
+        }
+    }
+
+fin:
+    if (!ok) {
+        fprintf(stderr, "Erreur: %s n'est pas un GIF lisible.\n", chemin);
+    }
+    free(indices);
+    free(flux);
+    free(octets);
+    fclose(f);
+    return ok;
+}
+
+/**
+ * @brief Ecrit l'image au format PPM binaire (P6).
+ */
+bool image_ecrirePpm(const Image *img, const char *chemin) {
+    FILE *f = fopen(chemin, "wb");
+    bool ok;
+
+    if (f == NULL) {
+        fprintf(stderr, "Erreur: impossible d'écrire %s.\n", chemin);
+        return false;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", img->largeur, img->hauteur);
+    ok = fwrite(img->rgb, 3, (size_t) img->largeur * img->hauteur, f) == (size_t) img->largeur * img->hauteur;
+    return (fclose(f) == 0) && ok;
+}
+
+static void ecrireEntier32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char) (v >> 24);
+    p[1] = (unsigned char) (v >> 16);
+    p[2] = (unsigned char) (v >> 8);
+    p[3] = (unsigned char) v;
+}
+
+/**
+ * @brief Ecrit un bloc PNG : longueur, type, données et CRC du type et des données.
+ */
+static void ecrireBlocPng(FILE *f, const uint32_t crc_table[256], const char type[4], const unsigned char *donnees, size_t taille) {
+    unsigned char entier[4];
+    uint32_t crc = 0xFFFFFFFFu;
+
+    ecrireEntier32(entier, (uint32_t) taille);
+    fwrite(entier, 1, 4, f);
+    fwrite(type, 1, 4, f);
+    fwrite(donnees, 1, taille, f);
+    for (int i = 0; i < 4; i++) {
+        crc = crc_table[(crc ^ (unsigned char) type[i]) & 0xFF] ^ (crc >> 8);
+    }
+    for (size_t i = 0; i < taille; i++) {
+        crc = crc_table[(crc ^ donnees[i]) & 0xFF] ^ (crc >> 8);
+    }
+    ecrireEntier32(entier, crc ^ 0xFFFFFFFFu);
+    fwrite(entier, 1, 4, f);
+}
+
+/**
+ * @brief Ecrit l'image au format PNG, sans bibliothèque externe : les lignes (filtre 0) sont rangées dans des
+ * blocs zlib non compressés. Le fichier est un peu plus gros qu'un PNG compressé, mais l'écriture est immédiate.
+ */
+bool image_ecrirePng(const Image *img, const char *chemin) {
+    static const unsigned char signature[8] = {137, 'P', 'N', 'G', '\r', '\n', 26, '\n'};
+    const size_t taille_ligne = (size_t) img->largeur * 3 + 1;
+    const size_t taille_brute = taille_ligne * img->hauteur;
+    const size_t nb_blocs = taille_brute / 65535 + 1;
+    uint32_t crc_table[256], adler_a = 1, adler_b = 0;
+    unsigned char entete[13], *brut, *zlib, *p;
+    FILE *f;
+    bool ok;
+
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        crc_table[n] = c;
+    }
+    brut = malloc(taille_brute);
+    zlib = malloc(2 + taille_brute + 5 * nb_blocs + 4);
+    if (brut == NULL || zlib == NULL) {
+        free(brut);
+        free(zlib);
+        return false;
+    }
+    for (int y = 0; y < img->hauteur; y++) {
+        brut[y * taille_ligne] = 0;
+        memcpy(&brut[y * taille_ligne + 1], &img->rgb[(size_t) y * (taille_ligne - 1)], taille_ligne - 1);
+    }
+    //Adler-32 : la réduction modulo 65521 peut attendre 5552 octets sans dépasser 32 bits.
+    for (size_t i = 0; i < taille_brute; ) {
+        size_t fin = (taille_brute - i > 5552) ? i + 5552 : taille_brute;
+        for (; i < fin; i++) {
+            adler_a += brut[i];
+            adler_b += adler_a;
+        }
+        adler_a %= 65521;
+        adler_b %= 65521;
+    }
+
+    p = zlib;
+    *p++ = 0x78;
+    *p++ = 0x01;
+    for (size_t b = 0, position = 0; b < nb_blocs; b++) {
+        size_t taille = (taille_brute - position > 65535) ? 65535 : taille_brute - position;
+        *p++ = (b == nb_blocs - 1) ? 1 : 0;
+        *p++ = (unsigned char) taille;
+        *p++ = (unsigned char) (taille >> 8);
+        *p++ = (unsigned char) ~taille;
+        *p++ = (unsigned char) (~taille >> 8);
+        memcpy(p, &brut[position], taille);
+        p += taille;
+        position += taille;
+    }
+    ecrireEntier32(p, adler_b << 16 | adler_a);
+    p += 4;
+    free(brut);
+
+    f = fopen(chemin, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "Erreur: impossible d'écrire %s.\n", chemin);
+        free(zlib);
+        return false;
+    }
+    ecrireEntier32(entete, (uint32_t) img->largeur);
+    ecrireEntier32(entete + 4, (uint32_t) img->hauteur);
+    entete[8] = 8;     //8 bits par composante
+    entete[9] = 2;     //RGB
+    entete[10] = entete[11] = entete[12] = 0;
+    fwrite(signature, 1, sizeof(signature), f);
+    ecrireBlocPng(f, crc_table, "IHDR", entete, sizeof(entete));
+    ecrireBlocPng(f, crc_table, "IDAT", zlib, (size_t) (p - zlib));
+    ecrireBlocPng(f, crc_table, "IEND", NULL, 0);
+    ok = !ferror(f);
+    free(zlib);
+    return (fclose(f) == 0) && ok;
+}
+
+/**
+ * @brief Colonne et ligne du pixel qui contient le point (x,y) du repère turtle.
+ */
+static void versPixel(const Image *img, double x, double y, double *px, double *py) {
+    *px = img->largeur / 2 + x;
+    *py = img->hauteur / 2 - y;
+}
+
+/**
+ * @brief Remplit le rectangle [x0,x1]x[y0,y1] du repère turtle.
+ */
+static void remplirRectangle(Image *img, double x0, double y0, double x1, double y1, const unsigned char couleur[3]) {
+    double px0, py0, px1, py1;
+    versPixel(img, x0, y1, &px0, &py0);
+    versPixel(img, x1, y0, &px1, &py1);
+    for (int py = (int) floor(py0); py < (int) ceil(py1); py++) {
+        for (int px = (int) floor(px0); px < (int) ceil(px1); px++) {
+            colorier(img, px, py, couleur);
+        }
+    }
+}
+
+static void disque(Image *img, double x, double y, double r, const unsigned char couleur[3]) {
+    double cx, cy;
+    versPixel(img, x, y, &cx, &cy);
+    for (int py = (int) floor(cy - r); py <= (int) ceil(cy + r); py++) {
+        for (int px = (int) floor(cx - r); px <= (int) ceil(cx + r); px++) {
+            double dx = px + 0.5 - cx, dy = py + 0.5 - cy;
+            if (dx * dx + dy * dy <= r * r) {
+                colorier(img, px, py, couleur);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Ecrit un entier avec une police de 3x5 pixels agrandie 2 fois, centré en x et posé sur y, comme
+ * tl.write(n, align='center').
+ */
+static void ecrireNombre(Image *img, double x, double y, int n, const unsigned char couleur[3]) {
+    //Chaque glyphe : 5 lignes de 3 bits, de haut en bas ; le dernier est le signe moins.
+    static const uint16_t glyphes[11] = {
+        075557, 026227, 071747, 071717, 055711, 074717, 074757, 071111, 075757, 075717, 000700
+    };
+    const int echelle = 2;
+    char texte[16];
+    double px, py;
+    int longueur = snprintf(texte, sizeof(texte), "%d", n);
+
+    versPixel(img, x, y, &px, &py);
+    int gauche = (int) floor(px) - (longueur * 4 * echelle - echelle) / 2;
+    int haut = (int) floor(py) - 5 * echelle;
+    for (int i = 0; i < longueur; i++) {
+        uint16_t g = glyphes[(texte[i] == '-') ? 10 : texte[i] - '0'];
+        for (int ligne = 0; ligne < 5 * echelle; ligne++) {
+            for (int colonne = 0; colonne < 3 * echelle; colonne++) {
+                if (g >> (3 * (4 - ligne / echelle) + 2 - colonne / echelle) & 1) {
+                    colorier(img, gauche + i * 4 * echelle + colonne, haut + ligne, couleur);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Dessine la scène comme initialisation et boule de modelisation.py : le fond centré, le contour vert
+ * de 20 pixels, les graduations tous les 50 pixels et les boules.
+ * @param img Reçoit la scène ; elle est (re)dimensionnée à la taille de la fenêtre turtle.
+ * @param fond Fond .gif, ou NULL pour un fond blanc.
+ * @param scene Environnement modélisé.
+ * @return false si la mémoire manque.
+ */
+bool rendu_scene(Image *img, const Image *fond, const Scene *scene) {
+    const int cx = scene->coin_HD[0], cy = scene->coin_HD[1];
+
+    if (!image_creer(img, 2 * cx + 50, 2 * cy + 50)) {
+        return false;
+    }
+    for (int i = 0; i < img->largeur * img->hauteur; i++) {
+        memcpy(&img->rgb[(size_t) i * 3], BLANC, 3);
+    }
+    if (fond != NULL && fond->rgb != NULL) {
+        int gauche = (img->largeur - fond->largeur) / 2, haut = (img->hauteur - fond->hauteur) / 2;
+        for (int y = 0; y < fond->hauteur; y++) {
+            for (int x = 0; x < fond->largeur; x++) {
+                colorier(img, gauche + x, haut + y, &fond->rgb[((size_t) y * fond->largeur + x) * 3]);
+            }
+        }
+    }
+
+    //Contour : carré de côté 2*cx+10 centré, tracé avec un stylo de 20 pixels.
+    remplirRectangle(img, -cx - 15, cy - 5, cx + 15, cy + 15, VERT_FONCE);
+    remplirRectangle(img, -cx - 15, -cy - 15, cx + 15, -cy + 5, VERT_FONCE);
+    remplirRectangle(img, -cx - 15, -cy - 15, -cx + 5, cy + 15, VERT_FONCE);
+    remplirRectangle(img, cx - 5, -cy - 15, cx + 15, cy + 15, VERT_FONCE);
+
+    for (int x = -cx - 5; x < cx; x += 50) {
+        ecrireNombre(img, x, -cy - 10, x + 5, ROUGE);
+    }
+    for (int y = -cy + 45; y < cy; y += 50) {
+        ecrireNombre(img, -cx - 2.5, y, y + 5, ROUGE);
+    }
+
+    for (int c = COULEUR_BLEU; c <= COULEUR_ORANGE; c++) {
+        const BouleScene *b = &scene->boules[c];
+        if (b->rayon > 0) {
+            disque(img, b->milieu[0], b->milieu[1], b->rayon, COULEUR_BOULE[c]);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Trace un segment de la trajectoire du robot, d'un pixel d'épaisseur. A la signature de
+ * TraceurSimulation : simulation_tracer(&sim, rendu_segment, &img).
+ * @param image Image (Image *) où tracer.
+ */
+void rendu_segment(void *image, double x0, double y0, double x1, double y1) {
+    Image *img = image;
+    double px0, py0, px1, py1;
+
+    versPixel(img, x0, y0, &px0, &py0);
+    versPixel(img, x1, y1, &px1, &py1);
+    int n = (int) ceil(fmax(fabs(px1 - px0), fabs(py1 - py0)));
+    for (int i = 0; i <= n; i++) {
+        double t = (n == 0) ? 0.0 : (double) i / n;
+        colorier(img, (int) floor(px0 + t * (px1 - px0)), (int) floor(py0 + t * (py1 - py0)), AQUA);
+    }
+}
+
+/**
+ * @brief Dessine le robot : la flèche "classic" de turtle agrandie 2 fois (tl.shapesize(2, 2)), pointée
+ * selon l'orientation de la pose.
+ */
+void rendu_robot(Image *img, const Pose *pose) {
+    //Sommets de la forme "classic" de turtle ; l'axe y local est l'orientation du robot.
+    static const double forme[4][2] = {{0, 0}, {-5, -9}, {0, -7}, {5, -9}};
+    double px[4], py[4], xmin = INFINITY, xmax = -INFINITY, ymin = INFINITY, ymax = -INFINITY;
+
+    for (int i = 0; i < 4; i++) {
+        double lx = 2 * forme[i][0], ly = 2 * forme[i][1];
+        versPixel(img, pose->x + pose->oy * lx + pose->ox * ly, pose->y - pose->ox * lx + pose->oy * ly, &px[i], &py[i]);
+        xmin = fmin(xmin, px[i]);
+        xmax = fmax(xmax, px[i]);
+        ymin = fmin(ymin, py[i]);
+        ymax = fmax(ymax, py[i]);
+    }
+    for (int y = (int) floor(ymin); y <= (int) ceil(ymax); y++) {
+        for (int x = (int) floor(xmin); x <= (int) ceil(xmax); x++) {
+            double cx = x + 0.5, cy = y + 0.5;
+            bool dedans = false;
+            for (int i = 0, j = 3; i < 4; j = i++) {
+                if ((py[i] > cy) != (py[j] > cy)
+                    && cx < px[j] + (cy - py[j]) * (px[i] - px[j]) / (py[i] - py[j])) {
+                    dedans = !dedans;
+                }
+            }
+            if (dedans) {
+                colorier(img, x, y, AQUA);
+            }
+        }
+    }
+}
+
+/**
+ * @}
+ */
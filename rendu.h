@@ -0,0 +1,34 @@
+/**
+ * @file
+ * @brief Ce fichier contient les déclarations du rendu sans fenêtre.
+ * Il dessine dans une image en mémoire ce que modelisation.py affiche avec turtle : le fond .gif, le contour et
+ * les graduations, les boules détectées et la trajectoire du robot, puis l'écrit en PPM ou en PNG.
+ */
+
+#ifndef RENDU_H
+#define RENDU_H
+
+#include <stdbool.h>
+#include "simulation.h"
+
+/**
+ * @brief Image RGB en mémoire, 3 octets par pixel, ligne par ligne depuis le haut.
+ * Une Image initialisée à zéro est vide ; image_creer la (re)dimensionne.
+ */
+typedef struct {
+    int largeur, hauteur;
+    unsigned char *rgb;
+} Image;
+
+bool image_creer(Image *img, int largeur, int hauteur);
+void image_detruire(Image *img);
+bool image_copier(Image *destination, const Image *source);
+bool image_chargerGif(Image *img, const char *chemin);
+bool image_ecrirePpm(const Image *img, const char *chemin);
+bool image_ecrirePng(const Image *img, const char *chemin);
+
+bool rendu_scene(Image *img, const Image *fond, const Scene *scene);
+void rendu_segment(void *image, double x0, double y0, double x1, double y1);
+void rendu_robot(Image *img, const Pose *pose);
+
+#endif
@@ -0,0 +1,457 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <errno.h>
+#include "simulation.h"
+#include "trajectoire.h"
+
+/**
+ * @file
+ * @brief Ce fichier rassemble les fonctions du simulateur cinématique.
+ */
+
+/**
+ * @defgroup simulation Simulation cinématique
+ * @brief Exécution des commandes du robot sans Python Turtle, avec les mêmes positions finales.
+ * Les calculs suivent ceux de turtle (CPython 3.11) dans le même ordre : Vec2D.rotate pour les rotations,
+ * position + orientation * distance pour les déplacements, heading et towards arrondis à 10 décimales, et
+ * math.hypot pour les distances.
+ * @{
+ */
+
+#define PI_PYTHON 3.14159265358979323846    //Py_MATH_PI, utilisé par math.radians et math.degrees.
+
+/**
+ * @brief Modulo de Python sur les flottants : le résultat a le signe du diviseur.
+ */
+static double moduloPython(double a, double b) {
+    double mod = fmod(a, b);
+    if (mod != 0.0) {
+        if ((b < 0) != (mod < 0)) {
+            mod += b;
+        }
+    } else {
+        mod = copysign(0.0, b);
+    }
+    return mod;
+}
+
+/**
+ * @brief round(x, 10) de Python : arrondi décimal correct, puis relecture du nombre arrondi.
+ */
+static double arrondi10(double x) {
+    char texte[64];
+    snprintf(texte, sizeof(texte), "%.10f", x);
+    return strtod(texte, NULL);
+}
+
+/**
+ * @brief Angle en degrés de (x,y), dans [0,360[, comme heading() et towards() de turtle en mode "standard".
+ */
+static double angleTurtle(double x, double y) {
+    double resultat = moduloPython(arrondi10(atan2(y, x) * (180.0 / PI_PYTHON)), 360.0);
+    return moduloPython(resultat, 360.0);
+}
+
+/**
+ * @brief Produit exact de deux flottants, sous forme de somme hi + lo (Dekker, sans FMA).
+ */
+static void produitExact(double a, double b, double *hi, double *lo) {
+    double ta = a * 134217729.0, tb = b * 134217729.0;    //Constante de Veltkamp : 2^27 + 1.
+    double a_hi = ta - (ta - a), a_lo = a - a_hi;
+    double b_hi = tb - (tb - b), b_lo = b - b_hi;
+    double p = a_hi * b_hi;
+    double q = a_hi * b_lo + a_lo * b_hi;
+    *hi = p + q;
+    *lo = p - *hi + q + a_lo * b_lo;
+}
+
+/**
+ * @brief math.hypot de CPython 3.11 (vector_norm) pour deux coordonnées : plus précis que hypot de la libm,
+ * dont le dernier bit diffère parfois.
+ */
+static double hypotPython(double x, double y) {
+    double ax = fabs(x), ay = fabs(y);
+    double max = (ax > ay) ? ax : ay;
+    double somme = 1.0, frac1 = 0.0, frac2 = 0.0, hi, lo, s, h, echelle;
+    const double composantes[2] = {ax, ay};
+    int exposant;
+
+    if (isinf(max)) {
+        return max;
+    }
+    if (isnan(x) || isnan(y)) {
+        return NAN;
+    }
+    if (max == 0.0) {
+        return max;
+    }
+    frexp(max, &exposant);
+    echelle = ldexp(1.0, -exposant);
+    for (int i = 0; i < 2; i++) {
+        produitExact(composantes[i] * echelle, composantes[i] * echelle, &hi, &lo);
+        s = somme + hi;
+        frac1 += lo;
+        frac2 += (somme - s) + hi;
+        somme = s;
+    }
+    h = sqrt(somme - 1.0 + (frac1 + frac2));
+    produitExact(-h, h, &hi, &lo);
+    s = somme + hi;
+    frac1 += lo;
+    frac2 += (somme - s) + hi;
+    somme = s;
+    h += (somme - 1.0 + (frac1 + frac2)) / (2.0 * h);
+    return h / echelle;
+}
+
+/**
+ * @brief Avance l'horloge du nombre de pas que dure un mouvement, attend si le facteur de temps réel n'est pas nul
+ * que le temps réel ait rattrapé le temps simulé, puis enregistre la nouvelle pose dans le journal. L'attente vise
+ * un instant absolu depuis le départ : les retards ne s'accumulent pas d'un mouvement à l'autre.
+ */
+static void ecouler(Simulation *sim, double distance, double angle) {
+    const ParametresHorloge *h = &sim->horloge;
+    double duree = fabs(distance) / h->vitesse_lineaire + fabs(angle) / h->vitesse_angulaire;
+
+    if (duree > 0.0) {
+        sim->pas += (long long) ceil(duree / h->pas - 1e-9);
+        sim->temps = sim->pas * h->pas;
+    }
+    if (h->facteur > 0.0) {
+        double reel = sim->temps / h->facteur;
+        struct timespec reveil = sim->reveil;
+        long long secondes = (long long) reel;
+        reveil.tv_sec += secondes;
+        reveil.tv_nsec += (long) ((reel - secondes) * 1e9);
+        if (reveil.tv_nsec >= 1000000000L) {
+            reveil.tv_sec++;
+            reveil.tv_nsec -= 1000000000L;
+        }
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &reveil, NULL) == EINTR) {
+        }
+    }
+    if (sim->journal != NULL) {
+        journal_pose(sim->journal, sim->pas, &sim->pose);
+    }
+}
+
+/**
+ * @brief tl.goto(x, y) : le segment parcouru est transmis au traceur. Avec une carte, le robot s'arrête devant le
+ * premier obstacle du segment.
+ */
+static void placer(Simulation *sim, double x, double y) {
+    double fraction;
+
+    if (sim->carte != NULL && carte_collision(sim->carte, sim->pose.x, sim->pose.y, x, y, &fraction)) {
+        x = sim->pose.x + (x - sim->pose.x) * fraction;
+        y = sim->pose.y + (y - sim->pose.y) * fraction;
+        sim->collisions++;
+    }
+    if (sim->traceur != NULL) {
+        sim->traceur(sim->contexte, sim->pose.x, sim->pose.y, x, y);
+    }
+    double distance = hypot(x - sim->pose.x, y - sim->pose.y);
+    sim->pose.x = x;
+    sim->pose.y = y;
+    ecouler(sim, distance, 0.0);
+}
+
+/**
+ * @brief tl.forward(d) : déplacement de d selon l'orientation (d < 0 pour tl.backward).
+ */
+static void deplacer(Simulation *sim, double d) {
+    placer(sim, sim->pose.x + sim->pose.ox * d, sim->pose.y + sim->pose.oy * d);
+}
+
+/**
+ * @brief Vec2D.rotate : rotation de l'orientation de angle degrés dans le sens trigonométrique.
+ */
+static void tourner(Pose *p, double angle) {
+    double a = angle * (PI_PYTHON / 180.0);
+    double c = cos(a), s = sin(a);
+    double ox = p->ox * c + (-p->oy) * s;
+    double oy = p->oy * c + p->ox * s;
+    p->ox = ox;
+    p->oy = oy;
+}
+
+/**
+ * @brief tl.setheading(cap) en mode "standard".
+ * @return Angle tourné.
+ */
+static double orienter(Pose *p, double cap) {
+    double angle = cap - angleTurtle(p->ox, p->oy);
+    angle = moduloPython(angle + 180.0, 360.0) - 180.0;
+    tourner(p, angle);
+    return angle;
+}
+
+/**
+ * @brief Rotation du robot pendant la simulation (tl.left), qui prend du temps et est enregistrée.
+ */
+static void pivoter(Simulation *sim, double angle) {
+    tourner(&sim->pose, angle);
+    ecouler(sim, 0.0, angle);
+}
+
+/**
+ * @brief Replace le robot dans l'arène s'il en est sorti, comme à la fin de avancer et reculer.
+ */
+static void borner(Simulation *sim) {
+    if (sim->pose.x > ARENE_DEMI_COTE) {
+        placer(sim, ARENE_DEMI_COTE, sim->pose.y);
+    }
+    if (sim->pose.x < -ARENE_DEMI_COTE) {
+        placer(sim, -ARENE_DEMI_COTE, sim->pose.y);
+    }
+    if (sim->pose.y > ARENE_DEMI_COTE) {
+        placer(sim, sim->pose.x, ARENE_DEMI_COTE);
+    }
+    if (sim->pose.y < -ARENE_DEMI_COTE) {
+        placer(sim, sim->pose.x, -ARENE_DEMI_COTE);
+    }
+}
+
+/**
+ * @brief parcourir de modelisation.py : déplacement de d en ligne droite, arrêté au bord de l'arène. L'intersection
+ * avec le bord est calculée directement, avec les mêmes opérations que Python : la direction est tirée du cap
+ * arrondi de tl.heading(), puis le robot avance d'un seul tl.forward.
+ * @param sens 1 pour avancer, -1 pour reculer.
+ */
+static void parcourir(Simulation *sim, double d, double sens) {
+    const Pose *p = &sim->pose;
+
+    if (d > 0 && -ARENE_DEMI_COTE <= p->x && p->x <= ARENE_DEMI_COTE && -ARENE_DEMI_COTE <= p->y && p->y <= ARENE_DEMI_COTE) {
+        double a = simulation_cap(sim) * (PI_PYTHON / 180.0);
+        double ux = sens * cos(a), uy = sens * sin(a);
+        double limite = d;
+        if (ux > 0) {
+            limite = fmin(limite, (ARENE_DEMI_COTE - p->x) / ux);
+        } else if (ux < 0) {
+            limite = fmin(limite, (-ARENE_DEMI_COTE - p->x) / ux);
+        }
+        if (uy > 0) {
+            limite = fmin(limite, (ARENE_DEMI_COTE - p->y) / uy);
+        } else if (uy < 0) {
+            limite = fmin(limite, (-ARENE_DEMI_COTE - p->y) / uy);
+        }
+        deplacer(sim, sens * limite);
+    }
+    borner(sim);
+}
+
+/**
+ * @brief Place le robot comme modelisation.py à la réception d'un message de modeliserActions : initialisation, boule pour chaque
+ * boule de la scène, puis set_robot_position(0,-(coin_HD[1]-10),90). Seules les rotations de ces fonctions
+ * changent la pose finale, elles sont donc rejouées à l'identique.
+ * @param sim Simulation à initialiser.
+ * @param scene Environnement modélisé ; il est copié.
+ */
+void simulation_initialiser(Simulation *sim, const Scene *scene) {
+    Pose *p = &sim->pose;
+
+    sim->scene = *scene;
+    sim->traceur = NULL;
+    sim->contexte = NULL;
+    sim->carte = NULL;
+    sim->collisions = 0;
+    sim->horloge = (ParametresHorloge) {HORLOGE_PAS, HORLOGE_VITESSE_LINEAIRE, HORLOGE_VITESSE_ANGULAIRE, 0.0};
+    sim->pas = 0;
+    sim->temps = 0.0;
+    sim->reveil = (struct timespec) {0, 0};
+    sim->journal = NULL;
+    *p = (Pose) {0.0, 0.0, 1.0, 0.0};
+
+    //initialisation : tl.right(90), puis tl.right(90) après chacun des quatre côtés du contour.
+    for (int i = 0; i < 5; i++) {
+        tourner(p, -90.0);
+    }
+    //boule : tl.circle(r), un polygone dont chaque sommet tourne l'orientation.
+    for (int c = COULEUR_BLEU; c <= COULEUR_ORANGE; c++) {
+        int rayon = scene->boules[c].rayon;
+        if (rayon > 0) {
+            int pas = 1 + (int) fmin(11 + rayon / 6.0, 59.0);
+            double w = 360.0 / pas;
+            tourner(p, 0.5 * w);
+            for (int i = 0; i < pas; i++) {
+                tourner(p, w);
+            }
+            tourner(p, -(0.5 * w));
+        }
+    }
+    p->x = 0;
+    p->y = -(scene->coin_HD[1] - 10);
+    orienter(p, 90.0);
+}
+
+/**
+ * @brief Cap du robot en degrés dans [0,360[, comme tl.heading().
+ */
+double simulation_cap(const Simulation *sim) {
+    return angleTurtle(sim->pose.ox, sim->pose.oy);
+}
+
+/**
+ * @brief Transmet à traceur chaque segment parcouru à partir de maintenant (le stylo est baissé après
+ * set_robot_position), y compris les retours dans l'arène.
+ * @param traceur Fonction appelée pour chaque segment, ou NULL pour ne plus tracer.
+ * @param contexte Passé au traceur.
+ */
+void simulation_tracer(Simulation *sim, TraceurSimulation traceur, void *contexte) {
+    sim->traceur = traceur;
+    sim->contexte = contexte;
+}
+
+/**
+ * @brief Construit la carte des obstacles d'une scène : ses boules, sur l'arène et l'image entières.
+ * @return false si la mémoire manque.
+ */
+bool simulation_construireCarte(Carte *carte, const Scene *scene) {
+    int demi_largeur = (scene->coin_HD[0] > ARENE_DEMI_COTE) ? scene->coin_HD[0] : ARENE_DEMI_COTE;
+    int demi_hauteur = (scene->coin_HD[1] > ARENE_DEMI_COTE) ? scene->coin_HD[1] : ARENE_DEMI_COTE;
+
+    if (!carte_creer(carte, demi_largeur + 1, demi_hauteur + 1)) {
+        return false;
+    }
+    for (int c = COULEUR_BLEU; c <= COULEUR_ORANGE; c++) {
+        carte_ajouterBoule(carte, &scene->boules[c]);
+    }
+    if (!carte_calculerDistances(carte)) {
+        carte_detruire(carte);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Arrête désormais le robot devant les obstacles de la carte (NULL pour les traverser, comme turtle).
+ * La boule visée par gobj ou contobj n'est pas exemptée : le robot s'arrête à son bord ou la longe à la distance
+ * de son rayon, ce qui reste dans la pénétration tolérée par la carte (CARTE_TOLERANCE).
+ */
+void simulation_obstacles(Simulation *sim, const Carte *carte) {
+    sim->carte = carte;
+}
+
+/**
+ * @brief Enregistre désormais les commandes exécutées et chaque pose du robot dans le journal (NULL pour arrêter).
+ * L'entête de la simulation est écrit par journal_commencer, la fin par journal_terminer.
+ */
+void simulation_journaliser(Simulation *sim, JournalTrajectoire *journal) {
+    sim->journal = journal;
+}
+
+/**
+ * @brief Change l'horloge des mouvements, et fixe le départ du temps réel à maintenant.
+ */
+void simulation_horloge(Simulation *sim, const ParametresHorloge *horloge) {
+    sim->horloge = *horloge;
+    if (horloge->facteur > 0.0) {
+        clock_gettime(CLOCK_MONOTONIC, &sim->reveil);
+    }
+}
+
+/**
+ * @brief tl.left(angle) ; tl.right(angle) correspond à un angle négatif.
+ */
+void simulation_tourner(Simulation *sim, double angle) {
+    pivoter(sim, angle);
+}
+
+/**
+ * @brief avancer(d) de modelisation.py.
+ */
+void simulation_avancer(Simulation *sim, double d) {
+    parcourir(sim, d, 1.0);
+}
+
+/**
+ * @brief reculer(d) de modelisation.py.
+ */
+void simulation_reculer(Simulation *sim, double d) {
+    parcourir(sim, d, -1.0);
+}
+
+/**
+ * @brief tl.forward(d), sans arrêt au bord de l'arène.
+ */
+void simulation_ligne(Simulation *sim, double d) {
+    deplacer(sim, d);
+}
+
+/**
+ * @brief gobj de modelisation.py : s'oriente vers la boule de la couleur et avance jusqu'à son bord.
+ * Sans effet si la boule n'est pas dans la scène.
+ */
+void simulation_allerObjet(Simulation *sim, int couleur) {
+    const BouleScene *b = &sim->scene.boules[couleur];
+    Pose *p = &sim->pose;
+
+    if (b->rayon <= 0) {
+        return;
+    }
+    ecouler(sim, 0.0, orienter(p, angleTurtle(b->milieu[0] - p->x, b->milieu[1] - p->y)));
+    deplacer(sim, hypotPython(b->milieu[0] - p->x, b->milieu[1] - p->y) - b->rayon);
+}
+
+/**
+ * @brief contobj de modelisation.py : va jusqu'à la boule puis la contourne, par la droite si sens vaut 1 et
+ * par la gauche si sens vaut -1. Sans effet si la boule n'est pas dans la scène.
+ */
+void simulation_contourner(Simulation *sim, int couleur, int sens) {
+    int r = sim->scene.boules[couleur].rayon;
+
+    if (r <= 0) {
+        return;
+    }
+    simulation_allerObjet(sim, couleur);
+    pivoter(sim, -(sens * 90));
+    deplacer(sim, r);
+    pivoter(sim, sens * 90);
+    deplacer(sim, 2 * r);
+    pivoter(sim, sens * 90);
+    deplacer(sim, r);
+    pivoter(sim, -(sens * 90));
+}
+
+/**
+ * @brief Exécute une suite de commandes. Les commandes d'affichage (COMMANDE_COMPTER, COMMANDE_OBJET_INEXISTANT)
+ * ne changent pas la pose et sont ignorées.
+ */
+void simulation_executer(Simulation *sim, const Commande *commandes, int nb_commandes) {
+    for (int i = 0; i < nb_commandes; i++) {
+        const Commande *c = &commandes[i];
+        if (sim->journal != NULL) {
+            journal_commande(sim->journal, c);
+        }
+        switch (c->opcode) {
+            case COMMANDE_GAUCHE:
+                simulation_tourner(sim, c->valeur);
+                break;
+            case COMMANDE_DROITE:
+                simulation_tourner(sim, -c->valeur);
+                break;
+            case COMMANDE_AVANCER:
+                simulation_avancer(sim, c->valeur);
+                break;
+            case COMMANDE_RECULER:
+                simulation_reculer(sim, c->valeur);
+                break;
+            case COMMANDE_ALLER_OBJET:
+                simulation_allerObjet(sim, c->couleur);
+                break;
+            case COMMANDE_CONTOURNER:
+                simulation_contourner(sim, c->couleur, c->sens);
+                break;
+            case COMMANDE_LIGNE:
+                simulation_ligne(sim, c->valeur);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,67 @@
+/**
+ * @file
+ * @brief Ce fichier contient les déclarations du simulateur cinématique.
+ * Il exécute les commandes du robot sans Python : chaque primitive de modelisation.py (avancer, reculer, gobj,
+ * contobj, tl.left, tl.right) est reproduite opération par opération, avec les mêmes calculs flottants que le
+ * module turtle, pour obtenir exactement la même position finale.
+ */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <time.h>
+#include "traitementCommande.h"
+#include "carte.h"
+
+#define ARENE_DEMI_COTE 150    //Le robot est maintenu dans le carré [-150,150]x[-150,150] de modelisation.py.
+
+/**
+ * @brief Pose du robot, représentée comme dans turtle : une position et un vecteur d'orientation unitaire.
+ */
+typedef struct {
+    double x, y;        /**< Position. */
+    double ox, oy;      /**< Orientation (vaut (cos cap, sin cap) aux erreurs d'arrondi près). */
+} Pose;
+
+/**
+ * @brief Fonction appelée pour chaque segment parcouru par le robot, comme le tracé du stylo de turtle.
+ */
+typedef void (*TraceurSimulation)(void *contexte, double x0, double y0, double x1, double y1);
+
+typedef struct JournalTrajectoire JournalTrajectoire;    //Voir trajectoire.h.
+
+/**
+ * @brief État d'une simulation : la scène, la pose du robot, le traceur éventuel de sa trajectoire, la carte
+ * éventuelle des obstacles qui l'arrêtent, son horloge et le journal éventuel de ses mouvements.
+ */
+typedef struct {
+    Scene scene;
+    Pose pose;
+    TraceurSimulation traceur;    /**< NULL si la trajectoire n'est pas tracée. */
+    void *contexte;               /**< Passé au traceur. */
+    const Carte *carte;           /**< NULL si les boules ne sont pas des obstacles, comme dans modelisation.py. */
+    int collisions;               /**< Nombre de déplacements arrêtés par un obstacle. */
+    ParametresHorloge horloge;    /**< Aussi vite que possible par défaut. */
+    long long pas;                /**< Pas d'horloge écoulés depuis le départ. */
+    double temps;                 /**< Durée simulée des mouvements depuis le départ, en secondes (pas * horloge.pas). */
+    struct timespec reveil;       /**< Instant réel du départ, si le facteur de temps réel n'est pas nul. */
+    JournalTrajectoire *journal;  /**< NULL si la simulation n'est pas enregistrée. */
+} Simulation;
+
+void simulation_initialiser(Simulation *sim, const Scene *scene);
+void simulation_executer(Simulation *sim, const Commande *commandes, int nb_commandes);
+double simulation_cap(const Simulation *sim);
+void simulation_tracer(Simulation *sim, TraceurSimulation traceur, void *contexte);
+bool simulation_construireCarte(Carte *carte, const Scene *scene);
+void simulation_obstacles(Simulation *sim, const Carte *carte);
+void simulation_journaliser(Simulation *sim, JournalTrajectoire *journal);
+void simulation_horloge(Simulation *sim, const ParametresHorloge *horloge);
+
+void simulation_tourner(Simulation *sim, double angle);
+void simulation_avancer(Simulation *sim, double d);
+void simulation_reculer(Simulation *sim, double d);
+void simulation_ligne(Simulation *sim, double d);
+void simulation_allerObjet(Simulation *sim, int couleur);
+void simulation_contourner(Simulation *sim, int couleur, int sens);
+
+#endif
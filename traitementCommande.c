@@ -4,8 +4,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include <signal.h>
 #include <unistd.h>
 #include "traitementCommande.h"
+#include "planification.h"
+#include "trajectoire.h"
 
 /**
  * @file
@@ -44,230 +49,494 @@ void changementDeBase(int* coin_HD, int* milieu_bleu, int* milieu_jaune, int* mi
     milieu_orange[1] = -milieu_orange[1] + recentrage_y;
 }
 
-/**
- * @brief Fonction qui prends en entrée les informations connues sur l'environnement. Puis, les transforme en appels de fonctions python qui s'éxecutent pour modéliser l'environnement.
- * @param nomfichier chemin d'accès de l'image que l'on modélise
- * @param coin_HD duo d'entiers correspondants aux coordonnées (x,y) du coin droit de l'image que l'on modélise
- * @param rayon_bleu entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
- * @param rayon_jaune entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
- * @param rayon_orange entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
- * @param milieu_bleu duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule bleue ; vaut [] si il n'y en a pas
- * @param milieu_jaune duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule jaune ; vaut [] si il n'y en a pas
- * @param milieu_orange duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule orange ; vaut [] si il n'y en a pas
-*/
-
-void modeliserEnvironnement(char nomfichier[],int *coin_HD, int rayon_bleu, int rayon_jaune,int rayon_orange,int *milieu_bleu,int *milieu_jaune,int *milieu_orange){
+static unsigned char *tamponMessage(MessageSimulateur *m) {
+    return (m->donnees != NULL) ? m->donnees : m->integre;
+}
 
-    char res[1000] = "";
+const unsigned char *message_octets(const MessageSimulateur *m) {    //Octets du message, m->longueur au total.
+    return (m->donnees != NULL) ? m->donnees : m->integre;
+}
 
-   sprintf(res + strlen(res),"initialisation(%d,%d,'%s')",coin_HD[0],coin_HD[1],nomfichier);
-  
-    if (rayon_bleu > 0){
-        sprintf(res + strlen(res),";boule(%d,%d,%d,'blue')", milieu_bleu[0],milieu_bleu[1],rayon_bleu);
+/**
+ * @brief Réserve la place de taille octets à la fin du message, en doublant la taille du tampon si besoin.
+ * @return false si la mémoire manque.
+ */
+static bool reserverMessage(MessageSimulateur *m, size_t taille) {
+    if (m->longueur + taille > m->capacite) {
+        size_t capacite = m->capacite;
+        while (capacite < m->longueur + taille) {
+            capacite *= 2;
+        }
+        unsigned char *donnees = realloc(m->donnees, capacite);
+        if (donnees == NULL) {
+            m->erreur = true;
+            return false;
+        }
+        if (m->donnees == NULL) {
+            memcpy(donnees, m->integre, m->longueur);
+        }
+        m->donnees = donnees;
+        m->capacite = capacite;
     }
-    if (rayon_jaune >0){
-        sprintf(res + strlen(res),";boule(%d,%d,%d,'yellow')", milieu_jaune[0],milieu_jaune[1],rayon_jaune);
+    return true;
+}
+
+static void ecrire16(unsigned char *p, uint16_t v) {    //Petit-boutiste, quel que soit le processeur.
+    p[0] = (unsigned char) v;
+    p[1] = (unsigned char) (v >> 8);
+}
+
+static void ecrire32(unsigned char *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (unsigned char) (v >> (8 * i));
     }
-    if (rayon_orange >0){
-        sprintf(res + strlen(res),";boule(%d,%d,%d,'orange')", milieu_orange[0],milieu_orange[1],rayon_orange);
-    }    
+}
 
-    sprintf(res + strlen(res),";set_robot_position(0,%d, 90)",-((coin_HD[1])-10));
+static uint32_t lire32(const unsigned char *p) {
+    return (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24;
+}
 
+/**
+ * @brief Commence un message vide : l'entête, avec un nombre d'enregistrements nul, puis le chemin du fond.
+ * @param fond Chemin de l'image modélisée ; tronqué à 65535 octets.
+ */
+void message_initialiser(MessageSimulateur *m, const char *fond) {
+    size_t taille_fond = strlen(fond);
+    unsigned char *p;
 
-    FILE* python_process = popen("python3 modelisation.py", "w");
-    fprintf(python_process, "%s", res);
-    fclose(python_process);
-} 
+    if (taille_fond > UINT16_MAX) {
+        taille_fond = UINT16_MAX;
+    }
+    m->donnees = NULL;
+    m->capacite = MESSAGE_CAPACITE_INTEGREE;
+    m->longueur = 0;
+    m->nb_enregistrements = 0;
+    m->erreur = false;
+    if (!reserverMessage(m, PROTOCOLE_TAILLE_ENTETE + taille_fond)) {
+        taille_fond = 0;
+        reserverMessage(m, PROTOCOLE_TAILLE_ENTETE);
+    }
+    p = tamponMessage(m);
+    memcpy(p, PROTOCOLE_MAGIE, 4);
+    p[4] = PROTOCOLE_VERSION;
+    p[5] = 0;
+    ecrire16(p + 6, (uint16_t) taille_fond);
+    ecrire32(p + 8, 0);
+    memcpy(p + PROTOCOLE_TAILLE_ENTETE, fond, taille_fond);
+    m->longueur = PROTOCOLE_TAILLE_ENTETE + taille_fond;
+}
+
+void message_detruire(MessageSimulateur *m) {    //Libère le tampon alloué.
+    free(m->donnees);
+    m->donnees = NULL;
+    m->capacite = MESSAGE_CAPACITE_INTEGREE;
+    m->longueur = 0;
+    m->nb_enregistrements = 0;
+}
 
 /**
- * @brief Fonction qui prends en entrée les informations connues sur l'environnement et les mots-clés extraits de la phrase entrée par l'utilisateur. Puis, les transforme en appels de fonctions python  qui s'éxecutent pour modéliser l'environnement et les actions du robots.
- * @param nomfichier chemin d'accès de l'image que l'on modélise
- * @param mat matrice contenant tous les mots-clés extraits de la phrase entrée par l'utilisateur : jusqu'à 5 éléments de type[[action],[param1],[param2]]
- * @param mat_compt entier correspondant au nombre d'éléments dans "mat"
- * @param coin_HD duo d'entiers correspondants aux coordonnées (x,y) du coin droit de l'image que l'on modélise
- * @param rayon_bleu entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
- * @param rayon_jaune entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
- * @param rayon_orange entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
- * @param milieu_bleu duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule bleue ; vaut [] si il n'y en a pas
- * @param milieu_jaune duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule jaune ; vaut [] si il n'y en a pas
- * @param milieu_orange duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule orange ; vaut [] si il n'y en a pas
-*/
+ * @brief Ajoute un enregistrement au message et met à jour le nombre d'enregistrements de l'entête.
+ * @param opcode OpCommande ou OpEnregistrement.
+ * @param a, b, c Arguments entiers (coordonnées, rayon) ; 0 s'ils ne servent pas.
+ * @param valeur Argument de la commande (angle, distance, nombre de boules).
+ * @return false si la mémoire manque ; l'enregistrement n'est alors pas ajouté.
+ */
+bool message_ajouter(MessageSimulateur *m, int opcode, int couleur, int sens, int a, int b, int c, double valeur) {
+    unsigned char *p;
+    uint64_t bits;
 
-void modeliserActions(char nomfichier[], char *mat[5][4], int mat_compt, int *coin_HD, int rayon_bleu, int rayon_jaune,int rayon_orange,int *milieu_bleu,int *milieu_jaune, int *milieu_orange){ 
-    char res[1000] = "";
+    if (!reserverMessage(m, PROTOCOLE_TAILLE_ENREGISTREMENT)) {
+        return false;
+    }
+    p = tamponMessage(m) + m->longueur;
+    p[0] = (unsigned char) opcode;
+    p[1] = (unsigned char) couleur;
+    p[2] = (unsigned char) (signed char) sens;
+    p[3] = 0;
+    ecrire32(p + 4, (uint32_t) a);
+    ecrire32(p + 8, (uint32_t) b);
+    ecrire32(p + 12, (uint32_t) c);
+    memcpy(&bits, &valeur, sizeof(bits));
+    ecrire32(p + 16, (uint32_t) bits);
+    ecrire32(p + 20, (uint32_t) (bits >> 32));
+    m->longueur += PROTOCOLE_TAILLE_ENREGISTREMENT;
+    m->nb_enregistrements++;
+    ecrire32(tamponMessage(m) + 8, m->nb_enregistrements);
+    return true;
+}
 
-    sprintf(res + strlen(res),"tl.speed(0)");
-    sprintf(res + strlen(res),";initialisation(%d,%d,'%s')",coin_HD[0],coin_HD[1],nomfichier);
+/**
+ * @brief Relit un message : la scène, le chemin du fond et les commandes, comme le fait modelisation.py.
+ * @param scene Scène décrite par le message (boules absentes si le message ne la décrit pas).
+ * @param fond Reçoit le chemin du fond, terminé par '\0' et tronqué à taille_fond - 1 octets.
+ * @param commandes Reçoit au plus capacite commandes ; nb_commandes reçoit leur nombre.
+ * @return Taille du message en octets, 0 si octets ne contient pas encore le message complet, -1 si ce n'est pas
+ * un message de ce protocole ou de cette version, ou s'il contient une coordonnée hors de
+ * [-TRAJECTOIRE_DEMI_COTE_MAX, TRAJECTOIRE_DEMI_COTE_MAX], une couleur inconnue ou une valeur non finie.
+ */
+long message_decoder(const unsigned char *octets, size_t taille, Scene *scene, char *fond, size_t taille_fond, Commande *commandes, int capacite, int *nb_commandes) {
+    const int absent[2] = {0, 0}, coin[2] = {0, 0};
+    size_t longueur_fond, total;
+    uint32_t nb;
+    const unsigned char *p;
 
-    if (rayon_bleu >0){
-        sprintf(res + strlen(res),";boule(%d,%d,%d,'blue')", milieu_bleu[0],milieu_bleu[1],rayon_bleu);
+    *nb_commandes = 0;
+    if (taille < PROTOCOLE_TAILLE_ENTETE) {
+        return 0;
     }
-    if (rayon_jaune >0){
-        sprintf(res + strlen(res),";boule(%d,%d,%d,'yellow')", milieu_jaune[0],milieu_jaune[1],rayon_jaune);
+    if (memcmp(octets, PROTOCOLE_MAGIE, 4) != 0 || octets[4] != PROTOCOLE_VERSION) {
+        return -1;
     }
-    if (rayon_orange >0){
-        sprintf(res + strlen(res),";boule(%d,%d,%d,'orange')", milieu_orange[0],milieu_orange[1],rayon_orange);
+    longueur_fond = (size_t) octets[6] | (size_t) octets[7] << 8;
+    nb = lire32(octets + 8);
+    total = PROTOCOLE_TAILLE_ENTETE + longueur_fond + (size_t) nb * PROTOCOLE_TAILLE_ENREGISTREMENT;
+    if (taille < total) {
+        return 0;
     }
-      
-    sprintf(res + strlen(res),";set_robot_position(0,%d, 90)",-((coin_HD[1])-10));
-    sprintf(res + strlen(res),";tl.speed(1);time.sleep(1)");
-    
-
-for (int nbaction=0;nbaction<mat_compt;nbaction++){
-
-    if(strcmp(mat[nbaction][3], "Négative") != 0 || strcmp(mat[nbaction][3], "Negativa") != 0){
- 
-//Subphrase:"Avancer de [Distance] mètres" ou bien "Avancer de [Distance] mètres à [Direction]"
-        if(strcmp(mat[nbaction][0], "avancer") == 0 || strcmp(mat[nbaction][0], "avance") == 0 || strcmp(mat[nbaction][0], "avanzar") == 0 || strcmp(mat[nbaction][0], "avanza") == 0 || strcmp(mat[nbaction][0], "avances") == 0){
-            if (strcmp(mat[nbaction][1], "gauche") == 0 || strcmp(mat[nbaction][1], "izquierda") == 0) {
-                    sprintf(res + strlen(res),";tl.left(90)");
-            }
-            if (strcmp(mat[nbaction][1], "droite") == 0 || strcmp(mat[nbaction][1], "derecha") == 0) {
-                    sprintf(res + strlen(res),";tl.right(90)");
+    if (taille_fond > 0) {
+        size_t n = (longueur_fond < taille_fond) ? longueur_fond : taille_fond - 1;
+        memcpy(fond, octets + PROTOCOLE_TAILLE_ENTETE, n);
+        fond[n] = '\0';
+    }
+    scene_initialiser(scene, coin, -1, -1, -1, absent, absent, absent);
+
+    p = octets + PROTOCOLE_TAILLE_ENTETE + longueur_fond;
+    for (uint32_t i = 0; i < nb; i++, p += PROTOCOLE_TAILLE_ENREGISTREMENT) {
+        int a = (int32_t) lire32(p + 4), b = (int32_t) lire32(p + 8), c = (int32_t) lire32(p + 12);
+        uint64_t bits = lire32(p + 16) | (uint64_t) lire32(p + 20) << 32;
+        double valeur;
+
+        memcpy(&valeur, &bits, sizeof(valeur));
+        if (p[0] == ENREGISTREMENT_SCENE) {
+            if (a < 0 || a > TRAJECTOIRE_DEMI_COTE_MAX || b < 0 || b > TRAJECTOIRE_DEMI_COTE_MAX) {
+                return -1;    //La carte de simulation_construireCarte a la taille de la scène.
             }
-            if (strstr(mat[nbaction][2], "mètres") != NULL){
-                char *substring = "mètres";
-                char *ptr = strstr(mat[nbaction][2], substring);
-                strcpy(ptr, ptr + strlen(substring));
-                sprintf(res + strlen(res),";avancer(%s)", mat[nbaction][2]); 
+            scene->coin_HD[0] = a;
+            scene->coin_HD[1] = b;
+        } else if (p[0] == ENREGISTREMENT_BOULE) {
+            if (a < -TRAJECTOIRE_DEMI_COTE_MAX || a > TRAJECTOIRE_DEMI_COTE_MAX || b < -TRAJECTOIRE_DEMI_COTE_MAX
+                || b > TRAJECTOIRE_DEMI_COTE_MAX || c < -1 || c > TRAJECTOIRE_DEMI_COTE_MAX) {
+                return -1;
             }
-            else if (strstr(mat[nbaction][2], "metros") != NULL){
-                char *substring = "metros";
-                char *ptr = strstr(mat[nbaction][2], substring);
-                strcpy(ptr, ptr + strlen(substring));
-                sprintf(res + strlen(res),";avancer(%s)", mat[nbaction][2]);            
+            if (p[1] >= COULEUR_BLEU && p[1] <= COULEUR_ORANGE) {
+                scene->boules[p[1]] = (BouleScene) {c, {a, b}};
             }
-        }   
-//Subphrase:"Reculer de [Distance] mètres"
-        if(strcmp(mat[nbaction][0], "reculer") == 0 || strcmp(mat[nbaction][0], "recule") == 0 || strcmp(mat[nbaction][0], "retroceder") == 0 || strcmp(mat[nbaction][0], "retrocede") == 0 || strcmp(mat[nbaction][0], "retrocedas") == 0 ){
-            if (strstr(mat[nbaction][2], "mètres") != NULL){
-                char *substring = "mètres";
-                char *ptr = strstr(mat[nbaction][2], substring);
-                strcpy(ptr, ptr + strlen(substring));
-                sprintf(res + strlen(res),";reculer(%s)", mat[nbaction][2]);
+        } else if (p[0] <= COMMANDE_LIGNE) {
+            if (p[1] > COULEUR_ORANGE || !isfinite(valeur)) {
+                return -1;    //La couleur indexe les boules de la scène.
             }
-            else if (strstr(mat[nbaction][2], "metros") != NULL){
-                char *substring = "metros";
-                char *ptr = strstr(mat[nbaction][2], substring);
-                strcpy(ptr, ptr + strlen(substring));
-                sprintf(res + strlen(res),";reculer(%s)", mat[nbaction][2]);           
+            if (*nb_commandes < capacite) {
+                commandes[(*nb_commandes)++] = (Commande) {valeur, p[0], p[1], (signed char) p[2]};
             }
         }
-//Subphrase:"Tourner de [Val] degrés" ; Subphrase:"TOURNER À [DIRECTION] DE [VAL] DEGRÉS"
-        if(strcmp(mat[nbaction][0], "tourner") == 0 || strcmp(mat[nbaction][0], "tourne") == 0 || strcmp(mat[nbaction][0], "girar") == 0 || strcmp(mat[nbaction][0], "gira") == 0 || strcmp(mat[nbaction][0], "gires") == 0){
-            if (strstr(mat[nbaction][2], "degrés") != NULL){
-                char *substring = "degrés";
-                char *ptr = strstr(mat[nbaction][2], substring);
-                strcpy(ptr, ptr + strlen(substring));
-            }
-            else if (strstr(mat[nbaction][2], "degré") != NULL){
-                char *substring = "degré";
-                char *ptr = strstr(mat[nbaction][2], substring);
-                strcpy(ptr, ptr + strlen(substring));
-            }
-            else if (strstr(mat[nbaction][2], "grados") != NULL){
-                char *substring = "grados";
-                char *ptr = strstr(mat[nbaction][2], substring);
-                strcpy(ptr, ptr + strlen(substring));
-            }
-            else if (strstr(mat[nbaction][2], "grado") != NULL){
-                char *substring = "grado";
-                char *ptr = strstr(mat[nbaction][2], substring);
-                strcpy(ptr, ptr + strlen(substring));        
+    }
+    return (long) total;
+}
+
+static ParametresHorloge horloge = {HORLOGE_PAS, HORLOGE_VITESSE_LINEAIRE, HORLOGE_VITESSE_ANGULAIRE, 1.0};    //En temps réel par défaut.
+
+/**
+ * @brief Change l'horloge des mouvements du robot dans la fenêtre de modelisation.py, pour les modélisations
+ * suivantes : pas, vitesses et facteur de temps réel (0 pour tout afficher sans attendre).
+ */
+void modelisation_horloge(const ParametresHorloge *parametres) {
+    horloge = *parametres;
+}
+
+static FILE *journal_modelisation = NULL;    //NULL si les modélisations ne sont pas enregistrées.
+static int numero_modelisation = 0;          //Numéro de la dernière modélisation enregistrée dans ce journal.
+
+/**
+ * @brief Enregistre les modélisations suivantes dans un nouveau journal de trajectoire (rejeu), qui remplace le
+ * fichier s'il existe : les simulations y sont numérotées à partir de 1. NULL ferme le journal en cours.
+ * @return false si le fichier n'a pas pu être créé ; les modélisations ne sont alors pas enregistrées.
+ */
+bool modelisation_journal(const char *fichier) {
+    if (journal_modelisation != NULL) {
+        fclose(journal_modelisation);
+        journal_modelisation = NULL;
+    }
+    numero_modelisation = 0;
+    if (fichier != NULL) {
+        journal_modelisation = fopen(fichier, "wb");
+        return journal_modelisation != NULL;
+    }
+    return true;
+}
+
+/**
+ * @brief Ajoute au message l'horloge des mouvements et la modélisation de l'environnement : la scène, les boules et la position de départ,
+ * dessinées d'un coup par modelisation.py.
+ */
+static void ecrireEnvironnement(MessageSimulateur *message, const Scene *scene) {
+    message_ajouter(message, ENREGISTREMENT_HORLOGE, COULEUR_AUCUNE, 0, (int) lround(horloge.vitesse_lineaire * 1000.0),
+                    (int) lround(horloge.vitesse_angulaire * 1000.0), (int) lround(horloge.pas * 1e6), horloge.facteur);
+    message_ajouter(message, ENREGISTREMENT_SCENE, COULEUR_AUCUNE, 0, scene->coin_HD[0], scene->coin_HD[1], 0, 0.0);
+    for (int c = COULEUR_BLEU; c <= COULEUR_ORANGE; c++) {
+        const BouleScene *b = &scene->boules[c];
+        if (b->rayon > 0) {
+            message_ajouter(message, ENREGISTREMENT_BOULE, c, 0, b->milieu[0], b->milieu[1], b->rayon, 0.0);
+        }
+    }
+    message_ajouter(message, ENREGISTREMENT_DEPART, COULEUR_AUCUNE, 0, 0, -((scene->coin_HD[1]) - 10), 0, 0.0);
+}
+
+static FILE *simulateur = NULL;    //Entrée de "modelisation.py --serveur", ouverte à la première modélisation.
+
+/**
+ * @brief Ferme le simulateur : sa fenêtre se ferme quand il a fini d'exécuter les messages reçus.
+ * Appelée automatiquement à la fin du programme.
+ */
+void fermerSimulateur(void) {
+    if (simulateur != NULL) {
+        pclose(simulateur);
+        simulateur = NULL;
+    }
+}
+
+/**
+ * @brief Envoie le message à modelisation.py, en une seule écriture. Le simulateur est lancé une seule fois et reste
+ * ouvert entre les modélisations : seul le premier message paie le démarrage de Python et de Tk.
+ * S'il a été fermé entre-temps (fenêtre fermée par l'utilisateur), il est relancé.
+ */
+static void envoyerMessage(const MessageSimulateur *message) {
+    static bool premiere_ouverture = true;
+
+    if (message->erreur) {
+        fprintf(stderr, "Erreur: mémoire insuffisante, la modélisation est incomplète.\n");
+    }
+    for (int essai = 0; essai < 2; essai++) {
+        if (simulateur == NULL) {
+            if (premiere_ouverture) {
+                signal(SIGPIPE, SIG_IGN);    //Une écriture vers un simulateur fermé échoue au lieu d'arrêter le programme.
+                atexit(fermerSimulateur);
+                premiere_ouverture = false;
             }
-            if (strcmp(mat[nbaction][1], "gauche") == 0 || strcmp(mat[nbaction][1], "izquierda") == 0) {
-                    sprintf(res + strlen(res),";tl.left(%s)", mat[nbaction][2]);
+            simulateur = popen("python3 modelisation.py --serveur", "w");
+            if (simulateur == NULL) {
+                perror("Erreur lors du lancement de modelisation.py");
+                return;
             }
-            else{
-                sprintf(res + strlen(res),";tl.right(%s)", mat[nbaction][2]);
-            } 
         }
+        fwrite(message_octets(message), 1, message->longueur, simulateur);
+        if (fflush(simulateur) == 0 && !ferror(simulateur)) {
+            return;
+        }
+        fermerSimulateur();
+    }
+    fprintf(stderr, "Erreur: le simulateur ne répond pas.\n");
+}
+
+/**
+ * @brief Fonction qui prends en entrée les informations connues sur l'environnement. Puis, les envoie à modelisation.py qui modélise l'environnement.
+ * @param nomfichier chemin d'accès de l'image que l'on modélise
+ * @param coin_HD duo d'entiers correspondants aux coordonnées (x,y) du coin droit de l'image que l'on modélise
+ * @param rayon_bleu entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
+ * @param rayon_jaune entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
+ * @param rayon_orange entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
+ * @param milieu_bleu duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule bleue ; vaut [] si il n'y en a pas
+ * @param milieu_jaune duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule jaune ; vaut [] si il n'y en a pas
+ * @param milieu_orange duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule orange ; vaut [] si il n'y en a pas
+*/
+
+void modeliserEnvironnement(char nomfichier[],int *coin_HD, int rayon_bleu, int rayon_jaune,int rayon_orange,int *milieu_bleu,int *milieu_jaune,int *milieu_orange){
+    MessageSimulateur message;
+    Scene scene;
+
+    message_initialiser(&message, nomfichier);
+    scene_initialiser(&scene, coin_HD, rayon_bleu, rayon_jaune, rayon_orange, milieu_bleu, milieu_jaune, milieu_orange);
+    ecrireEnvironnement(&message, &scene);
+    envoyerMessage(&message);
+    message_detruire(&message);
+}
+/**
+ * @brief Rassemble les informations connues sur l'environnement dans une scène.
+ * @param scene Scène à remplir.
+ * @param coin_HD duo d'entiers correspondants aux coordonnées (x,y) du coin droit de l'image que l'on modélise
+ * @param rayon_bleu entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
+ * @param rayon_jaune entier correspondant à la taille de la boule jaune ; vaut -1 si il n'y en a pas
+ * @param rayon_orange entier correspondant à la taille de la boule orange ; vaut -1 si il n'y en a pas
+ * @param milieu_bleu duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule bleue
+ * @param milieu_jaune duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule jaune
+ * @param milieu_orange duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule orange
+ */
+void scene_initialiser(Scene *scene, const int *coin_HD, int rayon_bleu, int rayon_jaune, int rayon_orange, const int *milieu_bleu, const int *milieu_jaune, const int *milieu_orange) {
+    const int rayons[] = {[COULEUR_BLEU] = rayon_bleu, [COULEUR_JAUNE] = rayon_jaune, [COULEUR_ORANGE] = rayon_orange};
+    const int *milieux[] = {[COULEUR_BLEU] = milieu_bleu, [COULEUR_JAUNE] = milieu_jaune, [COULEUR_ORANGE] = milieu_orange};
+
+    scene->coin_HD[0] = coin_HD[0];
+    scene->coin_HD[1] = coin_HD[1];
+    for (int c = 0; c <= COULEUR_ORANGE; c++) {
+        BouleScene *b = &scene->boules[c];
+        b->rayon = -1;
+        b->milieu[0] = b->milieu[1] = 0;
+        if (c >= COULEUR_BLEU && rayons[c] > 0) {
+            b->rayon = rayons[c];
+            b->milieu[0] = milieux[c][0];
+            b->milieu[1] = milieux[c][1];
+        }
+    }
+}
 
-//Subphrase:"AVANCER JUSQU'À L'[OBJET]"
-        if(strcmp(mat[nbaction][0], "avancer") == 0 || strcmp(mat[nbaction][0], "avance") == 0 || strcmp(mat[nbaction][0], "avanzar") == 0 || strcmp(mat[nbaction][0], "avanza") == 0 || strcmp(mat[nbaction][0], "avances") == 0){
+/**
+ * @brief Construit la scène d'une image traitée (analyserImage) : les coordonnées de l'image et des boules
+ * détectées passent dans la base de la modélisation (changementDeBase).
+ */
+void scene_depuisImage(Scene *scene, const ResultatImage *image) {
+    int coin_HD[2] = {image->largeur, image->hauteur};
+    int milieu_bleu[2] = {image->bleu.milieu[0], image->bleu.milieu[1]};
+    int milieu_jaune[2] = {image->jaune.milieu[0], image->jaune.milieu[1]};
+    int milieu_orange[2] = {image->orange.milieu[0], image->orange.milieu[1]};
 
-            if ((strstr(mat[nbaction][2], "jaune") != NULL) || (strstr(mat[nbaction][2], "amarillo") != NULL) || (strstr(mat[nbaction][2], "amarilla") != NULL)){
-                if (rayon_jaune >0){
-                sprintf(res + strlen(res),";gobj([%d,%d,%d,'yellow'])", milieu_jaune[0],milieu_jaune[1],rayon_jaune);  
+    changementDeBase(coin_HD, milieu_bleu, milieu_jaune, milieu_orange);
+    scene_initialiser(scene, coin_HD, image->bleu.rayon, image->jaune.rayon, image->orange.rayon, milieu_bleu, milieu_jaune, milieu_orange);
+}
+
+/**
+ * @brief Traduit les actions extraites d'une phrase en commandes du simulateur. Les actions négatives ne sont pas
+ * exécutées, et une action qui vise une boule absente de la scène ne produit pas de commande de déplacement.
+ * @param scene Environnement modélisé.
+ * @param actions tableau des actions extraites de la phrase entrée par l'utilisateur
+ * @param nb_actions entier correspondant au nombre d'éléments dans "actions"
+ * @param commandes Reçoit les commandes : au moins COMMANDES_PAR_ACTION * nb_actions places.
+ * @return Nombre de commandes écrites.
+ */
+int traduireActions(const Scene *scene, const ActionData *actions, int nb_actions, Commande *commandes) {
+    int n = 0;
+
+    for (int i = 0; i < nb_actions; i++) {
+        const ActionData *a = &actions[i];
+        bool boule = scene->boules[a->couleur].rayon > 0;
+
+        if (a->negation) {
+            continue;
+        }
+        switch (a->opcode) {
+//Subphrase:"Avancer de [Distance] mètres" ou bien "Avancer de [Distance] mètres à [Direction]" ; Subphrase:"AVANCER JUSQU'À L'[OBJET]"
+            case VERBE_AVANCER:
+                if (a->direction == DIRECTION_GAUCHE) {
+                    commandes[n++] = (Commande) {90, COMMANDE_GAUCHE, COULEUR_AUCUNE, 0};
                 }
-            }
-            else if ((strstr(mat[nbaction][2], "bleu") != NULL)||(strstr(mat[nbaction][2], "bleue") != NULL)||(strstr(mat[nbaction][2], "azul") != NULL)){
-                if (rayon_bleu >0){
-                sprintf(res + strlen(res),";gobj([%d,%d,%d,'blue'])", milieu_bleu[0],milieu_bleu[1],rayon_bleu); 
-                }            
-            }
-            else if ((strstr(mat[nbaction][2], "orange") != NULL)||(strstr(mat[nbaction][2], "naranja") != NULL)){
-                if (rayon_orange >0){
-                sprintf(res + strlen(res),";gobj([%d,%d,%d,'orange'])", milieu_orange[0],milieu_orange[1],rayon_orange);      
+                if (a->direction == DIRECTION_DROITE) {
+                    commandes[n++] = (Commande) {90, COMMANDE_DROITE, COULEUR_AUCUNE, 0};
                 }
-            }
-        } 
-
+                if (a->mesure == MESURE_DISTANCE) {
+                    commandes[n++] = (Commande) {a->valeur, COMMANDE_AVANCER, COULEUR_AUCUNE, 0};
+                }
+                if (boule) {
+                    commandes[n++] = (Commande) {0, COMMANDE_ALLER_OBJET, a->couleur, 0};
+                }
+                break;
+//Subphrase:"Reculer de [Distance] mètres"
+            case VERBE_RECULER:
+                if (a->mesure == MESURE_DISTANCE) {
+                    commandes[n++] = (Commande) {a->valeur, COMMANDE_RECULER, COULEUR_AUCUNE, 0};
+                }
+                break;
+//Subphrase:"Tourner de [Val] degrés" ; Subphrase:"TOURNER À [DIRECTION] DE [VAL] DEGRÉS" (90 degrés si l'angle n'est pas donné)
+            case VERBE_TOURNER:
+                commandes[n++] = (Commande) {(a->mesure == MESURE_ANGLE) ? a->valeur : 90.0,
+                                             (a->direction == DIRECTION_GAUCHE) ? COMMANDE_GAUCHE : COMMANDE_DROITE,
+                                             COULEUR_AUCUNE, 0};
+                break;
 //Subphrase:"CONTOURNER PAR LA [DIRECTION] L'[OBJET]" ou bien "CONTOURNER L'[OBJET] PAR LA [DIRECTION]"
-        if(strcmp(mat[nbaction][0], "contourner") == 0 || strcmp(mat[nbaction][0], "contourne") == 0 || strcmp(mat[nbaction][0], "rodear") == 0 || strcmp(mat[nbaction][0], "rodea") == 0 || strcmp(mat[nbaction][0], "rodées") == 0){
-            if ((strstr(mat[nbaction][2], "jaune") != NULL) || (strstr(mat[nbaction][2], "amarillo") != NULL) || (strstr(mat[nbaction][2], "amarilla") != NULL)){
-                if (rayon_jaune >0){
-                    if ((strstr(mat[nbaction][1], "gauche") != NULL) || (strstr(mat[nbaction][1], "izquierda") != NULL)){
-                        sprintf(res + strlen(res),";contobj(%d,%d,%d,'yellow',-1)", milieu_jaune[0],milieu_jaune[1],rayon_jaune);  
-                    }
-                    else{
-                        sprintf(res + strlen(res),";contobj(%d,%d,%d,'yellow',1)", milieu_jaune[0],milieu_jaune[1],rayon_jaune);
-                    }
-                }                 
-            }
-            else if ((strstr(mat[nbaction][2], "bleu") != NULL)||(strstr(mat[nbaction][2], "bleue") != NULL)||(strstr(mat[nbaction][2], "azul") != NULL)){
-                if (rayon_bleu >0){
-                    if ((strstr(mat[nbaction][1], "gauche") != NULL) || (strstr(mat[nbaction][1], "izquierda") != NULL)){
-                        sprintf(res + strlen(res),";contobj(%d,%d,%d,'blue',-1)", milieu_bleu[0],milieu_bleu[1],rayon_bleu);             
-                    }
-                    else{
-                        sprintf(res + strlen(res),";contobj(%d,%d,%d,'blue',1)", milieu_bleu[0],milieu_bleu[1],rayon_bleu);
-                    }
+            case VERBE_CONTOURNER:
+                if (boule) {
+                    commandes[n++] = (Commande) {0, COMMANDE_CONTOURNER, a->couleur,
+                                                 (a->direction == DIRECTION_GAUCHE) ? -1 : 1};
                 }
-            }
-            else if ((strstr(mat[nbaction][2], "orange") != NULL)||(strstr(mat[nbaction][2], "naranja") != NULL)){
-                if (rayon_orange >0){
-                    if ((strstr(mat[nbaction][1], "gauche") != NULL) || (strstr(mat[nbaction][1], "izquierda") != NULL)){             
-                        sprintf(res + strlen(res),";contobj(%d,%d,%d,'orange',-1)", milieu_orange[0],milieu_orange[1],rayon_orange);      
-                    }
-                    else{
-                        sprintf(res + strlen(res),";contobj(%d,%d,%d,'orange',1)", milieu_orange[0],milieu_orange[1],rayon_orange);  
-                    }
-                }    
-            }
-        }
-
+                break;
 //Subphrase:"COMPTER LE NOMBRE D'[OBJET]"
-        if(strcmp(mat[nbaction][0], "compter") == 0 || strcmp(mat[nbaction][0], "compte") == 0 || strcmp(mat[nbaction][0], "contar") == 0 || strcmp(mat[nbaction][0], "cuenta") == 0 || strcmp(mat[nbaction][0], "cuentes") == 0){
-            if ((strstr(mat[nbaction][2], "balles") != NULL) || (strstr(mat[nbaction][2], "boules") != NULL) || (strstr(mat[nbaction][2], "bolas") != NULL)|| (strstr(mat[nbaction][2], "pelotas") != NULL)){                
-                if ((strstr(mat[nbaction][2], "jaune") != NULL) || (strstr(mat[nbaction][2], "amarillo") != NULL) || (strstr(mat[nbaction][2], "amarilla") != NULL)){
-                    sprintf(res + strlen(res),";print('---> IL Y A %d BOULE JAUNE.')",((rayon_jaune > 0) ? 1 : 0)); 
-                }                
-                else if ((strstr(mat[nbaction][2], "bleu") != NULL)||(strstr(mat[nbaction][2], "bleue") != NULL)||(strstr(mat[nbaction][2], "azul") != NULL)){
-                    sprintf(res + strlen(res),";print('---> IL Y A %d BOULE BLEUE.')",((rayon_bleu > 0) ? 1 : 0));
-                }
-                else if ((strstr(mat[nbaction][2], "orange") != NULL)||(strstr(mat[nbaction][2], "naranja") != NULL)){
-                    sprintf(res + strlen(res),";print('---> IL Y A %d BOULE ORANGE.')",((rayon_orange > 0) ? 1 : 0));
-                }    
-                else{
+            case VERBE_COMPTER:
+                if (a->objet != OBJET_BOULE) {
+                    commandes[n++] = (Commande) {0, COMMANDE_OBJET_INEXISTANT, COULEUR_AUCUNE, 0};
+                } else if (a->couleur >= COULEUR_BLEU) {
+                    commandes[n++] = (Commande) {boule ? 1 : 0, COMMANDE_COMPTER, a->couleur, 0};
+                } else {
                     int nb_boules = 0;
-                    if (rayon_jaune >0){nb_boules+=1;}
-                    if (rayon_bleu >0){nb_boules+=1;}
-                    if (rayon_orange >0){nb_boules+=1;}
-                    sprintf(res + strlen(res),";print('---> IL Y A %d BOULES(S)).')",nb_boules);
+                    for (int c = COULEUR_BLEU; c <= COULEUR_ORANGE; c++) {
+                        nb_boules += (scene->boules[c].rayon > 0) ? 1 : 0;
+                    }
+                    commandes[n++] = (Commande) {nb_boules, COMMANDE_COMPTER, COULEUR_AUCUNE, 0};
                 }
-            }
-            else{
-                sprintf(res + strlen(res),";print('---> OBJET INEXISTANT.')");
-            }
-        }      
+                break;
+            default:
+                break;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Rejoue les commandes envoyées à la fenêtre dans le simulateur, et ajoute la simulation au journal des
+ * modélisations s'il est ouvert (modelisation_journal) : la trajectoire reste disponible une fois la fenêtre fermée.
+ */
+static void journaliserModelisation(const char *nomfichier, const Scene *scene, const Commande *commandes, int nb_commandes) {
+    JournalTrajectoire journal;
+    Simulation sim;
+    ParametresHorloge sans_attente = horloge;
+
+    if (journal_modelisation == NULL) {
+        return;
     }
+    sans_attente.facteur = 0.0;
+    journal_initialiser(&journal);
+    simulation_initialiser(&sim, scene);
+    simulation_horloge(&sim, &sans_attente);
+    journal_commencer(&journal, &sim, ++numero_modelisation, nomfichier);
+    simulation_journaliser(&sim, &journal);
+    simulation_executer(&sim, commandes, nb_commandes);
+    journal_terminer(&journal, &sim);
+    journal_ecrire(&journal, journal_modelisation);
+    fflush(journal_modelisation);    //Chaque modélisation est lisible par rejeu dès qu'elle est affichée.
+    journal_detruire(&journal);
 }
 
-FILE* python_process = popen("python3 modelisation.py", "w");
-fprintf(python_process, "%s", res);
-fclose(python_process);
+/**
+ * @brief Fonction qui prends en entrée les informations connues sur l'environnement et les actions extraites de la phrase entrée par l'utilisateur. Puis, les transforme en appels de fonctions python  qui s'éxecutent pour modéliser l'environnement et les actions du robots.
+ * Les actions sont d'abord traduites en commandes du simulateur (traduireActions), les chemins vers les boules et autour d'elles sont planifiés pour éviter les autres boules (planifierCommandes), puis toutes les commandes sont envoyées dans un seul message.
+ * La trajectoire est aussi ajoutée au journal des modélisations, s'il est ouvert (modelisation_journal).
+ * @param nomfichier chemin d'accès de l'image que l'on modélise
+ * @param actions tableau des actions extraites de la phrase entrée par l'utilisateur
+ * @param nb_actions entier correspondant au nombre d'éléments dans "actions"
+ * @param coin_HD duo d'entiers correspondants aux coordonnées (x,y) du coin droit de l'image que l'on modélise
+ * @param rayon_bleu entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
+ * @param rayon_jaune entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
+ * @param rayon_orange entier correspondant à la taille de la boule bleue ; vaut -1 si il n'y en a pas
+ * @param milieu_bleu duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule bleue ; vaut [] si il n'y en a pas
+ * @param milieu_jaune duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule jaune ; vaut [] si il n'y en a pas
+ * @param milieu_orange duo d'entiers correspondants aux coordonnées (x,y) du centre de la boule orange ; vaut [] si il n'y en a pas
+*/
+void modeliserActions(char nomfichier[], const ActionData *actions, int nb_actions, int *coin_HD, int rayon_bleu, int rayon_jaune,int rayon_orange,int *milieu_bleu,int *milieu_jaune, int *milieu_orange){ 
+    MessageSimulateur message;
+    Scene scene;
+    Planificateur pl;
+    size_t capacite = (size_t) (nb_actions > 0 ? nb_actions : 1) * COMMANDES_PAR_ACTION;
+    Commande *traduites = malloc(capacite * sizeof(Commande));
+    Commande *commandes = malloc(capacite * COMMANDES_PAR_PLANIFICATION * sizeof(Commande));
+    int nb_commandes;
+
+    if (traduites == NULL || commandes == NULL) {
+        free(traduites);
+        free(commandes);
+        return;
+    }
+    scene_initialiser(&scene, coin_HD, rayon_bleu, rayon_jaune, rayon_orange, milieu_bleu, milieu_jaune, milieu_orange);
+    planificateur_initialiser(&pl, &scene);
+    nb_commandes = planifierCommandes(&pl, traduites, traduireActions(&scene, actions, nb_actions, traduites), commandes);
+    free(traduites);
+
+    message_initialiser(&message, nomfichier);
+    ecrireEnvironnement(&message, &scene);
+    for (int i = 0; i < nb_commandes; i++) {
+        const Commande *c = &commandes[i];
+        message_ajouter(&message, c->opcode, c->couleur, c->sens, 0, 0, 0, c->valeur);
+    }
+    journaliserModelisation(nomfichier, &scene, commandes, nb_commandes);
+    free(commandes);
+
+    envoyerMessage(&message);
+    message_detruire(&message);
 }
 
 /**
@@ -15,9 +15,124 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "traitementTexte.h"
+#include "traitementImage.h"
 
+/**
+ * @brief Boule détectée dans l'image, dans la base de la modélisation.
+ */
+typedef struct {
+    int rayon;          /**< -1 si la boule n'est pas dans l'image. */
+    int milieu[2];      /**< Coordonnées (x,y) du centre. */
+} BouleScene;
+
+/**
+ * @brief Environnement modélisé : taille de l'image et boules détectées, indexées par leur couleur (CodeCouleur).
+ */
+typedef struct {
+    int coin_HD[2];
+    BouleScene boules[COULEUR_ORANGE + 1];
+} Scene;
+
+/**
+ * @brief Primitives du simulateur, dans l'ordre des fonctions de modelisation.py.
+ */
+typedef enum {
+    COMMANDE_GAUCHE = 0,        /**< tl.left(valeur) */
+    COMMANDE_DROITE,            /**< tl.right(valeur) */
+    COMMANDE_AVANCER,           /**< avancer(valeur) */
+    COMMANDE_RECULER,           /**< reculer(valeur) */
+    COMMANDE_ALLER_OBJET,       /**< gobj([x,y,r,couleur]) : aller jusqu'à la boule de la couleur. */
+    COMMANDE_CONTOURNER,        /**< contobj(x,y,r,couleur,sens) */
+    COMMANDE_COMPTER,           /**< Affiche valeur, le nombre de boules de la couleur (de toutes si COULEUR_AUCUNE). */
+    COMMANDE_OBJET_INEXISTANT,  /**< Affiche que l'objet à compter n'existe pas. */
+    COMMANDE_LIGNE              /**< tl.forward(valeur) : tronçon d'un chemin planifié, sans arrêt au bord de l'arène. */
+} OpCommande;
+
+/**
+ * @brief Commande élémentaire du simulateur, obtenue à partir d'une ActionData et de la scène.
+ */
+typedef struct {
+    double valeur;              /**< Angle en degrés, distance, ou nombre de boules comptées. */
+    unsigned char opcode;       /**< OpCommande. */
+    unsigned char couleur;      /**< Couleur de la boule visée (CodeCouleur). */
+    signed char sens;           /**< COMMANDE_CONTOURNER : 1 par la droite, -1 par la gauche. */
+} Commande;
+
+#define COMMANDES_PAR_ACTION 3    //Nombre maximal de commandes produites par une action.
+
+/**
+ * @brief Horloge à pas fixe des mouvements du robot : chaque mouvement dure un nombre entier de pas, selon les
+ * vitesses du robot. Le facteur de temps réel règle l'écoulement du temps simulé par rapport au temps réel :
+ * 1 en temps réel, 10 dix fois plus vite, 0 aussi vite que possible.
+ */
+typedef struct {
+    double pas;                  /**< Durée d'un pas, en secondes (strictement positive). */
+    double vitesse_lineaire;     /**< Unités par seconde (strictement positive). */
+    double vitesse_angulaire;    /**< Degrés par seconde (strictement positive). */
+    double facteur;              /**< Facteur de temps réel, 0 pour ne jamais attendre. */
+} ParametresHorloge;
+
+#define HORLOGE_PAS 0.01                   //Pas par défaut : le délai d'affichage de turtle.
+#define HORLOGE_VITESSE_LINEAIRE 330.0     //Unités par seconde, comme turtle avec tl.speed(1).
+#define HORLOGE_VITESSE_ANGULAIRE 300.0    //Degrés par seconde, comme turtle avec tl.speed(1).
+
+/**
+ * @brief Protocole entre le programme C et modelisation.py. Un message regroupe une série de commandes :
+ * - un entête de PROTOCOLE_TAILLE_ENTETE octets : "MBOT", la version (1 octet), 1 octet réservé, la longueur du
+ *   chemin du fond (2 octets) et le nombre d'enregistrements (4 octets) ;
+ * - le chemin du fond (.gif), sans '\0' ;
+ * - les enregistrements, de PROTOCOLE_TAILLE_ENREGISTREMENT octets chacun : opcode, couleur (CodeCouleur),
+ *   sens (signé), 1 octet réservé, trois entiers de 4 octets et un double.
+ * Les entiers et le double sont en petit-boutiste. L'entête garde cette forme dans toutes les versions, ce qui
+ * permet au simulateur de sauter un message d'une version qu'il ne connaît pas.
+ */
+#define PROTOCOLE_MAGIE "MBOT"
+#define PROTOCOLE_VERSION 1
+#define PROTOCOLE_TAILLE_ENTETE 12
+#define PROTOCOLE_TAILLE_ENREGISTREMENT 24
+
+/**
+ * @brief Opcodes des enregistrements qui décrivent la scène. Les commandes du robot gardent leur OpCommande.
+ */
+typedef enum {
+    ENREGISTREMENT_SCENE = 16,  /**< Nouvelle scène : entiers = coin_HD, le fond est celui de l'entête. */
+    ENREGISTREMENT_BOULE,       /**< Boule de la couleur : entiers = centre et rayon. */
+    ENREGISTREMENT_DEPART,      /**< Robot placé au départ : second entier = ordonnée ; la scène est affichée. */
+    ENREGISTREMENT_HORLOGE      /**< Horloge des mouvements : entiers = vitesses linéaire et angulaire en millièmes
+                                     d'unité et de degré par seconde, et pas en microsecondes ; double = facteur de
+                                     temps réel. */
+} OpEnregistrement;
+
+#define MESSAGE_CAPACITE_INTEGREE 1024    //Taille de message écrite sans allocation.
+
+/**
+ * @brief Message en cours de construction, par ajouts successifs. Sa longueur est connue, et le tampon double
+ * quand il est plein : un ajout est en O(1) amorti et le message n'a pas de taille maximale.
+ */
+typedef struct {
+    unsigned char *donnees;                            /**< Tampon alloué, NULL tant que le tampon intégré suffit. */
+    unsigned char integre[MESSAGE_CAPACITE_INTEGREE];  /**< Tampon intégré. */
+    size_t capacite;                                   /**< Capacité du tampon utilisé. */
+    size_t longueur;                                   /**< Nombre d'octets écrits. */
+    unsigned int nb_enregistrements;
+    bool erreur;                                       /**< Un ajout a échoué faute de mémoire ; le message est tronqué. */
+} MessageSimulateur;
+
+void message_initialiser(MessageSimulateur *m, const char *fond);
+void message_detruire(MessageSimulateur *m);
+bool message_ajouter(MessageSimulateur *m, int opcode, int couleur, int sens, int a, int b, int c, double valeur);
+const unsigned char *message_octets(const MessageSimulateur *m);
+long message_decoder(const unsigned char *octets, size_t taille, Scene *scene, char *fond, size_t taille_fond, Commande *commandes, int capacite, int *nb_commandes);
+
+void scene_initialiser(Scene *scene, const int *coin_HD, int rayon_bleu, int rayon_jaune, int rayon_orange, const int *milieu_bleu, const int *milieu_jaune, const int *milieu_orange);
+void scene_depuisImage(Scene *scene, const ResultatImage *image);
+int traduireActions(const Scene *scene, const ActionData *actions, int nb_actions, Commande *commandes);
 void changementDeBase(int* coin_HD, int* milieu_bleu, int* milieu_jaune, int* milieu_orange);
 void modeliserEnvironnement(char nomfichier[],int *coin_HD, int rayon_bleu, int rayon_jaune,int rayon_orange,int *milieu_bleu,int *milieu_jaune,int *milieu_orange);
-void modeliserActions(char nomfichier[], char *mat[5][4], int mat_compt, int *coin_HD, int rayon_bleu, int rayon_jaune,int rayon_orange,int *milieu_bleu,int *milieu_jaune, int *milieu_orange);
+void fermerSimulateur(void);
+void modelisation_horloge(const ParametresHorloge *parametres);
+bool modelisation_journal(const char *fichier);
+void modeliserActions(char nomfichier[], const ActionData *actions, int nb_actions, int *coin_HD, int rayon_bleu, int rayon_jaune,int rayon_orange,int *milieu_bleu,int *milieu_jaune, int *milieu_orange);
 
 #endif 
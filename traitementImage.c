@@ -45,6 +45,22 @@ Groupe_Pixel_ptr alloc_Groupe_Pixel(int nbp , int** matrice_ass_param,char * cou
     return res ;
 }
 
+/**
+ * @brief Libère un groupe de pixel et sa matrice.
+ * @param groupe Groupe alloué par une fonction de détection, ou NULL.
+ * @param hauteur Hauteur de l'image/matrice.
+*/
+void liberer_Groupe_Pixel(Groupe_Pixel_ptr groupe, int hauteur){
+    if (groupe == NULL){
+        return;
+    }
+    for (int i = 0 ; i<hauteur ; i++){
+        free(groupe->matrice_associe[i]);
+    }
+    free(groupe->matrice_associe);
+    free(groupe);
+}
+
 
 
 //Detection de plage de couleur
@@ -205,12 +221,13 @@ Groupe_Pixel_ptr detecterPixelsOrange(int **matriceR, int ** matriceG, int ** ma
  * @param groupe Pointeur vers le groupe de pixels.
  * @param largeur Largeur de l'image.
  * @param hauteur Hauteur de l'image.
- * @return Tableau d'entiers contenant les coordonnées du milieu [hauteur, largeur].Vide si impossible.
+ * @return Tableau d'entiers contenant les coordonnées du milieu [largeur, hauteur], {0, 0} si le groupe n'est pas un
+ * objet, NULL si la mémoire manque. A libérer par l'appelant.
  */
-int * trouver_milieu(Groupe_Pixel_ptr groupe, int largeur , int hauteur){//null si pas un objet
-    int * res =malloc(2*sizeof(int));
-    if (!isObjet(groupe)){
-        return(res);//liste 
+int * trouver_milieu(Groupe_Pixel_ptr groupe, int largeur , int hauteur){
+    int * res =calloc(2, sizeof(int));
+    if (res == NULL || !isObjet(groupe)){
+        return(res);
     }
     int imin_h=60000 ;
     int jmin_l = 60000;
@@ -238,18 +255,6 @@ int * trouver_milieu(Groupe_Pixel_ptr groupe, int largeur , int hauteur){//null
     }
     res[0] =jmin_l+(jmax_l-jmin_l)/2 ; //hauteur
     res[1] = imin_h+(imax_h-imin_h)/2 ;
-    if(groupe->couleur == "Bleu"){
-        printf("Le milieu de l'objet \x1B[34m%s\x1B[0m est de coordonnées : [%d,%d]\n",groupe->couleur,res[0],res[1]);
-
-    }
-    else if(groupe->couleur == "Jaune"){
-        printf("Le milieu de l'objet \x1B[33m%s\x1B[0m est de coordonnées : [%d,%d]\n",groupe->couleur,res[0],res[1]);
-    }
-    else{
-        printf("Le milieu de l'objet \x1B[38;5;208m%s\x1B[0m est de coordonnées : [%d,%d]\n",groupe->couleur,res[0],res[1]);
-    }
-      
-
     return (res);
 
 }
@@ -291,26 +296,7 @@ int  trouver_rayon(Groupe_Pixel_ptr objet, int largeur , int hauteur){
     if ((imax_h-imin_h)/2>maxres){
         maxres = (imax_h-imin_h)/2 ;
     }
-
-    if(objet->couleur == "Bleu"){
-        printf("Le rayon de l'objet de couleur \x1B[34m%s\x1B[0m est : %d\n",objet->couleur,maxres);
-
-    }
-    else if (objet->couleur == "Jaune"){
-        printf("Le rayon de l'objet de couleur \x1B[33m%s\x1B[0m est : %d\n",objet->couleur,maxres);
-
-    }
-    else {
-        printf("Le rayon de l'objet de couleur \x1B[38;5;208m%s\x1B[0m est : %d\n",objet->couleur,maxres);
-        
-    }
-    
     return maxres;
-
-
-
-
-
 }
 /**
  * @brief Fonction getter de la couleur d'un groupe de pixel.
@@ -333,107 +319,93 @@ bool isObjet (Groupe_Pixel_ptr groupe){
 }
 
 /**
- * @brief Fonction principale pour le traitement de l'image.
+ * @brief Libère les matrices initiales d'une image.
+*/
+static void libererMatrices(int *** matrices, int nb, int hauteur){
+    for (int c = 0 ; c<nb ; c++){
+        if (matrices[c] != NULL){
+            for (int i = 0 ; i<hauteur ; i++){
+                free(matrices[c][i]);
+            }
+            free(matrices[c]);
+        }
+    }
+}
+
+/**
+ * @brief Remplit le résultat d'une couleur à partir de son groupe de pixel.
+*/
+static void remplirObjet(ObjetImage * objet, Groupe_Pixel_ptr groupe, int largeur , int hauteur){
+    int * milieu = trouver_milieu(groupe, largeur, hauteur);
+    objet->detecte = isObjet(groupe);
+    objet->nb_pixels = groupe->nbpixel_g;
+    objet->rayon = trouver_rayon(groupe, largeur, hauteur);
+    objet->milieu[0] = (milieu != NULL) ? milieu[0] : 0;
+    objet->milieu[1] = (milieu != NULL) ? milieu[1] : 0;
+    free(milieu);
+}
+
+/**
+ * @brief Fonction principale pour le traitement de l'image : lit l'image .txt (largeur, hauteur, nombre de
+ * composantes, puis les matrices du rouge, du vert et du bleu), et y cherche les boules bleue, jaune et orange.
+ * Elle n'écrit rien sur le terminal, et n'utilise que ses paramètres : plusieurs images peuvent être traitées en
+ * même temps par des threads différents.
  *
- * @param largeurimage Pointeur vers la variable qui stocke la largeur de l'image.
- * @param longueurimage Pointeur vers la variable qui stocke la hauteur de l'image.
- * @param rayon_bleu Pointeur vers la variable qui stocke le rayon de l'objet bleu.
- * @param rayon_jaune Pointeur vers la variable qui stocke le rayon de l'objet jaune.
- * @param rayon_orange Pointeur vers la variable qui stocke le rayon de l'objet orange.
- * @param milieu_bleu Pointeur vers la matrice qui stocke le milieu de l'objet bleu.
- * @param milieu_jaune Pointeur vers la matrice qui stocke le milieu de l'objet jaune.
- * @param milieu_orange Pointeur vers la matrice qui stocke le milieu de l'objet orange.
  * @param nomFichier Nom du fichier image à traiter.
+ * @param resultat Reçoit les caractéristiques de l'image et les boules détectées. Il est remis à zéro en cas d'erreur.
+ * @return IMAGE_OK, ou la cause de l'échec.
  */
-void main_it(int* largeurimage,int* longueurimage,int *rayon_bleu, int *rayon_jaune, int *rayon_orange,int **milieu_bleu, int **milieu_jaune, int **milieu_orange, char* nomFichier){
-
-int largeur,hauteur,nbcompo ;
-
-
-
- FILE *fichier = fopen(nomFichier, "r");
+StatutImage analyserImage(const char *nomFichier, ResultatImage *resultat){
+    int largeur, hauteur, nbcompo;
+    int ** matrices[3] = {NULL, NULL, NULL};
+    StatutImage statut = IMAGE_OK;
+    FILE *fichier = fopen(nomFichier, "r");
 
+    *resultat = (ResultatImage){0};
     if (fichier == NULL) {
-        perror("Erreur lors de l'ouverture du fichier.");
-        return ;
-    }
-
-
-fscanf(fichier,"%d",&largeur) ;
-fscanf(fichier,"%d",&hauteur) ;
-fscanf(fichier,"%d", &nbcompo) ;
-printf("\n\n");
-printf("\x1B[1m---------------TRAITEMENT D'IMAGE--------------\x1B[0m\n\n");
-printf("\x1B[4mCARACTERISTIQUES IMAGE:\x1B[0m\n\n");
-printf("Largeur : %d\n",largeur);
-printf("Hauteur : %d\n",hauteur);
-printf("Nbcompo : %d\n",nbcompo);
-printf("\n");
-//Matrice initiales
-int ** matrice_init_red =malloc(hauteur*sizeof(int*));
-int ** matrice_init_green =malloc(hauteur*sizeof(int*));
-int ** matrice_init_blue =malloc(hauteur*sizeof(int*));
-//Allocations
-for (int p = 0; p < hauteur; p++) {
-        matrice_init_red[p] = malloc(largeur * sizeof(int));
-        matrice_init_green[p] = malloc(largeur * sizeof(int));
-        matrice_init_blue[p] = malloc(largeur * sizeof(int));
+        return IMAGE_ERREUR_FICHIER;
     }
-//R
-for (int i=0 ;i<hauteur ; i++){
-    for(int j=0 ; j<largeur ; j++){
-        fscanf(fichier,"%d",&matrice_init_red[i][j]);
+    if (fscanf(fichier, "%d %d %d", &largeur, &hauteur, &nbcompo) != 3 || largeur <= 0 || hauteur <= 0) {
+        fclose(fichier);
+        return IMAGE_ERREUR_FORMAT;
     }
-}
-//G
-int x,y ;
-for (x=0 ;x<hauteur ; x++){
-    for(y=0 ; y<largeur ; y++){
-        fscanf(fichier,"%d",&matrice_init_green[x][y]);
+    //Matrices initiales du rouge, du vert et du bleu, lues l'une après l'autre.
+    for (int c = 0 ; c<3 && statut == IMAGE_OK ; c++){
+        matrices[c] = calloc(hauteur, sizeof(int*));
+        if (matrices[c] == NULL){
+            statut = IMAGE_ERREUR_MEMOIRE;
+        }
+        for (int i = 0 ; i<hauteur && statut == IMAGE_OK ; i++){
+            matrices[c][i] = malloc(largeur * sizeof(int));
+            if (matrices[c][i] == NULL){
+                statut = IMAGE_ERREUR_MEMOIRE;
+            }
+            for (int j = 0 ; j<largeur && statut == IMAGE_OK ; j++){
+                if (fscanf(fichier, "%d", &matrices[c][i][j]) != 1){
+                    statut = IMAGE_ERREUR_FORMAT;
+                }
+            }
+        }
     }
-}
-//B
-int a,b ;
-for (a=0 ;a<hauteur ; a++){
-    for(b=0 ; b<largeur ; b++){
-        fscanf(fichier,"%d",&matrice_init_blue[a][b]);
+    fclose(fichier);
+
+    if (statut == IMAGE_OK){
+        Groupe_Pixel_ptr objet_poss_bleu = detecterPixelsBleu(matrices[0], matrices[1], matrices[2], hauteur, largeur);
+        Groupe_Pixel_ptr objet_poss_jaune = detecterPixelsJaune(matrices[0], matrices[1], matrices[2], hauteur, largeur);
+        Groupe_Pixel_ptr objet_poss_Orange = detecterPixelsOrange(matrices[0], matrices[1], matrices[2], hauteur, largeur);
+
+        resultat->largeur = largeur;
+        resultat->hauteur = hauteur;
+        resultat->nbcompo = nbcompo;
+        remplirObjet(&resultat->bleu, objet_poss_bleu, largeur, hauteur);
+        remplirObjet(&resultat->jaune, objet_poss_jaune, largeur, hauteur);
+        remplirObjet(&resultat->orange, objet_poss_Orange, largeur, hauteur);
+        liberer_Groupe_Pixel(objet_poss_bleu, hauteur);
+        liberer_Groupe_Pixel(objet_poss_jaune, hauteur);
+        liberer_Groupe_Pixel(objet_poss_Orange, hauteur);
     }
-}
-Groupe_Pixel_ptr objet_poss_bleu = detecterPixelsBleu(matrice_init_red , matrice_init_green , matrice_init_blue , hauteur , largeur);
-Groupe_Pixel_ptr objet_poss_jaune = detecterPixelsJaune(matrice_init_red , matrice_init_green , matrice_init_blue , hauteur , largeur);
-Groupe_Pixel_ptr objet_poss_Orange = detecterPixelsOrange(matrice_init_red , matrice_init_green , matrice_init_blue , hauteur , largeur);
-//dfs et lpg
-//trouverLePlusGros(objet_poss_Orange->matrice_associe ,hauteur , largeur );
-//dETECTION
-printf("\x1B[4mDETECTIONS DES OBJETS :\x1B[0m\n\n");
-if(isObjet(objet_poss_bleu)){printf("Objet de couleur \x1B[34mBleu\x1B[0m détecté!\n");}
-if(isObjet(objet_poss_jaune)){printf("Objet de couleur \x1B[33mJaune\x1B[0m détecté!\n");}
-if(isObjet(objet_poss_Orange)){printf("Objet de couleur \x1B[38;5;208mOrange\x1B[0m détecté!\n");}
-if(!isObjet(objet_poss_bleu) && !isObjet(objet_poss_jaune) && !isObjet(objet_poss_Orange)){
-    printf("\x1B[31m\x1B[1mAucun objet détecté!\x1B[0m\n");
-}
-//Milieux
-printf("\n\x1B[4mCALCULS DES MILIEUX :\x1B[0m\n\n");
-*milieu_bleu = trouver_milieu(objet_poss_bleu, largeur, hauteur);
-*milieu_jaune = trouver_milieu(objet_poss_jaune, largeur, hauteur);
-*milieu_orange = trouver_milieu(objet_poss_Orange, largeur, hauteur);
-if(!isObjet(objet_poss_bleu) && !isObjet(objet_poss_jaune) && !isObjet(objet_poss_Orange)){
-    printf("\x1B[31m\x1B[1mCalcul des milieux impossible il n'y a pas d'objet!\x1B[0m\n");
-}
-printf("\n\x1B[4mRAYON DES OBJETS\x1B[0m\n\n");
-//rayons
-*rayon_bleu = trouver_rayon(objet_poss_bleu, largeur, hauteur);
-*rayon_jaune = trouver_rayon(objet_poss_jaune, largeur, hauteur);
-*rayon_orange = trouver_rayon(objet_poss_Orange, largeur, hauteur);
-if(!isObjet(objet_poss_bleu) && !isObjet(objet_poss_jaune) && !isObjet(objet_poss_Orange)){
-    printf("\x1B[31m\x1B[1mCalcul des rayons impossible il n'y a pas d'objet!\x1B[0m\n");
-}
-printf("-----------------------------------------------\n\n");
-
-*largeurimage = largeur ;
-*longueurimage = hauteur ;
-
-return;
+    libererMatrices(matrices, 3, hauteur);
+    return statut;
 }
 /**
  * @}
@@ -451,16 +423,15 @@ return;
  * @param hauteur Hauteur de l'image.
  * @param largeur Largeur de l'image.
  * @param nomfichier Nom du fichier avec extension.(.dat)
+ * @return false si le groupe n'est pas un objet ou si le fichier n'a pas pu être ouvert.
 */
-void ecrireMatriceDansFichier(Groupe_Pixel_ptr groupePixel, int hauteur, int largeur,char*nomfichier) {
+bool ecrireMatriceDansFichier(Groupe_Pixel_ptr groupePixel, int hauteur, int largeur,char*nomfichier) {
+    if (!isObjet(groupePixel)) {
+        return false;
+    }
     FILE *fichier = fopen(nomfichier, "w"); // Ouvre un fichier en écriture
-   
-
-
-
-    if (fichier == NULL || !isObjet(groupePixel)) {
-        printf("Erreur lors de l'ouverture du fichier.\n");
-        return;
+    if (fichier == NULL) {
+        return false;
     }
     fprintf(fichier,"%d  ",hauteur);
     fprintf(fichier,"%d  ",largeur);
@@ -472,7 +443,7 @@ void ecrireMatriceDansFichier(Groupe_Pixel_ptr groupePixel, int hauteur, int lar
         fprintf(fichier, "\n"); // Passage à la ligne suivante dans le fichier
     }
 
-    fclose(fichier); // Ferme le fichier
+    return fclose(fichier) == 0; // Ferme le fichier
 }
 
 int dfs (int ** matrice_p , int hauteur , int largeur , int deb_i , int deb_j ,int ** visite){
@@ -14,6 +14,35 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
+
+/**
+ * @brief Boule d'une couleur cherchée dans l'image.
+ */
+typedef struct {
+    bool detecte;       /**< Le groupe de pixels de cette couleur est un objet (isObjet). */
+    int nb_pixels;      /**< Pixels dans la plage de la couleur. */
+    int milieu[2];      /**< Milieu (colonne, ligne) en pixels ; {0, 0} si la boule n'est pas détectée. */
+    int rayon;          /**< Rayon en pixels ; -1 si la boule n'est pas détectée. */
+} ObjetImage;
+
+/**
+ * @brief Résultat du traitement d'une image : ses caractéristiques et les trois boules cherchées.
+ */
+typedef struct {
+    int largeur, hauteur, nbcompo;
+    ObjetImage bleu, jaune, orange;
+} ResultatImage;
+
+/**
+ * @brief Compte rendu de analyserImage.
+ */
+typedef enum {
+    IMAGE_OK = 0,
+    IMAGE_ERREUR_FICHIER,       /**< Le fichier n'a pas pu être ouvert. */
+    IMAGE_ERREUR_FORMAT,        /**< Le fichier n'est pas une image .txt complète. */
+    IMAGE_ERREUR_MEMOIRE
+} StatutImage;
 
 typedef struct Groupe_Pixel_s * Groupe_Pixel_ptr ;
 Groupe_Pixel_ptr detecterPixelsJaune(int **matriceR, int ** matriceG, int ** matriceB,int hauteur , int largeur);
@@ -23,9 +52,10 @@ Groupe_Pixel_ptr detecterPixelsBleu(int **matriceR, int ** matriceG, int ** matr
 Groupe_Pixel_ptr alloc_Groupe_Pixel(int nbp , int** matrice_ass_param,char * couleur) ;
 Groupe_Pixel_ptr detecterPixelsOrange(int **matriceR, int ** matriceG, int ** matriceB,int hauteur , int largeur);
 bool isObjet(Groupe_Pixel_ptr groupe);
-void ecrireMatriceDansFichier(Groupe_Pixel_ptr groupePixel, int hauteur, int largeur,char*nomfichier);
+bool ecrireMatriceDansFichier(Groupe_Pixel_ptr groupePixel, int hauteur, int largeur,char*nomfichier);
 int dfs (int ** matrice_p , int hauteur , int largeur , int deb_i , int deb_j ,int ** visite);
 void trouverLePlusGros (int ** matrice , int hauteur, int largeur);
 int  trouver_rayon(Groupe_Pixel_ptr objet, int largeur , int hauteur);
-void main_it(int* largeurimage,int* longueurimage,int *rayon_bleu, int *rayon_jaune, int *rayon_orange,int **milieu_bleu, int **milieu_jaune, int **milieu_orange, char* nomFichier);
+void liberer_Groupe_Pixel(Groupe_Pixel_ptr groupe, int hauteur);
+StatutImage analyserImage(const char *nomFichier, ResultatImage *resultat);
 #endif 
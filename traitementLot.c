@@ -0,0 +1,763 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <math.h>
+#include <pthread.h>
+#include "traitementTexte.h"
+#include "lexique.h"
+#include "cacheActions.h"
+#include "planification.h"
+#include "trajectoire.h"
+#include "traitementLot.h"
+
+/**
+ * @file
+ * @brief Ce fichier rassemble les fonctions du traitement par lot de phrases.
+ *
+ * Le fichier d'entrée contient une phrase par ligne, précédée de sa langue et d'une tabulation :
+ * @code
+ * fr	avance de 1000 mètres puis tourne à gauche
+ * es	gira de 50 grados hacia la izquierda
+ * @endcode
+ * La langue peut être omise (ligne sans tabulation) ou valoir "auto" : elle est alors identifiée pendant l'analyse.
+ * Les lignes vides et celles commençant par '#' sont ignorées. Chaque phrase produit une ligne JSON
+ * contenant les ActionData obtenues, dans l'ordre du fichier d'entrée. Les verbes, objets, couleurs et directions
+ * y sont désignés par leur nom français, quelle que soit la langue de la phrase :
+ * @code
+ * {"opcode":"tourner","negation":false,"direction":"gauche","angle":50,"objet":null,"couleur":null,"objet2":null,"couleur2":null}
+ * @endcode
+ * simulerLot lit le même fichier, et écrit pour chaque phrase une ligne par scène (voir sa description).
+ */
+
+/**
+ * @defgroup lot Traitement par lot
+ * @brief Analyse d'un grand nombre de phrases en parallèle.
+ * @{
+ */
+
+/**
+ * @brief Travail d'un thread : une suite contiguë de lignes du fichier d'entrée.
+ */
+typedef struct {
+    char **lignes;        /**< Lignes à traiter (la tabulation est remplacée par '\0'). */
+    int *numeros;         /**< Numéro de chaque ligne dans le fichier d'entrée. */
+    int nb_lignes;
+    char *sortie;         /**< Lignes JSON produites. */
+    size_t taille_sortie;
+    int nb_phrases;       /**< Nombre de phrases effectivement analysées. */
+    CacheActions *cache;  /**< Cache partagé par tous les threads, NULL sans cache. */
+} TravailLot;
+
+/**
+ * @brief Ecrit une chaine JSON échappée.
+ */
+static void ecrireChaineJson(FILE *f, const char *str) {
+    fputc('"', f);
+    for (const unsigned char *c = (const unsigned char *) str; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', f);
+            fputc(*c, f);
+        } else if (*c < 0x20) {
+            fprintf(f, "\\u%04x", *c);
+        } else {
+            fputc(*c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+/**
+ * @brief Ecrit un champ JSON contenant le nom français d'un code du lexique, null pour le code 0 (aucun).
+ */
+static void ecrireNomJson(FILE *f, const char *cle, Categorie categorie, int code) {
+    const char *nom = (code == 0) ? NULL : lexique_nom(categorie, code, LANGUE_FR, false);
+
+    fprintf(f, ",\"%s\":", cle);
+    if (nom == NULL) {
+        fprintf(f, "null");
+    } else {
+        ecrireChaineJson(f, nom);
+    }
+}
+
+/**
+ * @brief Ecrit une ActionData sous forme d'objet JSON.
+ */
+static void ecrireActionJson(FILE *f, const ActionData *action) {
+    const char *opcode = (action->opcode == VERBE_AUCUN) ? NULL : lexique_nom(CAT_VERBE, action->opcode, LANGUE_FR, false);
+
+    fprintf(f, "{\"opcode\":");
+    if (opcode == NULL) {
+        fprintf(f, "null");
+    } else {
+        ecrireChaineJson(f, opcode);
+    }
+    fprintf(f, ",\"negation\":%s", action->negation ? "true" : "false");
+    ecrireNomJson(f, "direction", CAT_DIRECTION, action->direction);
+    if (action->mesure == MESURE_DISTANCE) {
+        fprintf(f, ",\"distance\":%.17g", action->valeur);
+    } else if (action->mesure == MESURE_ANGLE) {
+        fprintf(f, ",\"angle\":%.17g", action->valeur);
+    }
+    ecrireNomJson(f, "objet", CAT_OBJET, action->objet);
+    ecrireNomJson(f, "couleur", CAT_COULEUR, action->couleur);
+    ecrireNomJson(f, "objet2", CAT_OBJET, action->objet2);
+    ecrireNomJson(f, "couleur2", CAT_COULEUR, action->couleur2);
+    fputc('}', f);
+}
+
+/**
+ * @brief Sépare une ligne "langue<TAB>phrase" : la tabulation est remplacée par '\0'.
+ * @param phrase Reçoit le début de la phrase.
+ * @return Grammaire de la langue (GRAMMAIRE_AUTO sans langue), NULL si la langue est inconnue.
+ */
+static const Grammaire *separerLangue(char *ligne, const char **phrase) {
+    char *tab = strchr(ligne, '\t');
+
+    *phrase = ligne;
+    if (tab == NULL) {
+        return &GRAMMAIRE_AUTO;
+    }
+    *tab = '\0';
+    *phrase = tab + 1;
+    if (strcmp(ligne, GRAMMAIRE_FR.code) == 0) {
+        return &GRAMMAIRE_FR;
+    } else if (strcmp(ligne, GRAMMAIRE_ES.code) == 0) {
+        return &GRAMMAIRE_ES;
+    } else if (strcmp(ligne, GRAMMAIRE_AUTO.code) == 0) {
+        return &GRAMMAIRE_AUTO;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Analyse une ligne "langue<TAB>phrase" et écrit la ligne JSON correspondante.
+ * Une ligne sans langue, ou de langue "auto", est analysée avec identification automatique de la langue.
+ * @return true si la phrase a été analysée.
+ */
+static bool traiterLigne(FILE *f, char *ligne, int numero, Queue *q, CacheActions *cache) {
+    const char *phrase;
+    const Grammaire *g = separerLangue(ligne, &phrase);
+
+    fprintf(f, "{\"ligne\":%d,", numero);
+    if (g == NULL) {
+        fprintf(f, "\"langue\":");
+        ecrireChaineJson(f, ligne);
+        fprintf(f, ",\"erreur\":\"langue inconnue\"}\n");
+        return false;
+    }
+    fprintf(f, "\"phrase\":");
+    ecrireChaineJson(f, phrase);
+
+    g = cache_analyserPhrase(cache, g, phrase, q);
+
+    fprintf(f, ",\"langue\":\"%s\"", g->code);
+    fprintf(f, ",\"actions\":[");
+    for (int i = 0; !isQueueEmpty(q); i++) {
+        ActionData action = dequeue(q);
+        if (i > 0) {
+            fputc(',', f);
+        }
+        ecrireActionJson(f, &action);
+    }
+    fprintf(f, "]}\n");
+    return true;
+}
+
+static void *threadLot(void *arg) {
+    TravailLot *t = arg;
+    Queue q = createQueue();
+    FILE *f = open_memstream(&t->sortie, &t->taille_sortie);
+
+    if (f == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < t->nb_lignes; i++) {
+        if (traiterLigne(f, t->lignes[i], t->numeros[i], &q, t->cache)) {
+            t->nb_phrases++;
+        }
+    }
+    fclose(f);
+    destroyQueue(&q);
+    return NULL;
+}
+
+/**
+ * @brief Lit entièrement un fichier en mémoire.
+ * @return Contenu du fichier terminé par '\0', NULL en cas d'erreur.
+ */
+static char *lireFichier(const char *nom) {
+    FILE *f = fopen(nom, "rb");
+    char *contenu = NULL;
+    size_t taille = 0;
+
+    if (f == NULL) {
+        return NULL;
+    }
+    FILE *m = open_memstream(&contenu, &taille);
+    if (m == NULL) {
+        fclose(f);
+        return NULL;
+    }
+    char bloc[65536];
+    size_t lus;
+    bool complet = true;
+    while ((lus = fread(bloc, 1, sizeof(bloc), f)) > 0) {
+        complet = complet && fwrite(bloc, 1, lus, m) == lus;
+    }
+    if (fclose(m) != 0 || !complet) {
+        free(contenu);
+        contenu = NULL;
+    }
+    fclose(f);
+    return contenu;
+}
+
+/**
+ * @brief Découpe le contenu d'un fichier de phrases en lignes, sans copie. Les lignes vides et les commentaires
+ * sont écartés.
+ * @param lignes Reçoit les lignes retenues (à libérer).
+ * @param numeros Reçoit le numéro de chaque ligne dans le fichier (à libérer).
+ * @return Nombre de lignes retenues, -1 si la mémoire manque (rien n'est alors à libérer).
+ */
+static int decouperLignes(char *contenu, char ***lignes, int **numeros) {
+    int capacite = 1024, nb_lignes = 0, numero = 0;
+
+    *lignes = malloc(capacite * sizeof(char *));
+    *numeros = malloc(capacite * sizeof(int));
+    if (*lignes == NULL || *numeros == NULL) {
+        free(*lignes);
+        free(*numeros);
+        return -1;
+    }
+    for (char *ligne = contenu, *suivante; ligne != NULL && *ligne != '\0'; ligne = suivante) {
+        suivante = strchr(ligne, '\n');
+        if (suivante != NULL) {
+            *suivante++ = '\0';
+        }
+        numero++;
+        ligne[strcspn(ligne, "\r")] = '\0';
+        if (ligne[0] == '\0' || ligne[0] == '#') {
+            continue;
+        }
+        if (nb_lignes == capacite) {
+            char **nouvelles_lignes = realloc(*lignes, capacite * 2 * sizeof(char *));
+            if (nouvelles_lignes != NULL) {
+                *lignes = nouvelles_lignes;
+            }
+            int *nouveaux_numeros = realloc(*numeros, capacite * 2 * sizeof(int));
+            if (nouveaux_numeros != NULL) {
+                *numeros = nouveaux_numeros;
+            }
+            if (nouvelles_lignes == NULL || nouveaux_numeros == NULL) {
+                free(*lignes);
+                free(*numeros);
+                return -1;
+            }
+            capacite *= 2;
+        }
+        (*lignes)[nb_lignes] = ligne;
+        (*numeros)[nb_lignes++] = numero;
+    }
+    return nb_lignes;
+}
+
+/**
+ * @brief Analyse toutes les phrases d'un fichier et écrit les ActionData obtenues en lignes JSON.
+ * Aucune entrée n'est demandée à l'utilisateur ; le débit obtenu est affiché sur la sortie d'erreur.
+ * @param fichier_entree Fichier de phrases "langue<TAB>phrase".
+ * @param fichier_sortie Fichier JSON lines à écrire, NULL pour la sortie standard.
+ * @param nb_threads Nombre de threads d'analyse, 0 pour un thread par coeur.
+ * @param taille_cache Nombre de phrases distinctes mémorisées par le cache, 0 pour analyser chaque phrase.
+ * @return 0 en cas de succès, 1 si un fichier n'a pas pu être ouvert ou si la mémoire manque.
+ */
+int traiterLot(const char *fichier_entree, const char *fichier_sortie, int nb_threads, size_t taille_cache) {
+    char *contenu = lireFichier(fichier_entree);
+    if (contenu == NULL) {
+        perror(fichier_entree);
+        return 1;
+    }
+    FILE *sortie = (fichier_sortie != NULL) ? fopen(fichier_sortie, "w") : stdout;
+    if (sortie == NULL) {
+        perror(fichier_sortie);
+        free(contenu);
+        return 1;
+    }
+
+    char **lignes;
+    int *numeros;
+    int nb_lignes = decouperLignes(contenu, &lignes, &numeros);
+    if (nb_lignes < 0) {
+        fprintf(stderr, "Erreur: mémoire insuffisante.\n");
+        if (sortie != stdout) {
+            fclose(sortie);
+        }
+        free(contenu);
+        return 1;
+    }
+
+    if (nb_threads <= 0) {
+        nb_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (nb_threads > nb_lignes) {
+        nb_threads = nb_lignes > 0 ? nb_lignes : 1;
+    }
+
+    CacheActions *cache = cache_creer(taille_cache);
+    struct timespec debut, fin;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+
+    //Chaque thread traite une suite contiguë de lignes pour que la sortie reste dans l'ordre.
+    TravailLot *travaux = calloc(nb_threads, sizeof(TravailLot));
+    pthread_t *threads = malloc(nb_threads * sizeof(pthread_t));
+    for (int t = 0; t < nb_threads; t++) {
+        int premier = (int) ((long) nb_lignes * t / nb_threads);
+        int dernier = (int) ((long) nb_lignes * (t + 1) / nb_threads);
+        travaux[t].lignes = lignes + premier;
+        travaux[t].numeros = numeros + premier;
+        travaux[t].nb_lignes = dernier - premier;
+        travaux[t].cache = cache;
+        pthread_create(&threads[t], NULL, threadLot, &travaux[t]);
+    }
+    int nb_phrases = 0;
+    for (int t = 0; t < nb_threads; t++) {
+        pthread_join(threads[t], NULL);
+        nb_phrases += travaux[t].nb_phrases;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double duree = (fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) * 1e-9;
+
+    for (int t = 0; t < nb_threads; t++) {
+        if (travaux[t].sortie != NULL) {
+            fwrite(travaux[t].sortie, 1, travaux[t].taille_sortie, sortie);
+        }
+        free(travaux[t].sortie);
+    }
+    if (sortie != stdout) {
+        fclose(sortie);
+    }
+
+    fprintf(stderr, "%d phrases analysées en %.3f s avec %d thread(s) : %.0f phrases/s\n",
+            nb_phrases, duree, nb_threads, duree > 0 ? nb_phrases / duree : 0.0);
+    if (cache != NULL) {
+        unsigned long succes, echecs;
+        cache_statistiques(cache, &succes, &echecs);
+        fprintf(stderr, "Cache : %lu succès, %lu échecs\n", succes, echecs);
+        cache_detruire(cache);
+    }
+
+    free(threads);
+    free(travaux);
+    free(numeros);
+    free(lignes);
+    free(contenu);
+    return 0;
+}
+
+/**
+ * @brief Scène d'une simulation par lot, avec sa carte et son planificateur calculés une fois pour tous les threads.
+ */
+typedef struct {
+    const Scene *scene;
+    const char *nom;
+    Carte carte;              /**< Utilisée si options->obstacles. */
+    Planificateur pl;         /**< Utilisé si options->planifier. */
+} SceneLot;
+
+/**
+ * @brief Travail d'un thread de simulation : une suite contiguë de couples (phrase, scène), phrase par phrase.
+ */
+typedef struct {
+    const char **phrases;           /**< Phrase de chaque ligne. */
+    const Grammaire **grammaires;   /**< Grammaire de chaque ligne, NULL si sa langue est inconnue. */
+    const int *numeros;
+    const SceneLot *scenes;
+    int nb_scenes;
+    long premier, dernier;          /**< Couples traités : de premier (inclus) à dernier (exclu). */
+    const OptionsSimulationLot *options;
+    char *sortie;
+    size_t taille_sortie;
+    JournalTrajectoire journal;     /**< Simulation de référence en cours d'enregistrement. */
+    FILE *f_journal;                /**< Journal du thread, NULL sans journal. */
+    char *octets_journal;
+    size_t taille_journal;
+    long nb_simulations, nb_bruitees;    /**< Simulations exécutées, dont bruitées. */
+    double temps_simule;            /**< Durée simulée des simulations de référence, en secondes. */
+    double somme_erreurs, erreur_max;    /**< Ecart de position de tous les tirages bruités à leur référence. */
+    bool erreur;                    /**< La mémoire a manqué : la sortie ou le journal du thread est incomplet. */
+} TravailSimulation;
+
+/**
+ * @brief Tire un nombre selon la loi normale centrée réduite (Box-Muller).
+ */
+static double tirageNormal(unsigned int *graine) {
+    double u = (rand_r(graine) + 1.0) / (RAND_MAX + 2.0), v = (rand_r(graine) + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+/**
+ * @brief Erreur d'odométrie : chaque rotation est faussée d'un angle d'écart type bruit_angle, chaque distance
+ * d'une part d'écart type bruit_distance. Les commandes sans valeur (aller vers une boule ou la contourner sans
+ * planification) sont exécutées exactement.
+ */
+static void bruiter(const Commande *commandes, int nb_commandes, Commande *bruitees, const OptionsSimulationLot *options, unsigned int *graine) {
+    for (int i = 0; i < nb_commandes; i++) {
+        bruitees[i] = commandes[i];
+        switch (commandes[i].opcode) {
+            case COMMANDE_GAUCHE:
+            case COMMANDE_DROITE:
+                bruitees[i].valeur += options->bruit_angle * tirageNormal(graine);
+                break;
+            case COMMANDE_AVANCER:
+            case COMMANDE_RECULER:
+            case COMMANDE_LIGNE:
+                bruitees[i].valeur *= 1.0 + options->bruit_distance * tirageNormal(graine);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Exécute des commandes dans une scène depuis la pose de départ.
+ */
+static void executerScene(Simulation *sim, const SceneLot *s, const OptionsSimulationLot *options, const Commande *commandes, int nb_commandes) {
+    simulation_initialiser(sim, s->scene);
+    simulation_horloge(sim, &options->horloge);
+    if (options->obstacles) {
+        simulation_obstacles(sim, &s->carte);
+    }
+    simulation_executer(sim, commandes, nb_commandes);
+}
+
+/**
+ * @brief Simule une phrase dans une scène : une fois sans bruit, puis options->nb_tirages fois avec bruit, et écrit
+ * la ligne JSON de la pose de référence et des statistiques des poses bruitées.
+ */
+static void simulerCouple(TravailSimulation *t, FILE *f, long couple, const ActionData *actions, int nb_actions, Commande *commandes, Commande *planifiees, Commande *bruitees) {
+    const OptionsSimulationLot *options = t->options;
+    const SceneLot *s = &t->scenes[couple % t->nb_scenes];
+    //La graine ne dépend que du couple : le résultat est le même quel que soit le nombre de threads.
+    unsigned int graine = options->graine ^ (unsigned int) (couple * 2654435761UL);
+    double somme_x = 0.0, somme_y = 0.0, carres_x = 0.0, carres_y = 0.0, somme_cap = 0.0, carres_cap = 0.0;
+    double erreurs = 0.0, erreur_max = 0.0, collisions = 0.0;
+    Simulation sim;
+    int nb_commandes = traduireActions(s->scene, actions, nb_actions, commandes);
+
+    if (options->planifier) {
+        nb_commandes = planifierCommandes(&s->pl, commandes, nb_commandes, planifiees);
+        commandes = planifiees;
+    }
+    simulation_initialiser(&sim, s->scene);
+    simulation_horloge(&sim, &options->horloge);
+    if (options->obstacles) {
+        simulation_obstacles(&sim, &s->carte);
+    }
+    if (t->f_journal != NULL) {
+        journal_commencer(&t->journal, &sim, t->numeros[couple / t->nb_scenes], s->nom);
+        simulation_journaliser(&sim, &t->journal);
+    }
+    simulation_executer(&sim, commandes, nb_commandes);
+    if (t->f_journal != NULL) {
+        journal_terminer(&t->journal, &sim);
+        if (!journal_ecrire(&t->journal, t->f_journal)) {    //Le journal du fichier serait incomplet.
+            t->erreur = true;
+        }
+    }
+    Pose reference = sim.pose;
+    double cap_reference = simulation_cap(&sim);
+
+    fprintf(f, "{\"ligne\":%d,\"scene\":", t->numeros[couple / t->nb_scenes]);
+    ecrireChaineJson(f, s->nom);
+    fprintf(f, ",\"commandes\":%d,\"x\":%.17g,\"y\":%.17g,\"cap\":%.17g,\"collisions\":%d,\"duree\":%.9g",
+            nb_commandes, reference.x, reference.y, cap_reference, sim.collisions, sim.temps);
+    t->temps_simule += sim.temps;
+
+    for (int i = 0; i < options->nb_tirages; i++) {
+        bruiter(commandes, nb_commandes, bruitees, options, &graine);
+        executerScene(&sim, s, options, bruitees, nb_commandes);
+        double ecart_cap = fmod(simulation_cap(&sim) - cap_reference + 540.0, 360.0) - 180.0;
+        double erreur = hypot(sim.pose.x - reference.x, sim.pose.y - reference.y);
+        somme_x += sim.pose.x;
+        somme_y += sim.pose.y;
+        carres_x += sim.pose.x * sim.pose.x;
+        carres_y += sim.pose.y * sim.pose.y;
+        somme_cap += ecart_cap;
+        carres_cap += ecart_cap * ecart_cap;
+        erreurs += erreur;
+        erreur_max = fmax(erreur_max, erreur);
+        collisions += sim.collisions;
+    }
+    t->nb_simulations += 1 + options->nb_tirages;
+    t->nb_bruitees += options->nb_tirages;
+    t->somme_erreurs += erreurs;
+    t->erreur_max = fmax(t->erreur_max, erreur_max);
+
+    if (options->nb_tirages > 0) {
+        double n = options->nb_tirages, mx = somme_x / n, my = somme_y / n, mc = somme_cap / n;
+        fprintf(f, ",\"tirages\":%d,\"moyenne\":[%.9g,%.9g],\"ecart_type\":[%.9g,%.9g]", options->nb_tirages,
+                mx, my, sqrt(fmax(carres_x / n - mx * mx, 0.0)), sqrt(fmax(carres_y / n - my * my, 0.0)));
+        fprintf(f, ",\"ecart_cap\":[%.9g,%.9g],\"erreur_position\":[%.9g,%.9g],\"collisions_moyennes\":%.9g",
+                mc, sqrt(fmax(carres_cap / n - mc * mc, 0.0)), erreurs / n, erreur_max, collisions / n);
+    }
+    fprintf(f, "}\n");
+}
+
+static void *threadSimulation(void *arg) {
+    TravailSimulation *t = arg;
+    Queue q = createQueue();
+    FILE *f = open_memstream(&t->sortie, &t->taille_sortie);
+    ActionData *actions = NULL;
+    Commande *commandes = NULL, *planifiees = NULL, *bruitees = NULL;
+    int capacite = 0, nb_actions = 0;
+    long phrase = -1;
+
+    if (f == NULL) {
+        t->erreur = true;
+        return NULL;
+    }
+    if (t->options->fichier_journal != NULL) {
+        journal_initialiser(&t->journal);
+        t->f_journal = open_memstream(&t->octets_journal, &t->taille_journal);
+        t->erreur = (t->f_journal == NULL);
+    }
+    for (long couple = t->premier; couple < t->dernier; couple++) {
+        //Les couples sont rangés phrase par phrase : chaque phrase n'est analysée qu'une fois par thread.
+        if (couple / t->nb_scenes != phrase) {
+            phrase = couple / t->nb_scenes;
+            nb_actions = 0;
+            if (t->grammaires[phrase] != NULL) {
+                analyserPhrase(t->grammaires[phrase], t->phrases[phrase], &q);
+            }
+            if (q.size > capacite) {
+                //Chaque tampon n'est remplacé que s'il a pu grandir : les autres restent libérables.
+                size_t n = (size_t) q.size * COMMANDES_PAR_ACTION;
+                ActionData *a = realloc(actions, (size_t) q.size * sizeof(ActionData));
+                actions = (a != NULL) ? a : actions;
+                Commande *c = realloc(commandes, n * sizeof(Commande));
+                commandes = (c != NULL) ? c : commandes;
+                Commande *p = realloc(planifiees, n * COMMANDES_PAR_PLANIFICATION * sizeof(Commande));
+                planifiees = (p != NULL) ? p : planifiees;
+                Commande *b = realloc(bruitees, n * COMMANDES_PAR_PLANIFICATION * sizeof(Commande));
+                bruitees = (b != NULL) ? b : bruitees;
+                if (a == NULL || c == NULL || p == NULL || b == NULL) {
+                    t->erreur = true;
+                    break;
+                }
+                capacite = q.size;
+            }
+            while (!isQueueEmpty(&q)) {
+                actions[nb_actions++] = dequeue(&q);
+            }
+        }
+        if (t->grammaires[phrase] == NULL) {
+            fprintf(f, "{\"ligne\":%d,\"scene\":", t->numeros[phrase]);
+            ecrireChaineJson(f, t->scenes[couple % t->nb_scenes].nom);
+            fprintf(f, ",\"erreur\":\"langue inconnue\"}\n");
+            continue;
+        }
+        simulerCouple(t, f, couple, actions, nb_actions, commandes, planifiees, bruitees);
+    }
+    //Un flux open_memstream perd son tampon si celui-ci ne peut pas grandir, même à la fermeture.
+    if (fclose(f) != 0 || t->sortie == NULL) {
+        t->erreur = true;
+    }
+    if (t->f_journal != NULL) {
+        if (fclose(t->f_journal) != 0 || t->octets_journal == NULL) {
+            t->erreur = true;
+        }
+        journal_detruire(&t->journal);
+    }
+    free(actions);
+    free(commandes);
+    free(planifiees);
+    free(bruitees);
+    destroyQueue(&q);
+    return NULL;
+}
+
+/**
+ * @brief Simule toutes les phrases d'un fichier dans toutes les scènes, sans Python, et écrit la pose finale de
+ * chaque couple (phrase, scène) en lignes JSON, phrase par phrase et dans l'ordre des scènes.
+ * Les commandes sont celles de modeliserActions (traduireActions, puis planifierCommandes si options->planifier).
+ * "duree" est le temps simulé de la référence, selon options->horloge.
+ * Avec des tirages, chaque couple est rejoué avec une erreur d'odométrie aléatoire et la ligne contient en plus la
+ * moyenne et l'écart type des positions finales, l'écart de cap à la référence, et l'écart de position à la
+ * référence (moyen et maximal) :
+ * @code
+ * {"ligne":1,"scene":"images/IMG_5389.txt","commandes":2,"x":0,"y":-40,"cap":0,"collisions":0,"duree":0.73,"tirages":100,"moyenne":[0.1,-40.02],"ecart_type":[0.8,0.79],"ecart_cap":[0.03,1.02],"erreur_position":[0.98,2.6],"collisions_moyennes":0}
+ * @endcode
+ * Le débit et l'écart de position global sont affichés sur la sortie d'erreur. Avec options->fichier_journal, la
+ * simulation de référence de chaque couple est enregistrée dans un journal de trajectoire, dans le même ordre.
+ * @param fichier_entree Fichier de phrases "langue<TAB>phrase".
+ * @param fichier_sortie Fichier JSON lines à écrire, NULL pour la sortie standard.
+ * @param scenes Scènes de simulation.
+ * @param noms Nom de chaque scène, recopié dans la sortie.
+ * @param nb_threads Nombre de threads de simulation, 0 pour un thread par coeur.
+ * @return 0 en cas de succès, 1 si un fichier n'a pas pu être ouvert ou si la mémoire manque.
+ */
+int simulerLot(const char *fichier_entree, const char *fichier_sortie, const Scene *scenes, const char *const *noms, int nb_scenes, const OptionsSimulationLot *options, int nb_threads) {
+    char *contenu = lireFichier(fichier_entree);
+    if (contenu == NULL) {
+        perror(fichier_entree);
+        return 1;
+    }
+    FILE *sortie = (fichier_sortie != NULL) ? fopen(fichier_sortie, "w") : stdout;
+    if (sortie == NULL) {
+        perror(fichier_sortie);
+        free(contenu);
+        return 1;
+    }
+
+    char **lignes;
+    int *numeros;
+    int nb_lignes = decouperLignes(contenu, &lignes, &numeros);
+    if (nb_lignes < 0) {
+        fprintf(stderr, "Erreur: mémoire insuffisante.\n");
+        if (sortie != stdout) {
+            fclose(sortie);
+        }
+        free(contenu);
+        return 1;
+    }
+    //La langue est séparée avant le partage : une phrase peut être simulée par deux threads.
+    const char **phrases = malloc((nb_lignes + 1) * sizeof(char *));
+    const Grammaire **grammaires = malloc((nb_lignes + 1) * sizeof(Grammaire *));
+    SceneLot *contextes = calloc(nb_scenes > 0 ? nb_scenes : 1, sizeof(SceneLot));
+    int erreur = 0;
+    if (phrases == NULL || grammaires == NULL || contextes == NULL) {
+        fprintf(stderr, "Erreur: mémoire insuffisante.\n");
+        erreur = 1;
+        nb_lignes = nb_scenes = 0;    //Rien n'est préparé ni simulé.
+    }
+    for (int i = 0; i < nb_lignes; i++) {
+        grammaires[i] = separerLangue(lignes[i], &phrases[i]);
+    }
+
+    for (int i = 0; i < nb_scenes; i++) {
+        contextes[i].scene = &scenes[i];
+        contextes[i].nom = noms[i];
+        if (options->obstacles && !simulation_construireCarte(&contextes[i].carte, &scenes[i])) {
+            fprintf(stderr, "Erreur: mémoire insuffisante.\n");
+            erreur = 1;
+        }
+        if (options->planifier) {
+            planificateur_initialiser(&contextes[i].pl, &scenes[i]);
+        }
+    }
+
+    long nb_couples = (long) nb_lignes * nb_scenes;
+    if (nb_threads <= 0) {
+        nb_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (nb_threads > nb_couples) {
+        nb_threads = nb_couples > 0 ? (int) nb_couples : 1;
+    }
+
+    struct timespec debut, fin;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+
+    TravailSimulation *travaux = calloc(nb_threads, sizeof(TravailSimulation));
+    pthread_t *threads = malloc(nb_threads * sizeof(pthread_t));
+    int nb_lances = 0;
+    if (travaux == NULL || threads == NULL) {
+        fprintf(stderr, "Erreur: mémoire insuffisante.\n");
+        erreur = 1;
+        nb_threads = 0;
+    }
+    for (int t = 0; t < nb_threads && erreur == 0; t++) {
+        travaux[t].phrases = phrases;
+        travaux[t].grammaires = grammaires;
+        travaux[t].numeros = numeros;
+        travaux[t].scenes = contextes;
+        travaux[t].nb_scenes = nb_scenes;
+        travaux[t].premier = nb_couples * t / nb_threads;
+        travaux[t].dernier = nb_couples * (t + 1) / nb_threads;
+        travaux[t].options = options;
+        if (pthread_create(&threads[t], NULL, threadSimulation, &travaux[t]) != 0) {
+            fprintf(stderr, "Erreur: impossible de créer un thread de simulation.\n");
+            erreur = 1;
+        } else {
+            nb_lances++;
+        }
+    }
+    long nb_simulations = 0, nb_bruitees = 0;
+    double somme_erreurs = 0.0, erreur_max = 0.0, temps_simule = 0.0;
+    bool memoire_manquante = false;
+    for (int t = 0; t < nb_lances; t++) {
+        pthread_join(threads[t], NULL);
+        memoire_manquante = memoire_manquante || travaux[t].erreur;
+        nb_simulations += travaux[t].nb_simulations;
+        nb_bruitees += travaux[t].nb_bruitees;
+        temps_simule += travaux[t].temps_simule;
+        somme_erreurs += travaux[t].somme_erreurs;
+        erreur_max = fmax(erreur_max, travaux[t].erreur_max);
+    }
+    if (memoire_manquante) {
+        fprintf(stderr, "Erreur: mémoire insuffisante, résultats incomplets.\n");
+        erreur = 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double duree = (fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) * 1e-9;
+
+    for (int t = 0; t < nb_threads; t++) {
+        if (travaux[t].sortie != NULL) {
+            fwrite(travaux[t].sortie, 1, travaux[t].taille_sortie, sortie);
+        }
+        free(travaux[t].sortie);
+    }
+    if (sortie != stdout) {
+        fclose(sortie);
+    }
+    if (options->fichier_journal != NULL && erreur == 0) {
+        FILE *journal = fopen(options->fichier_journal, "wb");
+        for (int t = 0; t < nb_threads && journal != NULL; t++) {
+            if (travaux[t].f_journal == NULL || fwrite(travaux[t].octets_journal, 1, travaux[t].taille_journal, journal) != travaux[t].taille_journal) {
+                erreur = 1;
+            }
+        }
+        if (journal == NULL || fclose(journal) != 0) {
+            perror(options->fichier_journal);
+            erreur = 1;
+        }
+    }
+    for (int t = 0; t < nb_threads; t++) {
+        free(travaux[t].octets_journal);
+    }
+
+    if (erreur == 0) {
+        fprintf(stderr, "%ld simulations (%d phrases x %d scènes, %d tirages) en %.3f s avec %d thread(s) : %.0f simulations/s\n",
+                nb_simulations, nb_lignes, nb_scenes, options->nb_tirages, duree, nb_threads, duree > 0 ? nb_simulations / duree : 0.0);
+        fprintf(stderr, "Temps simulé : %.1f s pour les seules références, %.0f fois le temps réel écoulé\n",
+                temps_simule, duree > 0 ? temps_simule / duree : 0.0);
+        if (nb_bruitees > 0) {
+            fprintf(stderr, "Ecart de position dû au bruit : %.3f en moyenne, %.3f au plus\n",
+                    somme_erreurs / nb_bruitees, erreur_max);
+        }
+    }
+
+    for (int i = 0; i < nb_scenes; i++) {
+        if (options->obstacles) {
+            carte_detruire(&contextes[i].carte);
+        }
+    }
+    free(contextes);
+    free(threads);
+    free(travaux);
+    free(grammaires);
+    free(phrases);
+    free(numeros);
+    free(lignes);
+    free(contenu);
+    return erreur;
+}
+
+/**
+ * @}
+ */
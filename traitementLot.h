@@ -0,0 +1,33 @@
+/**
+ * @file
+ * @brief Ce fichier contient les déclarations du traitement par lot de phrases.
+ * Il permet de rejouer un fichier de phrases étiquetées par leur langue, sans aucune interaction
+ * avec le terminal, en répartissant l'analyse sur plusieurs threads, ou de simuler chaque phrase dans chaque
+ * scène d'un ensemble de scènes, avec une erreur d'odométrie aléatoire, pour mesurer où le robot arrive.
+ */
+
+#ifndef TRAITEMENTLOT_H
+#define TRAITEMENTLOT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "simulation.h"
+
+/**
+ * @brief Options de simulerLot.
+ */
+typedef struct {
+    int nb_tirages;            /**< Simulations bruitées de chaque couple (phrase, scène), en plus de la référence. */
+    double bruit_distance;     /**< Ecart type de l'erreur relative des distances parcourues (0.02 pour 2 %). */
+    double bruit_angle;        /**< Ecart type de l'erreur des rotations, en degrés. */
+    unsigned int graine;       /**< Graine des tirages : une même graine redonne les mêmes résultats. */
+    bool obstacles;            /**< Les boules arrêtent le robot (simulation_obstacles). */
+    bool planifier;            /**< Les autres boules sont contournées (planifierCommandes). */
+    const char *fichier_journal;    /**< Journal de trajectoire des simulations de référence, NULL pour aucun. */
+    ParametresHorloge horloge;      /**< Horloge des mouvements ; le facteur de temps réel vaut en général 0. */
+} OptionsSimulationLot;
+
+int traiterLot(const char *fichier_entree, const char *fichier_sortie, int nb_threads, size_t taille_cache);
+int simulerLot(const char *fichier_entree, const char *fichier_sortie, const Scene *scenes, const char *const *noms, int nb_scenes, const OptionsSimulationLot *options, int nb_threads);
+
+#endif
@@ -6,58 +6,107 @@
 #include "stdbool.h"
 #include "ctype.h"
 #include "traitementTexte.h"
+#include "lexique.h"
+#include "normalisation.h"
 
 /**
  * @file
  * @brief Ce fichier rassemble les fonctions utiles au traitement de texte
 */
 
+/**
+ * @defgroup file File d'actions
+ * @brief File circulaire contiguë d'ActionData : enfiler et défiler ne passent pas par l'allocateur.
+ * @{
+ */
+
+static ActionData *tamponQueue(Queue* q) {    //Tampon utilisé par la file : intégré ou alloué.
+    return q->donnees != NULL ? q->donnees : q->integre;
+}
+
 Queue createQueue() {    //Initialise et renvoie une nouvelle file vide.
     Queue q;
-    q.front = q.rear = NULL;
+    q.donnees = NULL;
+    q.capacite = QUEUE_CAPACITE_INTEGREE;
+    q.debut = 0;
     q.size = 0;
+    q.fixe = false;
     return q;
 }
 
-void enqueue(Queue* q, ActionData data) {    //Rajoute un élément à la file.
-    Node* temp = (Node*) malloc(sizeof(Node));
-    temp->data = data;
-    temp->next = NULL;
-
-    if (q->rear == NULL) {    //Si la file est vide, le nouvel élément devient à la fois le premier et le dernier élément.
-        q->front = q->rear = temp;
-        q->size = 1;
-        return;
-    }
+Queue createQueueFixe() {    //File vide qui n'utilisera jamais que son tampon intégré.
+    Queue q = createQueue();
+    q.fixe = true;
+    return q;
+}
 
-    q->rear->next = temp;    //Sinon, il est rajouté à la fin et devient le nouvel élément rear.
-    q->rear = temp;
-    q->size++;    //Incrémente la taille de la file.
+void destroyQueue(Queue* q) {    //Libère le tampon alloué éventuel, la file redevient vide.
+    free(q->donnees);
+    q->donnees = NULL;
+    q->capacite = QUEUE_CAPACITE_INTEGREE;
+    q->debut = 0;
+    q->size = 0;
 }
 
-ActionData dequeue(Queue* q) {    //Dégage un élément à la file.
-    if (q->front == NULL) {    //Si la file est deja vide on affichera une erreur.
-        fprintf(stderr, "Erreur: La file est deja vide.\n");
-        exit(EXIT_FAILURE);
+/**
+ * @brief Agrandit si besoin le tampon de la file pour qu'il puisse contenir au moins capacite éléments.
+ * C'est la seule fonction de la file qui alloue de la mémoire.
+ * @return false si la file est fixe et trop petite, ou si l'allocation échoue.
+ */
+bool reserveQueue(Queue* q, int capacite) {
+    if (capacite <= q->capacite) {
+        return true;
     }
+    if (q->fixe) {
+        return false;
+    }
+    int nouvelle = q->capacite;
+    while (nouvelle < capacite) {
+        nouvelle *= 2;
+    }
+    ActionData *donnees = malloc(nouvelle * sizeof(ActionData));
+    if (donnees == NULL) {
+        return false;
+    }
+    ActionData *ancien = tamponQueue(q);
+    for (int i = 0; i < q->size; i++) {    //Les éléments sont recopiés dans l'ordre, à partir du début du nouveau tampon.
+        donnees[i] = ancien[(q->debut + i) % q->capacite];
+    }
+    free(q->donnees);
+    q->donnees = donnees;
+    q->capacite = nouvelle;
+    q->debut = 0;
+    return true;
+}
 
-    Node *temp = q->front;    //Un pointeur temporaire temp est créé pour conserver le pointeur vers le noeud de tête actuel, qui sera retiré.
-    ActionData data = temp->data;  //On copie tous les parametres de data.
-
-    q->front = q->front->next;    //Le pointeur front de la file est déplacé vers le nœud suivant, car le nœud de tête actuel est sur le point d'être supprimé.
-    if (q->front == NULL) {    //Si après cette opération, q->front devient NULL, cela signifie que la file est maintenant vide.
-        q->rear = NULL;    //Par conséquent, q->rear est également mis à NULL.
+bool enqueue(Queue* q, ActionData data) {    //Rajoute un élément à la fin de la file, false si elle est fixe et pleine.
+    if (q->size == q->capacite && !reserveQueue(q, q->capacite * 2)) {
+        return false;
     }
-    q->size--;    //Et on met a jour la taille de la file.
+    tamponQueue(q)[(q->debut + q->size) % q->capacite] = data;
+    q->size++;
+    return true;
+}
 
-    free(temp);    //On libere de la mémoire.
-    return data;    //La focntion retourne finalement les parametres de data qui viennent d'étre enlevés.
+ActionData dequeue(Queue* q) {    //Dégage le premier élément de la file. Sur une file vide, renvoie une action vide.
+    ActionData data = {0};
+    if (q->size == 0) {
+        return data;
+    }
+    data = tamponQueue(q)[q->debut];
+    q->debut = (q->debut + 1) % q->capacite;
+    q->size--;
+    return data;
 }
 
-int isQueueEmpty(Queue q) {    //Fonction qui nous indiquera simplement si la file est vide ou pas et renvoie 1 pour un front NULL.
-    return (q.front == NULL);
+int isQueueEmpty(const Queue* q) {    //Renvoie 1 si la file est vide.
+    return (q->size == 0);
 }
 
+/**
+ * @}
+ */
+
 /**
  * @defgroup fonctions_sec Fonctions partie texte secondaires
  * @brief Fonctions utilisés dans les fonctions principales du traitement de phrase
@@ -75,14 +124,166 @@ double convertDouble(char *str) {
 }
 
 /**
- * @brief Fonction pour passer n'importe quelle chaine en minuscule.
- * @param str Pointeur vers une chaine de caractères d'un mot quelconque
+ * @brief Découpe une chaine en mots sans la modifier ni copier : chaque appel renvoie le mot suivant.
+ * Contrairement à strtok, l'état du découpage est entièrement porté par le curseur.
+ * @param curseur Position courante dans la chaine, avancée après le mot renvoyé.
+ * @param separateurs Caractères séparant les mots.
+ * @param s Reçoit le mot trouvé.
+ * @return false s'il n'y a plus de mot.
+ */
+
+bool segment_suivant(const char **curseur, const char *separateurs, Segment *s) {
+    const char *c = *curseur + strspn(*curseur, separateurs);
+    if (*c == '\0') {
+        *curseur = c;
+        return false;
+    }
+    s->debut = c;
+    s->longueur = strcspn(c, separateurs);
+    *curseur = c + s->longueur;
+    return true;
+}
+
+/**
+ * @brief Equivalent de convertDouble pour un segment : lit un nombre décimal au début du segment
+ * sans jamais lire au-delà de sa longueur.
+ * @return Valeur lue, 0 si le segment ne commence pas par un nombre.
+ */
+
+double segment_nombre(Segment s) {
+    const char *c = s.debut, *fin = s.debut + s.longueur;
+    double valeur = 0, signe = 1;
+    bool chiffres = false;
+
+    if (c < fin && (*c == '-' || *c == '+')) {
+        signe = (*c++ == '-') ? -1 : 1;
+    }
+    for (; c < fin && isdigit((unsigned char) *c); c++, chiffres = true) {
+        valeur = valeur * 10 + (*c - '0');
+    }
+    if (c < fin && *c == '.') {
+        double rang = 0.1;
+        for (c++; c < fin && isdigit((unsigned char) *c); c++, chiffres = true, rang /= 10) {
+            valeur += (*c - '0') * rang;
+        }
+    }
+    if (!chiffres) {
+        return 0;
+    }
+    if (c + 1 < fin && (*c == 'e' || *c == 'E')) {    //Exposant, comme strtod.
+        const char *e = c + 1;
+        int signe_exp = 1, exposant = 0;
+        if (*e == '-' || *e == '+') {
+            signe_exp = (*e++ == '-') ? -1 : 1;
+        }
+        if (e < fin && isdigit((unsigned char) *e)) {
+            for (; e < fin && isdigit((unsigned char) *e) && exposant < 400; e++) {
+                exposant = exposant * 10 + (*e - '0');
+            }
+            for (; exposant > 0; exposant--) {
+                valeur = (signe_exp > 0) ? valeur * 10 : valeur / 10;
+            }
+        }
+    }
+    return signe * valeur;
+}
+
+/**
+ * @brief Fonction pour passer n'importe quelle chaine en minuscule. Les lettres accentuées sont aussi
+ * remplacées par leur lettre de base ("MÈTRES" devient "metres"), la chaine ne peut que raccourcir.
+ * @param str Pointeur vers une chaine de caractères UTF-8 d'un mot quelconque
  */
 
 void toLowercase(char *str) {
-    for (int i = 0; str[i]; i++) {
-        str[i] = tolower((unsigned char) str[i]);
+    str[normaliser_texte(str, strlen(str), str)] = '\0';
+}
+
+/**
+ * @brief Initialise l'automate de reconnaissance des nombres écrits en lettres.
+ * @param a Automate à initialiser.
+ */
+
+void nombre_initialiser(AutomateNombre *a) {
+    a->total = 0;
+    a->courant = 0;
+    a->dernier = 0;
+    a->actif = false;
+    a->liaison = NULL;
+}
+
+/**
+ * @brief Fait avancer l'automate d'un mot. La valeur des nombres composés ("quatre vingt dix neuf",
+ * "ciento veinte", "vingt et un", "treinta y cinco") est calculée au fil des mots, en une seule passe.
+ * @param a Automate.
+ * @param e Entrée du lexique du mot (NULL si le mot est inconnu).
+ * @return true si le mot fait partie du nombre en cours, false sinon.
+ */
+
+bool nombre_ajouter(AutomateNombre *a, const EntreeLexique *e) {
+    if (a->actif && a->liaison == NULL && lexique_est(e, CAT_ET)) {    //"vingt et un" : la liaison reste en attente du mot suivant.
+        a->liaison = e;
+        return true;
+    }
+    if (!lexique_est(e, CAT_NOMBRE)) {
+        return false;
+    }
+
+    long v = (long) e->valeur;
+    long unites = a->courant % 100;
+    switch (e->code) {
+        case NOMBRE_MILLE:    //"deux mille" : multiplie tout ce qui précède.
+            a->total += (a->courant == 0 ? 1 : a->courant) * v;
+            a->courant = 0;
+            break;
+        case NOMBRE_CENT:    //"deux cent", "cent" : multiplie les unités en cours.
+            a->courant += (unites == 0 ? 1 : unites) * v - unites;
+            break;
+        case NOMBRE_VINGT:    //"quatre vingt" : multiplie le mot précédent s'il vient d'être ajouté.
+            if (a->actif && a->liaison == NULL && a->dernier >= 2 && a->dernier < 20 && unites == a->dernier) {
+                a->courant += a->dernier * (v - 1);
+                break;
+            }
+            a->courant += v;
+            break;
+        default:
+            a->courant += v;
     }
+    a->dernier = (int) v;
+    a->actif = true;
+    a->liaison = NULL;
+    return true;
+}
+
+/**
+ * @brief Termine le nombre en cours et réinitialise l'automate.
+ * @param a Automate.
+ * @param liaison Reçoit la liaison ("et", "y") restée en attente à la fin du nombre, NULL sinon.
+ * @return Valeur du nombre reconnu.
+ */
+
+long nombre_terminer(AutomateNombre *a, const EntreeLexique **liaison) {
+    long valeur = a->total + a->courant;
+    if (liaison != NULL) {
+        *liaison = a->liaison;
+    }
+    nombre_initialiser(a);
+    return valeur;
+}
+
+/**
+ * @brief Calcule la valeur de tous les mots-nombres d'une chaine, les autres mots étant ignorés.
+ * La chaine n'est pas modifiée.
+ */
+
+static int nombreEnLettres(const char *str, int langue) {
+    AutomateNombre a;
+    Segment mot;
+    nombre_initialiser(&a);
+
+    while (segment_suivant(&str, " ',.-", &mot)) {
+        nombre_ajouter(&a, lexique_chercher(mot.debut, mot.longueur, langue));
+    }
+    return (int) nombre_terminer(&a, NULL);
 }
 
 /**
@@ -91,33 +292,9 @@ void toLowercase(char *str) {
  * @return Chiffre désignant le chiffre écrit en lettres.
  */
 
-
 int str_to_num_fr(char *nombre) {
-    if (strcmp(nombre, "un") == 0) return 1;
-    if (strcmp(nombre, "deux") == 0) return 2;
-    if (strcmp(nombre, "trois") == 0) return 3;
-    if (strcmp(nombre, "quatre") == 0) return 4;
-    if (strcmp(nombre, "cinq") == 0) return 5;
-    if (strcmp(nombre, "six") == 0) return 6;
-    if (strcmp(nombre, "sept") == 0) return 7;
-    if (strcmp(nombre, "huit") == 0) return 8;
-    if (strcmp(nombre, "neuf") == 0) return 9;
-    if (strcmp(nombre, "dix") == 0) return 10;
-    if (strcmp(nombre, "onze") == 0) return 11;
-    if (strcmp(nombre, "douze") == 0) return 12;
-    if (strcmp(nombre, "treize") == 0) return 13;
-    if (strcmp(nombre, "quatorze") == 0) return 14;
-    if (strcmp(nombre, "quinze") == 0) return 15;
-    if (strcmp(nombre, "seize") == 0) return 16;
-    if (strcmp(nombre, "vingt") == 0) return 20;
-    if (strcmp(nombre, "trente") == 0) return 30;
-    if (strcmp(nombre, "quarante") == 0) return 40;
-    if (strcmp(nombre, "cinquante") == 0) return 50;
-    if (strcmp(nombre, "soixante") == 0) return 60;
-    if (strcmp(nombre, "cent") == 0 || strcmp(nombre, "cents") == 0) return 100;
-    if (strcmp(nombre, "mille") == 0 || strcmp(nombre, "milles") == 0) return 1000;
-    else
-        return 0;
+    const EntreeLexique *e = lexique_chercher(nombre, strlen(nombre), LANGUE_FR);
+    return lexique_est(e, CAT_NOMBRE) ? (int) e->valeur : 0;
 }
 
 /**
@@ -126,59 +303,9 @@ int str_to_num_fr(char *nombre) {
  * @return Chiffre désignant le chiffre écrit en lettres.
  */
 
-
 int str_to_num_es(char *nombre) {
-    if (strcmp(nombre, "uno") == 0 || strcmp(nombre, "un") == 0) return 1;
-    if (strcmp(nombre, "dos") == 0) return 2;
-    if (strcmp(nombre, "tres") == 0) return 3;
-    if (strcmp(nombre, "cuatro") == 0) return 4;
-    if (strcmp(nombre, "cinco") == 0) return 5;
-    if (strcmp(nombre, "seis") == 0) return 6;
-    if (strcmp(nombre, "siete") == 0) return 7;
-    if (strcmp(nombre, "ocho") == 0) return 8;
-    if (strcmp(nombre, "nueve") == 0) return 9;
-    if (strcmp(nombre, "diez") == 0) return 10;
-    if (strcmp(nombre, "once") == 0) return 11;
-    if (strcmp(nombre, "doce") == 0) return 12;
-    if (strcmp(nombre, "trece") == 0) return 13;
-    if (strcmp(nombre, "catorce") == 0) return 14;
-    if (strcmp(nombre, "quince") == 0) return 15;
-    if (strcmp(nombre, "dieciseis") == 0) return 16;
-    if (strcmp(nombre, "diecisiete") == 0) return 17;
-    if (strcmp(nombre, "dieciocho") == 0) return 18;
-    if (strcmp(nombre, "diecinueve") == 0) return 19;
-    if (strcmp(nombre, "veinte") == 0) return 20;
-    if (strcmp(nombre, "veintiun") == 0) return 21;
-    if (strcmp(nombre, "veintidos") == 0) return 22;
-    if (strcmp(nombre, "veintitres") == 0) return 23;
-    if (strcmp(nombre, "veinticuatro") == 0) return 24;
-    if (strcmp(nombre, "veinticinco") == 0) return 25;
-    if (strcmp(nombre, "veintiseis") == 0) return 26;
-    if (strcmp(nombre, "veintisiete") == 0) return 27;
-    if (strcmp(nombre, "veintiocho") == 0) return 28;
-    if (strcmp(nombre, "veintintinueve") == 0) return 29;
-
-    if (strcmp(nombre, "treinta") == 0) return 30;
-    if (strcmp(nombre, "cuarenta") == 0) return 40;
-    if (strcmp(nombre, "cincuenta") == 0) return 50;
-    if (strcmp(nombre, "sesenta") == 0) return 60;
-    if (strcmp(nombre, "setenta") == 70) return 70;
-    if (strcmp(nombre, "ochenta") == 0) return 80;
-    if (strcmp(nombre, "ochenta") == 0) return 90;
-
-    if (strcmp(nombre, "cien") == 0 || strcmp(nombre,"ciento") == 0) return 100;
-    if (strcmp(nombre, "doscientos") == 0) return 200;
-    if (strcmp(nombre, "trescientos") == 0) return 300;
-    if (strcmp(nombre, "cuatrocientos") == 0) return 400;
-    if (strcmp(nombre, "quinientos") == 0) return 500;
-    if (strcmp(nombre, "seiscientos") == 0) return 600;
-    if (strcmp(nombre, "setecientos") == 0) return 700;
-    if (strcmp(nombre, "ochocientos") == 0) return 800;
-    if (strcmp(nombre, "novecientos") == 0) return 900;
-
-    if (strcmp(nombre, "mil") == 0) return 1000;
-    else
-        return 0;
+    const EntreeLexique *e = lexique_chercher(nombre, strlen(nombre), LANGUE_ES);
+    return lexique_est(e, CAT_NOMBRE) ? (int) e->valeur : 0;
 }
 
 /**
@@ -187,26 +314,8 @@ int str_to_num_es(char *nombre) {
  * @return Le chiffre désignant le résultat total des chiffres nommées puis traités
  */
 
-
 int num_to_chiffre_tot_fr(char *str) {
-    char *mot;
-    char ponctuation[] = " ',.-";
-    int total = 0, temp = 0;
-
-    mot = strtok(str, ponctuation);    //Sépare les mots de la phrase (str) pour chaque ponctuation qu'on a déjà defini.
-    while (mot != NULL) {
-        int num = str_to_num_fr(mot);    //Traitement des chiffres (somme ou multiplication, dépendant de leurs utilisation dans une phrase.
-        if (num == 1000 || num == 100 || num == 20) {
-            temp = (temp == 0 ? 1 : temp) * num;
-            total += temp;
-            temp = 0;
-        } else {
-            temp += num;
-        }
-        mot = strtok(NULL, ponctuation);    //Appel au mot defini.
-    }
-    total += temp;    //On rajoute les valeurs réstants.
-    return total;
+    return nombreEnLettres(str, LANGUE_FR);
 }
 
 /**
@@ -216,24 +325,7 @@ int num_to_chiffre_tot_fr(char *str) {
  */
 
 int num_to_chiffre_tot_es(char *str) {
-    char *mot;
-    char ponctuation[] = " ',.-";
-    int total = 0, temp = 0;
-
-    mot = strtok(str, ponctuation);
-    while (mot != NULL) {
-        int num = str_to_num_es(mot);
-        if (num == 1000 || num == 100) {
-            temp = (temp == 0 ? 1 : temp) * num;
-            total += temp;
-            temp = 0;
-        } else {
-            temp += num;
-        }
-        mot = strtok(NULL, ponctuation);
-    }
-    total += temp;
-    return total;
+    return nombreEnLettres(str, LANGUE_ES);
 }
 
 /**
@@ -243,19 +335,7 @@ int num_to_chiffre_tot_es(char *str) {
  */
 
 bool detect_chiffre_fr(const char *word) {
-    const char *nombre_mot[] = {
-            "un", "deux", "trois", "quatre", "cinq", "six", "sept", "huit", "neuf",
-            "dix", "onze", "douze", "treize", "quatorze", "quinze", "seize",
-            "vingt", "trente", "quarante", "cinquante", "soixante", "quatre vingts",
-            "cent","cents", "mille","milles", NULL
-    };
-
-    for (int i = 0; nombre_mot[i] != NULL; i++) {
-        if (strcmp(word, nombre_mot[i]) == 0) {
-            return true;
-        }
-    }
-    return false;
+    return lexique_est(lexique_chercher(word, strlen(word), LANGUE_FR), CAT_NOMBRE);
 }
 
 /**
@@ -265,655 +345,494 @@ bool detect_chiffre_fr(const char *word) {
  */
 
 bool detect_chiffre_es(const char *word) {
-    const char *nombre_mot[] = {
-            "uno","un", "dos", "tres", "cuatro", "cinco", "seis", "siete", "ocho", "nueve",
-            "diez", "once", "doce", "trece", "catorce", "quince", "dieciseis","diecisiete","dieciocho","diecinueve",
-            "veinte","veintiun","veintidos","veintitres","veinticuatro","veinticinco","veintiseis","veintisiete","veintiocho","veintinueve",
-            "treinta", "cuarenta", "cincuenta", "sesenta", "setenta","ochenta", "noventa",
-            "cien", "doscientos", "trescientos", "cuatrocientos", "quinientos", "seiscientos", "setecientos", "ochocientos", "novecientos",
-            "mil", NULL
-    };
-
-    for (int i = 0; nombre_mot[i] != NULL; i++) {
-        if (strcmp(word, nombre_mot[i]) == 0) {
-            return true;
-        }
-    }
-    return false;
+    return lexique_est(lexique_chercher(word, strlen(word), LANGUE_ES), CAT_NOMBRE);
 }
 
 /**
- * @}
+ * @brief Mot d'une phrase après découpage. Une suite de mots-nombres ne forme qu'un seul jeton.
+ * Le jeton ne garde aucun pointeur vers la phrase.
  */
+typedef struct {
+    const EntreeLexique *entree;    /**< Entrée du lexique, NULL si le mot n'est pas un mot-clé. */
+    double nombre;                  /**< Valeur numérique du jeton (0 si ce n'est pas un nombre). */
+} Jeton;
+
 /**
- * @defgroup Fonctions_prin Fonctions partie texte principales
- * @brief Fonctions qui traitent la phrase
- * @{
+ * @brief Règle de grammaire d'un verbe : paramètres que ses sous-phrases acceptent et rôle des connecteurs.
  */
+typedef struct {
+    unsigned char pluriel;        /**< Les objets sont attendus au pluriel ("compte les boules"). */
+    unsigned char emplacement;    /**< Emplacement de l'objet : 1 pour objet, 2 pour objet2. */
+    unsigned char emplacement_ouvert;    /**< Emplacement de l'objet une fois le connecteur ouvert. */
+    unsigned char ouverture;      /**< Catégorie du connecteur ouvrant ("entre", "ou"), CAT_AUCUNE sinon. */
+    unsigned char fermeture;      /**< Catégorie du connecteur fermant ("et"), CAT_AUCUNE sinon. */
+    unsigned char mesures;        /**< Accepte une distance ou un angle. */
+    unsigned char direction;      /**< Accepte une direction. */
+} RegleVerbe;
+
+static const RegleVerbe regles[] = {
+    //PHRASE DU TYPE "AVANCER DE [DISTANCE]", "AVANCER JUSQU'À L'[OBJET]"
+    //PHRASE DU TYPE "TOURNER À [DIRECTION] DE [VAL] DEGRÉS", "TOURNER À [DIRECTION] JUSQU'À LOCALISER L'[OBJET]"
+    [VERBE_AUCUN]      = {0, 1, 1, CAT_AUCUNE, CAT_AUCUNE, 1, 1},
+    [VERBE_AVANCER]    = {0, 1, 1, CAT_AUCUNE, CAT_AUCUNE, 1, 1},
+    [VERBE_RECULER]    = {0, 1, 1, CAT_AUCUNE, CAT_AUCUNE, 1, 1},
+    [VERBE_TOURNER]    = {0, 1, 1, CAT_AUCUNE, CAT_AUCUNE, 1, 1},
+    //PHRASE DU TYPE "LOCALISE/TROUVE L'[OBJET]", "LOCALISE/TROUVE L'[OBJET] OU L'[OBJET]"
+    [VERBE_LOCALISER]  = {0, 1, 2, CAT_OU, CAT_AUCUNE, 0, 0},
+    //PHRASE DU TYPE "CONTOURNER PAR LA [DIRECTION] L'[OBJET]", "CONTOURNER L'[OBJET] PAR LA [DIRECTION]"
+    [VERBE_CONTOURNER] = {0, 1, 1, CAT_AUCUNE, CAT_AUCUNE, 0, 1},
+    //PHRASE DU TYPE "PASSER ENTRE [OBJET] ET [OBJET]"
+    [VERBE_PASSER]     = {0, 2, 1, CAT_ENTRE, CAT_ET, 0, 0},
+    //PHRASE DU TYPE "COMPTER LE NOMBRE D'[OBJETS]"
+    [VERBE_COMPTER]    = {1, 1, 1, CAT_AUCUNE, CAT_AUCUNE, 0, 0},
+};
+
+const Grammaire GRAMMAIRE_FR = {LANGUE_FR, "fr", "Négative", "Affirmative", "mètres", "degrés"};
+const Grammaire GRAMMAIRE_ES = {LANGUE_ES, "es", "Negativa", "Afirmativa", "metros", "grados"};
+const Grammaire GRAMMAIRE_AUTO = {LANGUE_TOUTES, "auto", NULL, NULL, NULL, NULL};
+
+//Langues candidates de GRAMMAIRE_AUTO. En cas d'égalité des scores, la première l'emporte.
+static const Grammaire *const grammaires[] = {&GRAMMAIRE_FR, &GRAMMAIRE_ES};
+
+#define NB_GRAMMAIRES (sizeof(grammaires) / sizeof(grammaires[0]))
+
 /**
- * @brief Une des fonctions principales du code,"afficher_Action_fr" traitera une phrase en français
- * Elle s'aidera de celles défà définies pour traiter une phrase et la tokeniser, pour la pouvoir
- * ainsi diviser en plusieurs sous-phrases et les traiter individuellement.
- * @param phrase Chaine de caractères désignant la requette texte.
- * @param q File qu'on utilisera pour enregistrer les paramettres qu'on utilisera dans le code qui
- * gére les commandes envoyés au robot
- * @return Paramettres décrivant l'action, la diréction, les unités d'action (mètres ou degrés),
- * les obstacles à prendre en compte et si la phrase est une négation ou une affirmation
+ * @brief Grammaire d'une langue (LANGUE_FR, LANGUE_ES), GRAMMAIRE_FR si la langue est inconnue.
  */
+const Grammaire *grammaire_langue(int langue) {
+    for (size_t i = 0; i < NB_GRAMMAIRES; i++) {
+        if (grammaires[i]->langue == langue) {
+            return grammaires[i];
+        }
+    }
+    return &GRAMMAIRE_FR;
+}
 
+/**
+ * @brief Ecrit un objet et sa couleur dans la langue donnée ("boule bleu", "pelotas").
+ */
+static void ecrireObjet(char *dest, size_t taille, int objet, int couleur, int langue, bool pluriel) {
+    const char *nom_objet = lexique_nom(CAT_OBJET, objet, langue, pluriel);
+    const char *nom_couleur = lexique_nom(CAT_COULEUR, couleur, langue, pluriel);
+
+    if (nom_objet == NULL) {
+        dest[0] = '\0';
+    } else if (nom_couleur == NULL) {
+        snprintf(dest, taille, "%s", nom_objet);
+    } else {
+        snprintf(dest, taille, "%s %s", nom_objet, nom_couleur);
+    }
+}
 
-void afficher_Action_fr(char *phrase, Queue* q){
-    char subphrases[5][1000];
-    char *mots[100];
-    int compt = 0;
-    char Avant_chiffre[100] = "", Chiffre_mots[100] = "", Apres_chiffre[100] = "";
-    int chiffre;
-    char ponctuation_chiffre[] = " ";
-    char *mot;
-    char ponctuation[] = " ',.!?";
-    bool nombre_trouve = false;
-    char *action;
-    char ponctuation_sub[] = " ',.!?";
-    char *mot_sub;
-    int i, j;
-    double result;
-    int entre_flag = 0;
-    int ou_flag=0;
-    char *mots_sub[100];
-    int compt_sub = 0;
-    int subphr_compt = 0;
-    ActionData resultData;
-
-    for (i = 0; i < 5; i++) {    //Initialise toutes les sous-phrases à vide.
-        subphrases[i][0] = '\0';
-    }
-
-    toLowercase(phrase);
-
-    char *saveptr1;
-    mot = strtok_r(phrase, ponctuation, &saveptr1);
-    while (mot != NULL && compt < 100) {
-        mots[compt++] = mot;
-        mot = strtok_r(NULL, ponctuation, &saveptr1);
-    }
-
-    // Division en plusieurs sous-phrases
-    for (int i = 0; i < compt; i++) {
-        if (strcmp(mots[i], "puis") == 0 && subphr_compt < 4) {  //Éviter débordement de chaine de caractéres
-            subphr_compt++;
+/**
+ * @brief Forme texte d'une action dans sa langue : le verbe, puis la direction ou le premier objet (param1), la
+ * mesure ou l'objet (param2) et le type de la sous-phrase.
+ * @param a Action à afficher.
+ * @param t Reçoit les textes.
+ */
+void action_versTexte(const ActionData *a, ActionTexte *t) {
+    const Grammaire *g = grammaire_langue(a->langue);
+    const RegleVerbe *r = &regles[a->opcode];
+    const char *verbe = lexique_nom(CAT_VERBE, a->opcode, a->langue, false);
+    const char *direction = lexique_nom(CAT_DIRECTION, a->direction, a->langue, false);
+
+    snprintf(t->action, sizeof(t->action), "%s", verbe != NULL ? verbe : "");
+    t->param1[0] = t->param2[0] = '\0';
+    if (r->ouverture != CAT_AUCUNE) {    //Verbes à deux objets.
+        ecrireObjet(t->param1, sizeof(t->param1), a->objet, a->couleur, a->langue, r->pluriel);
+        ecrireObjet(t->param2, sizeof(t->param2), a->objet2, a->couleur2, a->langue, r->pluriel);
+    } else {
+        snprintf(t->param1, sizeof(t->param1), "%s", direction != NULL ? direction : "");
+        if (a->mesure == MESURE_DISTANCE) {
+            snprintf(t->param2, sizeof(t->param2), "%.3f %s", a->valeur, g->unite_distance);
+        } else if (a->mesure == MESURE_ANGLE) {
+            snprintf(t->param2, sizeof(t->param2), "%.0f %s", a->valeur, g->unite_angle);
         } else {
-            strcat(subphrases[subphr_compt], mots[i]);
-            strcat(subphrases[subphr_compt], " ");
+            ecrireObjet(t->param2, sizeof(t->param2), a->objet, a->couleur, a->langue, r->pluriel);
         }
     }
+    snprintf(t->type, sizeof(t->type), "%s", a->negation ? g->type_negative : g->type_affirmative);
+}
 
-    for (i = 0; i <= subphr_compt; i++) {
-        //printf("\nSubphrase %d: %s\n", i + 1, subphrases[i]);
-
-        //On réinitialise les variables suivantes à chaque itération pour ne pas avoir des problèmes en mémoire.
-        nombre_trouve = false;
-        strcpy(Avant_chiffre, "");
-        strcpy(Chiffre_mots, "");
-        strcpy(Apres_chiffre, "");
-
-        mot = strtok(subphrases[i], ponctuation_chiffre);    //On diférentie les parties de la sous-phrase qui definissent les chiffres ou pas.
-        while (mot != NULL) {
-            if (detect_chiffre_fr(mot)) {    //Si on détecte un mot corréspondant à un chiffre on les garde comme "Chiffre_mots".
-                nombre_trouve = true;
-                strcat(Chiffre_mots, mot);
-                strcat(Chiffre_mots, " ");
-            } else {
-                if (!nombre_trouve) {    //Si les mots se trouvent avant la détection des mots corréspondant aux chiffres on les garde comme "Avant_chiffre".
-                    strcat(Avant_chiffre, mot);
-                    strcat(Avant_chiffre, " ");
-                } else {    //Si les mots se trouvent après la détection des mots corréspondant aux chiffres on les garde comme "Apres_chiffre".
-                    strcat(Apres_chiffre, mot);
-                    strcat(Apres_chiffre, " ");
-                }
-            }
-            mot = strtok(NULL, ponctuation_chiffre);
-        }
+/**
+ * @brief Etat du moteur d'analyse pendant le parcours d'une phrase.
+ */
+typedef struct {
+    const Grammaire *g;
+    int scores[NB_GRAMMAIRES];    /**< Avec GRAMMAIRE_AUTO, nombre de mots propres à chaque langue. */
+    Queue *q;
+    AutomateNombre nombre;
+    int verbe;                    /**< Dernier verbe rencontré, conservé d'une sous-phrase à l'autre. */
+    //Sous-phrase en cours
+    ActionData action;
+    int nb_jetons;
+    bool verbe_trouve;            /**< Un verbe a été rencontré dans la sous-phrase. */
+    bool ouvert;                  /**< Le connecteur ouvrant du verbe a été rencontré. */
+    Jeton precedent;
+    Jeton avant_precedent;
+    unsigned char *couleur_objet; /**< Couleur du dernier objet, en attente d'une couleur, NULL si aucun. */
+    bool pluriel_objet;           /**< Nombre du dernier objet, auquel la couleur doit s'accorder. */
+} Analyse;
+
+static void analyse_nouvelleSousPhrase(Analyse *a) {
+    static const Jeton vide = {NULL, 0};
+    static const ActionData action_vide = {0};
+    a->action = action_vide;
+    a->nb_jetons = 0;
+    a->verbe_trouve = false;
+    a->ouvert = false;
+    a->precedent = a->avant_precedent = vide;
+    a->couleur_objet = NULL;
+}
+
+static void analyse_initialiser(Analyse *a, const Grammaire *g, Queue *q) {
+    a->g = g;
+    memset(a->scores, 0, sizeof(a->scores));
+    a->q = q;
+    a->verbe = VERBE_AUCUN;
+    nombre_initialiser(&a->nombre);
+    analyse_nouvelleSousPhrase(a);
+}
 
-        //On transforme "Chiffre_mots" en chiffre puis on réconstruit la sous-phrase initiale en charactéres et chiffres
-        chiffre = num_to_chiffre_tot_fr(Chiffre_mots);
-        sprintf(subphrases[i], "%s%d %s", Avant_chiffre, chiffre, Apres_chiffre);
-        //printf("Subphrase traité: %s\n", subphrases[i]);
+/**
+ * @brief Grammaire dont les libellés sont utilisés : celle demandée, ou avec GRAMMAIRE_AUTO celle de la langue
+ * qui a le plus de mots propres parmi les mots déjà lus.
+ */
+static const Grammaire *analyse_grammaire(const Analyse *a) {
+    if (a->g->langue != LANGUE_TOUTES) {
+        return a->g;
+    }
+    size_t meilleure = 0;
+    for (size_t i = 1; i < NB_GRAMMAIRES; i++) {
+        if (a->scores[i] > a->scores[meilleure]) {
+            meilleure = i;
+        }
     }
+    return grammaires[meilleure];
+}
 
-    //printf("Nb ss-phrases : %d\n",subphr_compt+1);
+/**
+ * @brief Valeur de la mesure qui précède une unité : le jeton précédent, ou celui d'avant s'il s'agit
+ * d'une liaison ("vingt et un mètres").
+ */
+static double analyse_mesure(const Analyse *a) {
+    if (a->nb_jetons > 1 && lexique_est(a->precedent.entree, CAT_ET)) {
+        return a->avant_precedent.nombre;
+    }
+    return a->precedent.nombre;
+}
 
-    for (i = 0; i <= subphr_compt; i++) {
+/**
+ * @brief Applique au jeton la règle du verbe en cours.
+ */
+static void analyse_jeton(Analyse *a, Jeton j) {
+    const EntreeLexique *e = j.entree;
+    ActionData *action = &a->action;
+    const RegleVerbe *r;
 
-        //On réinitialise les variables suivantes à chaque itération pour ne pas avoir des problèmes en mémoire.
-        compt_sub = 0;
-        entre_flag = 0;
+    if (a->nb_jetons == 0) {    //Si le premier mot de la sous-phrase est une négation, la sous-phrase est négative.
+        action->negation = lexique_est(e, CAT_NEGATION);
+    }
 
-        char param1[20] = "";
-        char param2[20] = "";
-        char type[20] = "";
+    //Couleur de l'objet qui précède, accordée en nombre avec lui.
+    if (a->couleur_objet != NULL && lexique_est(e, CAT_COULEUR) && e->pluriel == a->pluriel_objet) {
+        *a->couleur_objet = e->code;
+    }
+    a->couleur_objet = NULL;
 
-        mot_sub = strtok(subphrases[i], ponctuation_sub);
-        while (mot_sub != NULL && compt_sub < 20) {
-            mots_sub[compt_sub++] = mot_sub;
-            mot_sub = strtok(NULL, ponctuation_sub);
+    if (lexique_est(e, CAT_VERBE)) {
+        a->verbe = e->code;
+        a->verbe_trouve = true;
+    }
+    r = &regles[a->verbe];
+
+    if (r->ouverture != CAT_AUCUNE && !a->ouvert && lexique_est(e, r->ouverture)) {
+        a->ouvert = true;
+    } else if (r->fermeture != CAT_AUCUNE && a->ouvert && lexique_est(e, r->fermeture)) {
+        a->ouvert = false;
+    } else if (lexique_est(e, CAT_OBJET) && e->pluriel == r->pluriel) {
+        if ((a->ouvert ? r->emplacement_ouvert : r->emplacement) == 1) {
+            action->objet = e->code;
+            action->couleur = COULEUR_AUCUNE;
+            a->couleur_objet = &action->couleur;
+        } else {
+            action->objet2 = e->code;
+            action->couleur2 = COULEUR_AUCUNE;
+            a->couleur_objet = &action->couleur2;
         }
+        a->pluriel_objet = e->pluriel;
+    } else if (r->direction && lexique_est(e, CAT_DIRECTION)) {
+        action->direction = e->code;
+    } else if (r->mesures && a->nb_jetons > 0 && lexique_est(e, CAT_UNITE_DISTANCE)) {
+        action->mesure = MESURE_DISTANCE;
+        action->valeur = analyse_mesure(a) * e->valeur;
+    } else if (r->mesures && a->nb_jetons > 0 && lexique_est(e, CAT_UNITE_ANGLE)) {
+        action->mesure = MESURE_ANGLE;
+        action->valeur = analyse_mesure(a) * e->valeur;
+    }
 
-        //for (j = 0; j < compt_sub; j++) {
-        //    printf("mot[%d]=%s\n", j, mots_sub[j]);
-        //}
-
-        for (j = 0; j < compt_sub; j++) {
-            //Si le mot de la sous-phrase corréspond a un de ceux-là alors le parametre type sur ActionData sera "Négative"
-            if(strcmp(mots_sub[0], "ne") == 0 || strcmp(mots_sub[0], "n") == 0)
-                sprintf(type, "Négative");
-            else
-                sprintf(type, "Affirmative");
-
-            //Si le mot de la sous-phrase corréspond a un de ceux-là alors le parametre action sur ActionData prendra cette valeur
-            if (strcmp(mots_sub[j], "avancer") == 0 || strcmp(mots_sub[j], "avance") == 0 ||
-                strcmp(mots_sub[j], "reculer") == 0 || strcmp(mots_sub[j], "recule") == 0 ||
-                strcmp(mots_sub[j], "tourner") == 0 || strcmp(mots_sub[j], "tourne") == 0 ||
-                strcmp(mots_sub[j], "localiser") == 0 || strcmp(mots_sub[j], "localise") == 0 ||
-                strcmp(mots_sub[j], "trouver") == 0 || strcmp(mots_sub[j], "trouve") == 0 ||
-                strcmp(mots_sub[j], "contourner") == 0 || strcmp(mots_sub[j], "contourne") == 0 ||
-                strcmp(mots_sub[j], "passer") == 0 || strcmp(mots_sub[j], "passe") == 0 ||
-                strcmp(mots_sub[j], "compter") == 0 || strcmp(mots_sub[j], "compte") == 0) {
-                action = mots_sub[j];
-            }
-
-
-            //PHRASE DU TYPE "CONTOURNER PAR LA [DIRECTION] L'[OBJET]"
-            //PHRASE DU TYPE "CONTOURNER L'[OBJET] PAR LA [DIRECTION]"
-            if(strcmp(action, "contourner") == 0 || strcmp(action, "contourne") == 0) {
-
-                if(strcmp(mots_sub[j], "droite") == 0 || strcmp(mots_sub[j], "gauche") == 0)
-                    sprintf(param1, "%s", mots_sub[j]);
+    a->avant_precedent = a->precedent;
+    a->precedent = j;
+    a->nb_jetons++;
+}
 
-                if (strcmp(mots_sub[j], "cube") == 0 || strcmp(mots_sub[j], "carré") == 0 ||
-                    strcmp(mots_sub[j], "balle") == 0 || strcmp(mots_sub[j], "boule") == 0 ||
-                    strcmp(mots_sub[j], "objet") == 0 || strcmp(mots_sub[j], "obstacle") == 0) {
-                    if (j + 1 < compt_sub && (strcmp(mots_sub[j + 1], "rouge") == 0 || strcmp(mots_sub[j + 1], "bleu") == 0 || strcmp(mots_sub[j + 1], "bleue") == 0 ||
-                                              strcmp(mots_sub[j + 1], "jaune") == 0 || strcmp(mots_sub[j + 1], "orange") == 0)) {
-                        sprintf(param2, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                    } else {
-                        sprintf(param2, "%s", mots_sub[j]);
-                    }
-                }
-            }
+/**
+ * @brief Transmet le nombre en cours de reconnaissance, s'il y en a un, suivi de l'éventuelle liaison
+ * restée en attente.
+ */
+static void analyse_viderNombre(Analyse *a) {
+    const EntreeLexique *liaison;
+    if (!a->nombre.actif) {
+        return;
+    }
+    long valeur = nombre_terminer(&a->nombre, &liaison);
+    analyse_jeton(a, (Jeton) {NULL, (double) valeur});
+    if (liaison != NULL) {
+        analyse_jeton(a, (Jeton) {liaison, 0});
+    }
+}
 
+/**
+ * @brief Termine la sous-phrase en cours et enfile l'action correspondante.
+ */
+static void analyse_finSousPhrase(Analyse *a) {
+    analyse_viderNombre(a);
+    a->action.opcode = a->verbe;
+    a->action.langue = analyse_grammaire(a)->langue;
+    enqueue(a->q, a->action);
 
-                //PHRASE DU TYPE "PASSER ENTRE [OBJET] ET [OBJET]"
-            else if (strcmp(action, "passer") == 0 || strcmp(action, "passe") == 0) {
-
-                if(strcmp(mots_sub[j], "entre") == 0) {
-                    entre_flag = 1;                                         // Mot "entre" trouvé, donc flag_entre (qui indique ça) est mit a 1
-                    continue;
-                }
-
-                // Procesar objetos y colores después de "entre"
-                if (entre_flag == 1 && strcmp(mots_sub[j], "et") == 0){
-                    entre_flag = 0;                                         // On remet lentre_flag à 0
-                    continue;
-                }
-
-                if (entre_flag == 1) {
-                    if (strcmp(mots_sub[j], "cube") == 0 || strcmp(mots_sub[j], "carré") == 0 ||
-                        strcmp(mots_sub[j], "balle") == 0 || strcmp(mots_sub[j], "boule") == 0 ||
-                        strcmp(mots_sub[j], "objet") == 0 || strcmp(mots_sub[j], "obstacle") == 0) {
-                        if (j + 1 < compt_sub && (strcmp(mots_sub[j + 1], "rouge") == 0 || strcmp(mots_sub[j + 1], "bleu") == 0 || strcmp(mots_sub[j + 1], "bleue") == 0 ||
-                                                  strcmp(mots_sub[j + 1], "jaune") == 0 || strcmp(mots_sub[j + 1], "orange") == 0)) {
-                            sprintf(param1, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                        } else {
-                            sprintf(param1, "%s", mots_sub[j]);
-                        }
-                    }
-                } else {
-                    if (strcmp(mots_sub[j], "cube") == 0 || strcmp(mots_sub[j], "carré") == 0 ||
-                        strcmp(mots_sub[j], "balle") == 0 || strcmp(mots_sub[j], "boule") == 0 ||
-                        strcmp(mots_sub[j], "objet") == 0 || strcmp(mots_sub[j], "obstacle") == 0) {
-                        if (j + 1 < compt_sub && (strcmp(mots_sub[j + 1], "rouge") == 0 || strcmp(mots_sub[j + 1], "bleu") == 0 || strcmp(mots_sub[j + 1], "bleue") == 0 ||
-                                                  strcmp(mots_sub[j + 1], "jaune") == 0 || strcmp(mots_sub[j + 1], "orange") == 0)) {
-                            sprintf(param2, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                        } else {
-                            sprintf(param2, "%s", mots_sub[j]);
-                        }
-                    }
-                }
-            }
+    analyse_nouvelleSousPhrase(a);
+}
 
-                //PHRASE DU TYPE "LOCALISE/TROUVE L'[OBJET]"
-                //PHRASE DU TYPE "LOCALISE/TROUVE L'[OBJET] OU L'[OBJET]"
-            else if(strcmp(action, "localiser") == 0 || strcmp(action, "localise") == 0 ||
-                    strcmp(action, "trouver") == 0 || strcmp(action, "trouve") == 0) {
-
-                if (ou_flag == 0 && strcmp(mots_sub[j], "ou") == 0){
-                    ou_flag = 1;                                         // On remet le flag de "ou" a 1
-                    continue;
-                }
-
-                if (ou_flag == 0) {
-                    if (strcmp(mots_sub[j], "cube") == 0 || strcmp(mots_sub[j], "carré") == 0 ||
-                        strcmp(mots_sub[j], "balle") == 0 || strcmp(mots_sub[j], "boule") == 0 ||
-                        strcmp(mots_sub[j], "objet") == 0 || strcmp(mots_sub[j], "obstacle") == 0) {
-                        if (j + 1 < compt_sub && (strcmp(mots_sub[j + 1], "rouge") == 0 || strcmp(mots_sub[j + 1], "bleu") == 0 || strcmp(mots_sub[j + 1], "bleue") == 0 ||
-                                                  strcmp(mots_sub[j + 1], "jaune") == 0 || strcmp(mots_sub[j + 1], "orange") == 0)) {
-                            sprintf(param1, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                        } else {
-                            sprintf(param1, "%s", mots_sub[j]);
-                        }
-                    }
-                } else {
-                    if (strcmp(mots_sub[j], "cube") == 0 || strcmp(mots_sub[j], "carré") == 0 ||
-                        strcmp(mots_sub[j], "balle") == 0 || strcmp(mots_sub[j], "boule") == 0 ||
-                        strcmp(mots_sub[j], "objet") == 0 || strcmp(mots_sub[j], "obstacle") == 0) {
-                        if (j + 1 < compt_sub && (strcmp(mots_sub[j + 1], "rouge") == 0 || strcmp(mots_sub[j + 1], "bleu") == 0 || strcmp(mots_sub[j + 1], "bleue") == 0 ||
-                                                  strcmp(mots_sub[j + 1], "jaune") == 0 || strcmp(mots_sub[j + 1], "orange") == 0)) {
-                            sprintf(param2, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                        } else {
-                            sprintf(param2, "%s", mots_sub[j]);
-                        }
-                    }
-                }
-            }
+/**
+ * @brief Indique si un mot corrigé en e (lexique_chercherApproche) peut être gardé : il doit remplir une place encore
+ * vide de la sous-phrase. Un mot inconnu après le verbe ("avanza de 2 metros para llegar") n'est donc pas corrigé
+ * en un second verbe, ni un mot qui suit l'objet en un autre objet.
+ */
+static bool analyse_correctionPermise(const Analyse *a, const EntreeLexique *e) {
+    const RegleVerbe *r = &regles[a->verbe];
 
-            else if(strcmp(action, "compter") == 0 || strcmp(action, "compte") == 0) {
-                if (strcmp(mots_sub[j], "cubes") == 0 || strcmp(mots_sub[j], "carrés") == 0 ||
-                    strcmp(mots_sub[j], "balles") == 0 || strcmp(mots_sub[j], "boules") == 0 ||
-                    strcmp(mots_sub[j], "objets") == 0 || strcmp(mots_sub[j], "obstacles") == 0) {
-                    if (j + 1 < compt_sub && (strcmp(mots_sub[j + 1], "rouges") == 0 || strcmp(mots_sub[j + 1], "bleus") == 0 || strcmp(mots_sub[j + 1], "bleues") == 0 ||
-                                              strcmp(mots_sub[j + 1], "jaunes") == 0 || strcmp(mots_sub[j + 1], "oranges") == 0)) {
-                        sprintf(param2, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                    } else {
-                        sprintf(param2, "%s", mots_sub[j]);
-                    }
-                }
-            }
+    if (lexique_est(e, CAT_VERBE)) {
+        return !a->verbe_trouve;
+    }
+    if (lexique_est(e, CAT_OBJET)) {
+        return ((a->ouvert ? r->emplacement_ouvert : r->emplacement) == 1 ? a->action.objet : a->action.objet2) == OBJET_AUCUN;
+    }
+    if (lexique_est(e, CAT_COULEUR)) {
+        return a->couleur_objet != NULL;
+    }
+    return false;
+}
 
-            else{
-
-                //PHRASE DU TYPE "AVANCER DE [DISTANCE]"
-                if (strcmp(mots_sub[j], "mètres") == 0 || strcmp(mots_sub[j], "mètre") == 0 || strcmp(mots_sub[j], "centimètres") == 0 || strcmp(mots_sub[j], "millimètres") == 0) {
-                    if(strcmp(mots_sub[j-1], "et") == 0) {
-                        result = convertDouble(mots_sub[j - 2]);
-                    }else{
-                        result = convertDouble(mots_sub[j - 1]);
-                    }
-                    if (strcmp(mots_sub[j], "centimètres") == 0) {
-                        result *= 0.01;
-                    } else if (strcmp(mots_sub[j], "millimètres") == 0) {
-                        result *= 0.001;
-                    }
-                    sprintf(param2, "%.3f mètres ", result);                     
-                }
-
-                //PHRASE DU TYPE "AVANCER JUSQU'À L'[OBJET]"
-                //PHRASE DU TYPE "TOURNER JUSQU'À LOCALISER L'[OBJET]"
-                //PHRASE DU TYPE "TOURNER À [DIRECTION] JUSQU'À LOCALISER L'[OBJET]"
-                if (strcmp(mots_sub[j], "boule") == 0 || strcmp(mots_sub[j], "balle") == 0 ||
-                    strcmp(mots_sub[j], "carré") == 0 || strcmp(mots_sub[j], "cube") == 0) {
-                    // Vérifier s'il y a un mot suivant pour la couleur.
-                    if (j + 1 < compt_sub && (strcmp(mots_sub[j + 1], "rouge") == 0 || strcmp(mots_sub[j + 1], "bleu") == 0 || strcmp(mots_sub[j + 1], "bleue") == 0 ||
-                                              strcmp(mots_sub[j + 1], "jaune") == 0 || strcmp(mots_sub[j + 1], "orange") == 0)) {
-                        sprintf(param2, "%s %s ", mots_sub[j], mots_sub[j + 1]);
-                    } else {
-                        sprintf(param2, "%s ", mots_sub[j]);
-                    }
-                }
-
-                //PHRASE DU TYPE "TOURNER DE [VAL] DEGRÉS"
-                //PHRASE DU TYPE "TOURNER À [DIRECTION] DE [VAL] DEGRÉS"
-                if(strcmp(mots_sub[j], "droite") == 0 || strcmp(mots_sub[j], "gauche") == 0)
-                    sprintf(param1, "%s", mots_sub[j]);
-
-                if(strcmp(mots_sub[j], "degrés") == 0 || strcmp(mots_sub[j], "degré") == 0) {
-                    if(strcmp(mots_sub[j-1], "et") == 0) {
-                        result = convertDouble(mots_sub[j - 2]);
-                    }else{
-                        result = convertDouble(mots_sub[j - 1]);
-                    }
-                    sprintf(param2, "%.0f %s", result, mots_sub[j]);
-                }
-            }
+/**
+ * @brief Fait avancer le moteur d'un mot de la phrase.
+ */
+static void analyse_mot(Analyse *a, Segment mot) {
+    int langues_mot = 0;
+    const EntreeLexique *e = lexique_chercherLangues(mot.debut, mot.longueur, a->g->langue,
+                                                     a->g->langue == LANGUE_TOUTES ? &langues_mot : NULL);
+
+    if (e == NULL && !isdigit((unsigned char) mot.debut[0])) {    //Mot mal écrit : le mot-clé le plus proche.
+        e = lexique_chercherApproche(mot.debut, mot.longueur, a->g->langue);
+        if (!analyse_correctionPermise(a, e)) {
+            e = NULL;
         }
+    }
 
-        //On copie le contenu de action, param1, param2 et type dans les paramétres de resultData, qui est une variable du type ActionData
-        strcpy(resultData.action, action);
-        strcpy(resultData.param1, param1);
-        strcpy(resultData.param2, param2);
-        strcpy(resultData.type, type);
-
-        //On enfile le contenu de resultData dans le file du FIFO
-        enqueue(q, resultData);
+    for (size_t i = 0; i < NB_GRAMMAIRES; i++) {    //Seuls les mots propres à une langue comptent pour l'identifier.
+        if (langues_mot == grammaires[i]->langue) {
+            a->scores[i]++;
+        }
     }
 
+    if (nombre_ajouter(&a->nombre, e)) {    //Les mots-nombres sont absorbés par l'automate.
+        return;
+    }
+    analyse_viderNombre(a);
+    if (lexique_est(e, CAT_SEPARATEUR)) {
+        analyse_finSousPhrase(a);
+    } else {
+        analyse_jeton(a, (Jeton) {e, segment_nombre(mot)});
+    }
 }
 
-
 /**
- * @brief Une des fonctions principales du code,"afficher_Action_es" traitera une phrase en espagnol
- * Elle s'aidera de celles défà définies pour traiter une phrase et la tokeniser, pour la pouvoir
- * ainsi diviser en plusieurs sous-phrases et les traiter individuellement.
- * @param phrase Chaine de caractères désignant la requette texte.
- * @param q File qu'on utilisera pour enregistrer les paramettres qu'on utilisera dans le code qui
- * gére les commandes envoyés au robot
- * @return Paramettres décrivant l'action, la diréction, les unités d'action (mètres ou degrés),
- * les obstacles à prendre en compte et si la phrase est une négation ou une affirmation
+ * @}
+ */
+/**
+ * @defgroup Fonctions_prin Fonctions partie texte principales
+ * @brief Fonctions qui traitent la phrase
+ * @{
+ */
+/**
+ * @brief Moteur d'analyse commun à toutes les langues. La phrase est parcourue une seule fois, sans
+ * allocation ni copie : elle est découpée en segments, chaque mot est classé par le lexique de la langue
+ * (sans tenir compte de la casse ni des accents, et en corrigeant les verbes, objets et couleurs mal écrits), les nombres écrits en lettres sont
+ * calculés au fil des mots, et l'action typée de chaque sous-phrase est remplie selon la règle du verbe.
+ * Une action est enfilée à chaque séparateur ("puis", "luego") et à la fin de la phrase.
+ * Avec GRAMMAIRE_AUTO, la langue est identifiée pendant ce même parcours : chaque mot-clé propre à une langue
+ * augmente son score, et les libellés de chaque action sont ceux de la langue en tête à ce moment.
+ * @param g Grammaire de la langue de la phrase (GRAMMAIRE_FR, GRAMMAIRE_ES), ou GRAMMAIRE_AUTO.
+ * @param phrase Chaine de caractères désignant la requette texte. Elle n'est pas modifiée, et sa longueur
+ * n'est pas limitée. Plusieurs phrases peuvent être analysées en même temps par des threads différents.
+ * @param q File dans laquelle sont enfilées les actions.
+ * @return Grammaire de la phrase : g, ou la langue identifiée avec GRAMMAIRE_AUTO.
  */
 
+const Grammaire *analyserPhrase(const Grammaire *g, const char *phrase, Queue *q) {
+    Segment mot;
+    Analyse a;
 
-void afficher_Action_es(char *phrase, Queue* q){
-    char subphrases[5][1000];
-    char *mots[100];
-    int compt = 0;
-    char Avant_chiffre[100] = "", Chiffre_mots[100] = "", Apres_chiffre[100] = "";
-    int chiffre;
-    char ponctuation_chiffre[] = " ";
-    char *mot;
-    char ponctuation[] = " ',.!?";
-    bool nombre_trouve = false;
-    char *action;
-    char ponctuation_sub[] = " ',.!?";
-    char *mot_sub;
-    int i, j;
-    double result;
-    int entre_flag = 0;
-    int ou_flag=0;
-    char *mots_sub[100];
-    int compt_sub = 0;
-    int subphr_compt = 0;
-    ActionData resultData;
-
-    for (i = 0; i < 5; i++) {    //Initialise toutes les sous-phrases à vide.
-        subphrases[i][0] = '\0';
-    }
-
-    toLowercase(phrase);
-
-    char *saveptr1;
-    mot = strtok_r(phrase, ponctuation, &saveptr1);
-    while (mot != NULL && compt < 100) {
-        mots[compt++] = mot;
-        mot = strtok_r(NULL, ponctuation, &saveptr1);
-    }
-
-    // Dividir en subfrases
-    for (int i = 0; i < compt; i++) {
-        if (strcmp(mots[i], "luego") == 0 && subphr_compt < 4) {    //Éviter débordement de chaine de caractéres
-            subphr_compt++;
-        } else {
-            strcat(subphrases[subphr_compt], mots[i]);
-            strcat(subphrases[subphr_compt], " ");
-        }
+    analyse_initialiser(&a, g, q);
+    while (segment_suivant(&phrase, PONCTUATION_PHRASE, &mot)) {
+        analyse_mot(&a, mot);
     }
+    analyse_finSousPhrase(&a);
+    return analyse_grammaire(&a);
+}
 
-    for (i = 0; i <= subphr_compt; i++) {
-        //printf("\nSubphrase %d: %s\n", i + 1, subphrases[i]);
-
-        //On réinitialise les variables suivantes à chaque itération pour ne pas avoir des problèmes en mémoire.
-        nombre_trouve = false;
-        strcpy(Avant_chiffre, "");
-        strcpy(Chiffre_mots, "");
-        strcpy(Apres_chiffre, "");
-
-        mot = strtok(subphrases[i], ponctuation_chiffre);    //On diférentie les parties de la sous-phrase qui definissent les chiffres ou pas.
-        while (mot != NULL) {
-            if (detect_chiffre_es(mot)) {    //Si on détecte un mot corréspondant à un chiffre on les garde comme "Chiffre_mots".
-                nombre_trouve = true;
-                strcat(Chiffre_mots, mot);
-                strcat(Chiffre_mots, " ");
-            } else {
-                if (!nombre_trouve) {    //Si les mots se trouvent avant la détection des mots corréspondant aux chiffres on les garde comme "Avant_chiffre".
-                    strcat(Avant_chiffre, mot);
-                    strcat(Avant_chiffre, " ");
-                } else {    //Si les mots se trouvent après la détection des mots corréspondant aux chiffres on les garde comme "Apres_chiffre".
-                    strcat(Apres_chiffre, mot);
-                    strcat(Apres_chiffre, " ");
-                }
-            }
-            mot = strtok(NULL, ponctuation_chiffre);
-        }
+/**
+ * @brief Analyseur incrémental : le même moteur que analyserPhrase, alimenté par morceaux de texte.
+ * Seul le mot coupé à la fin d'un morceau est copié, en attendant la suite.
+ */
+struct AnalyseurFlux {
+    Analyse a;
+    char *mot;              /**< Début du mot coupé à la fin du dernier morceau. */
+    size_t longueur_mot;
+    size_t capacite_mot;
+};
 
-        //On transforme "Chiffre_mots" en chiffre puis on réconstruit la sous-phrase initiale en charactéres et chiffres
-        chiffre = num_to_chiffre_tot_es(Chiffre_mots);
-        sprintf(subphrases[i], "%s%d %s", Avant_chiffre, chiffre, Apres_chiffre);
-        //printf("Subphrase traité: %s\n", subphrases[i]);
+/**
+ * @brief Crée un analyseur incrémental.
+ * @param g Grammaire de la langue du texte (GRAMMAIRE_FR, GRAMMAIRE_ES), ou GRAMMAIRE_AUTO.
+ * @param q File dans laquelle les actions sont enfilées dès que leur sous-phrase est terminée.
+ * @return L'analyseur, NULL si l'allocation échoue.
+ */
+AnalyseurFlux *analyseurFlux_creer(const Grammaire *g, Queue *q) {
+    AnalyseurFlux *f = malloc(sizeof(AnalyseurFlux));
+    if (f == NULL) {
+        return NULL;
     }
+    analyse_initialiser(&f->a, g, q);
+    f->mot = NULL;
+    f->longueur_mot = f->capacite_mot = 0;
+    return f;
+}
 
-    //printf("Nb ss-phrases : %d\n",subphr_compt+1);
-
-    for (i = 0; i <= subphr_compt; i++) {
-
-        //On réinitialise les variables suivantes à chaque itération pour ne pas avoir des problèmes en mémoire.
-        compt_sub = 0;
-        entre_flag = 0;
-
-        char param1[20] = "";
-        char param2[20] = "";
-        char type[20] = "";
+void analyseurFlux_detruire(AnalyseurFlux *f) {
+    if (f != NULL) {
+        free(f->mot);
+        free(f);
+    }
+}
 
-        mot_sub = strtok(subphrases[i], ponctuation_sub);
-        while (mot_sub != NULL && compt_sub < 20) {
-            mots_sub[compt_sub++] = mot_sub;
-            mot_sub = strtok(NULL, ponctuation_sub);
+/**
+ * @brief Ajoute le début d'un mot coupé par la fin du morceau.
+ */
+static void analyseurFlux_retenir(AnalyseurFlux *f, const char *debut, size_t longueur) {
+    if (f->longueur_mot + longueur > f->capacite_mot) {
+        size_t capacite = (f->capacite_mot == 0) ? 32 : f->capacite_mot;
+        while (capacite < f->longueur_mot + longueur) {
+            capacite *= 2;
         }
+        char *mot = realloc(f->mot, capacite);
+        if (mot == NULL) {    //Le mot est tronqué : il ne peut de toute façon pas être un mot-clé.
+            return;
+        }
+        f->mot = mot;
+        f->capacite_mot = capacite;
+    }
+    memcpy(f->mot + f->longueur_mot, debut, longueur);
+    f->longueur_mot += longueur;
+}
 
-        //for (j = 0; j < compt_sub; j++) {
-        //    printf("mot[%d]=%s\n", j, mots_sub[j]);
-        //}
-
-        for (j = 0; j < compt_sub; j++) {
-            //Si le mot de la sous-phrase corréspond a un de ceux-là alors le parametre type sur ActionData sera "Négative"
-            if (strcmp(mots_sub[0], "ne") == 0 || strcmp(mots_sub[0], "n") == 0)
-                sprintf(type, "Negativa");
-            else
-                sprintf(type, "Afirmativa");
-
-            //Si le mot de la sous-phrase corréspond a un de ceux-là alors le parametre action sur ActionData prendra cette valeur
-            if (strcmp(mots_sub[j], "avanzar") == 0 || strcmp(mots_sub[j], "avanza") == 0 ||
-                strcmp(mots_sub[j], "avances") == 0 ||
-                strcmp(mots_sub[j], "retroceder") == 0 || strcmp(mots_sub[j], "retrocede") == 0 ||
-                strcmp(mots_sub[j], "retrocedas") == 0 ||
-                strcmp(mots_sub[j], "girar") == 0 || strcmp(mots_sub[j], "gira") == 0 ||
-                strcmp(mots_sub[j], "gires") == 0 ||
-                strcmp(mots_sub[j], "localizar") == 0 || strcmp(mots_sub[j], "localiza") == 0 ||
-                strcmp(mots_sub[j], "localices") == 0 ||
-                strcmp(mots_sub[j], "encontrar") == 0 || strcmp(mots_sub[j], "encuentra") == 0 ||
-                strcmp(mots_sub[j], "encuentres") == 0 ||
-                strcmp(mots_sub[j], "rodear") == 0 || strcmp(mots_sub[j], "rodea") == 0 ||
-                strcmp(mots_sub[j], "rodées") == 0 ||
-                strcmp(mots_sub[j], "pasar") == 0 || strcmp(mots_sub[j], "pasa") == 0 ||
-                strcmp(mots_sub[j], "pases") == 0 ||
-                strcmp(mots_sub[j], "contar") == 0 || strcmp(mots_sub[j], "cuenta") == 0 ||
-                strcmp(mots_sub[j], "cuentes") == 0) {
-                action = mots_sub[j];
-            }
-
+/**
+ * @brief Analyse le mot retenu, s'il y en a un.
+ */
+static void analyseurFlux_viderMot(AnalyseurFlux *f) {
+    if (f->longueur_mot > 0) {
+        analyse_mot(&f->a, (Segment) {f->mot, f->longueur_mot});
+        f->longueur_mot = 0;
+    }
+}
 
-            //PHRASE DU TYPE "CONTOURNER PAR LA [DIRECTION] L'[OBJET]"
-            //PHRASE DU TYPE "CONTOURNER L'[OBJET] PAR LA [DIRECTION]"
-            if (strcmp(action, "rodear") == 0 || strcmp(action, "rodea") == 0) {
-
-                if (strcmp(mots_sub[j], "derecha") == 0 || strcmp(mots_sub[j], "izquierda") == 0)
-                    sprintf(param1, "%s", mots_sub[j]);
-
-                if (strcmp(mots_sub[j], "cubo") == 0 || strcmp(mots_sub[j], "cuadrado") == 0 ||
-                    strcmp(mots_sub[j], "bola") == 0 || strcmp(mots_sub[j], "pelota") == 0 ||
-                    strcmp(mots_sub[j], "objeto") == 0 || strcmp(mots_sub[j], "obstaculo") == 0) {
-                    if (j + 1 < compt_sub &&
-                        (strcmp(mots_sub[j + 1], "rojo") == 0 || strcmp(mots_sub[j + 1], "roja") == 0 ||
-                         strcmp(mots_sub[j + 1], "azul") == 0 ||
-                         strcmp(mots_sub[j + 1], "amarillo") == 0 || strcmp(mots_sub[j + 1], "amarilla") == 0 ||
-                         strcmp(mots_sub[j + 1], "naranja") == 0)) {
-                        sprintf(param2, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                    } else {
-                        sprintf(param2, "%s", mots_sub[j]);
-                    }
-                }
+/**
+ * @brief Fait avancer l'analyse d'un morceau de texte. Chaque sous-phrase fermée par un séparateur ("puis",
+ * "luego") est enfilée avant le retour, sans attendre la fin du texte. Un mot coupé par la fin du morceau
+ * est complété par le morceau suivant.
+ * @param f Analyseur.
+ * @param texte Morceau de texte (pas forcément terminé par '\0'), qui n'a pas à rester valide après l'appel.
+ * @param longueur Nombre d'octets du morceau.
+ */
+void analyseurFlux_ajouter(AnalyseurFlux *f, const char *texte, size_t longueur) {
+    const char *c = texte, *fin = texte + longueur;
+
+    while (c < fin) {
+        if (strchr(PONCTUATION_PHRASE, *c) != NULL) {    //'\0' est aussi un séparateur.
+            analyseurFlux_viderMot(f);
+            c++;
+            continue;
+        }
+        const char *debut = c;
+        while (c < fin && strchr(PONCTUATION_PHRASE, *c) == NULL) {
+            c++;
+        }
+        if (c < fin && f->longueur_mot == 0) {    //Mot entier dans le morceau : analysé sans copie.
+            analyse_mot(&f->a, (Segment) {debut, (size_t) (c - debut)});
+        } else {
+            analyseurFlux_retenir(f, debut, (size_t) (c - debut));
+            if (c < fin) {
+                analyseurFlux_viderMot(f);
             }
+        }
+    }
+}
 
+/**
+ * @brief Termine le texte en cours : le dernier mot et la dernière sous-phrase sont analysés, puis l'analyseur
+ * est prêt pour un nouveau texte.
+ * @return Grammaire du texte : celle de l'analyseur, ou la langue identifiée avec GRAMMAIRE_AUTO.
+ */
+const Grammaire *analyseurFlux_terminer(AnalyseurFlux *f) {
+    const Grammaire *g;
+
+    analyseurFlux_viderMot(f);
+    analyse_finSousPhrase(&f->a);
+    g = analyse_grammaire(&f->a);
+    analyse_initialiser(&f->a, f->a.g, f->a.q);
+    return g;
+}
 
-                //PHRASE DU TYPE "PASSER ENTRE [OBJET] ET [OBJET]"
-            else if (strcmp(action, "pasar") == 0 || strcmp(action, "pasa") == 0) {
-
-                if (strcmp(mots_sub[j], "entre") == 0) {
-                    entre_flag = 1;                                         // Mot "entre" trouvé, donc flag_entre (qui indique ça) est mit a 1
-                    continue;
-                }
-
-                // Procesar objetos y colores después de "entre"
-                if (entre_flag == 1 && strcmp(mots_sub[j], "y") == 0) {
-                    entre_flag = 0;                                         // On remet lentre_flag à 0
-                    continue;
-                }
-
-                if (entre_flag == 1) {
-                    if (strcmp(mots_sub[j], "cubo") == 0 || strcmp(mots_sub[j], "cuadrado") == 0 ||
-                        strcmp(mots_sub[j], "bola") == 0 || strcmp(mots_sub[j], "pelota") == 0 ||
-                        strcmp(mots_sub[j], "objeto") == 0 || strcmp(mots_sub[j], "obstaculo") == 0) {
-                        if (j + 1 < compt_sub &&
-                            (strcmp(mots_sub[j + 1], "rojo") == 0 || strcmp(mots_sub[j + 1], "roja") == 0 ||
-                             strcmp(mots_sub[j + 1], "azul") == 0 ||
-                             strcmp(mots_sub[j + 1], "amarillo") == 0 || strcmp(mots_sub[j + 1], "amarilla") == 0 ||
-                             strcmp(mots_sub[j + 1], "naranja") == 0)) {
-                            sprintf(param1, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                        } else {
-                            sprintf(param1, "%s", mots_sub[j]);
-                        }
-                    }
-                } else {
-                    if (strcmp(mots_sub[j], "cubo") == 0 || strcmp(mots_sub[j], "cuadrado") == 0 ||
-                        strcmp(mots_sub[j], "bola") == 0 || strcmp(mots_sub[j], "pelota") == 0 ||
-                        strcmp(mots_sub[j], "objeto") == 0 || strcmp(mots_sub[j], "obstaculo") == 0) {
-                        if (j + 1 < compt_sub &&
-                            (strcmp(mots_sub[j + 1], "rojo") == 0 || strcmp(mots_sub[j + 1], "roja") == 0 ||
-                             strcmp(mots_sub[j + 1], "azul") == 0 ||
-                             strcmp(mots_sub[j + 1], "amarillo") == 0 || strcmp(mots_sub[j + 1], "amarilla") == 0 ||
-                             strcmp(mots_sub[j + 1], "naranja") == 0)) {
-                            sprintf(param2, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                        } else {
-                            sprintf(param2, "%s", mots_sub[j]);
-                        }
-                    }
-                }
-            }
+/**
+ * @brief Une des fonctions principales du code,"afficher_Action_fr" traitera une phrase en français
+ * Elle s'aidera de celles défà définies pour traiter une phrase et la tokeniser, pour la pouvoir
+ * ainsi diviser en plusieurs sous-phrases et les traiter individuellement.
+ * @param phrase Chaine de caractères désignant la requette texte.
+ * @param q File qu'on utilisera pour enregistrer les paramettres qu'on utilisera dans le code qui
+ * gére les commandes envoyés au robot
+ * @return Paramettres décrivant l'action, la diréction, les unités d'action (mètres ou degrés),
+ * les obstacles à prendre en compte et si la phrase est une négation ou une affirmation
+ */
 
-                //PHRASE DU TYPE "LOCALISE/TROUVE L'[OBJET]"
-                //PHRASE DU TYPE "LOCALISE/TROUVE L'[OBJET] OU L'[OBJET]"
-            else if (strcmp(action, "localizar") == 0 || strcmp(action, "localiza") == 0 ||
-                     strcmp(action, "encontrar") == 0 || strcmp(action, "encuentra") == 0) {
-
-                if (ou_flag == 0 && strcmp(mots_sub[j], "o") == 0) {
-                    ou_flag = 1;                                         // On remet le flag de "ou" a 1
-                    continue;
-                }
-
-                if (ou_flag == 0) {
-                    if (strcmp(mots_sub[j], "cubo") == 0 || strcmp(mots_sub[j], "cuadrado") == 0 ||
-                        strcmp(mots_sub[j], "bola") == 0 || strcmp(mots_sub[j], "pelota") == 0 ||
-                        strcmp(mots_sub[j], "objeto") == 0 || strcmp(mots_sub[j], "obstaculo") == 0) {
-                        if (j + 1 < compt_sub &&
-                            (strcmp(mots_sub[j + 1], "rojo") == 0 || strcmp(mots_sub[j + 1], "roja") == 0 ||
-                             strcmp(mots_sub[j + 1], "azul") == 0 ||
-                             strcmp(mots_sub[j + 1], "amarillo") == 0 || strcmp(mots_sub[j + 1], "amarilla") == 0 ||
-                             strcmp(mots_sub[j + 1], "naranja") == 0)) {
-                            sprintf(param1, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                        } else {
-                            sprintf(param1, "%s", mots_sub[j]);
-                        }
-                    }
-                } else {
-                    if (strcmp(mots_sub[j], "cubo") == 0 || strcmp(mots_sub[j], "cuadrado") == 0 ||
-                        strcmp(mots_sub[j], "bola") == 0 || strcmp(mots_sub[j], "pelota") == 0 ||
-                        strcmp(mots_sub[j], "objeto") == 0 || strcmp(mots_sub[j], "obstaculo") == 0) {
-                        if (j + 1 < compt_sub &&
-                            (strcmp(mots_sub[j + 1], "rojo") == 0 || strcmp(mots_sub[j + 1], "roja") == 0 ||
-                             strcmp(mots_sub[j + 1], "azul") == 0 ||
-                             strcmp(mots_sub[j + 1], "amarillo") == 0 || strcmp(mots_sub[j + 1], "amarilla") == 0 ||
-                             strcmp(mots_sub[j + 1], "naranja") == 0)) {
-                            sprintf(param2, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                        } else {
-                            sprintf(param2, "%s", mots_sub[j]);
-                        }
-                    }
-                }
-            } else if (strcmp(action, "contar") == 0 || strcmp(action, "cuenta") == 0 ||
-                       strcmp(action, "cuentes") == 0) {
-                if (strcmp(mots_sub[j], "cubos") == 0 || strcmp(mots_sub[j], "cuadrados") == 0 ||
-                    strcmp(mots_sub[j], "bolas") == 0 || strcmp(mots_sub[j], "pelotas") == 0 ||
-                    strcmp(mots_sub[j], "objetos") == 0 || strcmp(mots_sub[j], "obstaculos") == 0) {
-                    if (j + 1 < compt_sub &&
-                        (strcmp(mots_sub[j + 1], "rojos") == 0 || strcmp(mots_sub[j + 1], "rojas") == 0 ||
-                         strcmp(mots_sub[j + 1], "azules") == 0 ||
-                         strcmp(mots_sub[j + 1], "amarillos") == 0 || strcmp(mots_sub[j + 1], "amarillas") == 0 ||
-                         strcmp(mots_sub[j + 1], "naranjas") == 0)) {
-                        sprintf(param2, "%s %s", mots_sub[j], mots_sub[j + 1]);
-                    } else {
-                        sprintf(param2, "%s", mots_sub[j]);
-                    }
-                }
-            } else {
-
-                //PHRASE DU TYPE "AVANCER DE [DISTANCE]"
-                if (strcmp(mots_sub[j], "metros") == 0 || strcmp(mots_sub[j], "metro") == 0 ||
-                    strcmp(mots_sub[j], "centimetros") == 0 || strcmp(mots_sub[j], "milimetros") == 0) {
-                    if (strcmp(mots_sub[j - 1], "y") == 0) {
-                        result = convertDouble(mots_sub[j - 2]);
-                    } else {
-                        result = convertDouble(mots_sub[j - 1]);
-                    }
-                    if (strcmp(mots_sub[j], "centimetros") == 0) {
-                        result *= 0.01;
-                    } else if (strcmp(mots_sub[j], "milimetros") == 0) {
-                        result *= 0.001;
-                    }
-                    sprintf(param2, "%.3f metros ", result);
-                }
-
-                //PHRASE DU TYPE "AVANCER JUSQU'À L'[OBJET]"
-                //PHRASE DU TYPE "TOURNER JUSQU'À LOCALISER L'[OBJET]"
-                //PHRASE DU TYPE "TOURNER À [DIRECTION] JUSQU'À LOCALISER L'[OBJET]"
-                if (strcmp(mots_sub[j], "bola") == 0 || strcmp(mots_sub[j], "pelota") == 0 ||
-                    strcmp(mots_sub[j], "cuadrado") == 0 || strcmp(mots_sub[j], "cubo") == 0) {
-
-                    if (j + 1 < compt_sub &&
-                        (strcmp(mots_sub[j + 1], "rojo") == 0 || strcmp(mots_sub[j + 1], "roja") == 0 ||
-                         strcmp(mots_sub[j + 1], "azul") == 0 ||
-                         strcmp(mots_sub[j + 1], "amarillo") == 0 || strcmp(mots_sub[j + 1], "amarilla") == 0 ||
-                         strcmp(mots_sub[j + 1], "naranja") == 0)) {
-                        sprintf(param2, "%s %s ", mots_sub[j], mots_sub[j + 1]);
-                    } else {
-                        sprintf(param2, "%s ", mots_sub[j]);
-                    }
-                }
-
-                //PHRASE DU TYPE "TOURNER DE [VAL] DEGRÉS"
-                //PHRASE DU TYPE "TOURNER À [DIRECTION] DE [VAL] DEGRÉS"
-                if (strcmp(mots_sub[j], "derecha") == 0 || strcmp(mots_sub[j], "izquierda") == 0)
-                    sprintf(param1, "%s", mots_sub[j]);
-
-                if (strcmp(mots_sub[j], "grados") == 0 || strcmp(mots_sub[j], "grado") == 0) {
-                    if (strcmp(mots_sub[j - 1], "y") == 0) {
-                        result = convertDouble(mots_sub[j - 2]);
-                    } else {
-                        result = convertDouble(mots_sub[j - 1]);
-                    }
-                    sprintf(param2, "%.0f %s", result, mots_sub[j]);
-                }
-            }
-        }
+void afficher_Action_fr(const char *phrase, Queue* q){
+    analyserPhrase(&GRAMMAIRE_FR, phrase, q);
+}
 
-        //On copie le contenu de action, param1, param2 et type dans les paramétres de resultData, qui est une variable du type ActionData
-        strcpy(resultData.action, action);
-        strcpy(resultData.param1, param1);
-        strcpy(resultData.param2, param2);
-        strcpy(resultData.type, type);
+/**
+ * @brief Une des fonctions principales du code,"afficher_Action_es" traitera une phrase en espagnol
+ * Elle s'aidera de celles défà définies pour traiter une phrase et la tokeniser, pour la pouvoir
+ * ainsi diviser en plusieurs sous-phrases et les traiter individuellement.
+ * @param phrase Chaine de caractères désignant la requette texte.
+ * @param q File qu'on utilisera pour enregistrer les paramettres qu'on utilisera dans le code qui
+ * gére les commandes envoyés au robot
+ * @return Paramettres décrivant l'action, la diréction, les unités d'action (mètres ou degrés),
+ * les obstacles à prendre en compte et si la phrase est une négation ou une affirmation
+ */
 
-        //On enfile le contenu de resultData dans le file du FIFO
-        enqueue(q, resultData);
-    }
+void afficher_Action_es(const char *phrase, Queue* q){
+    analyserPhrase(&GRAMMAIRE_ES, phrase, q);
 }
 
-
 /**
  * @}
  */
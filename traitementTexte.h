@@ -17,32 +17,121 @@
 #include "stdio.h"
 #include "stdlib.h"
 #include "ctype.h"
+#include "lexique.h"
 
+/**
+ * @brief Nature de la mesure d'une action.
+ */
+typedef enum {
+    MESURE_AUCUNE = 0,
+    MESURE_DISTANCE,    /**< valeur est une distance en mètres. */
+    MESURE_ANGLE        /**< valeur est un angle en degrés. */
+} Mesure;
+
+/**
+ * @brief Instruction typée produite pour chaque sous-phrase. Tous les champs sont des codes du lexique ou des
+ * nombres : les modules qui exécutent les actions n'ont aucune chaine à analyser.
+ */
 typedef struct {
-    char action[20];
-    char param1[20];
-    char param2[20];
-    char type[20];
-}ActionData;
+    double valeur;              /**< Distance ou angle, selon mesure. */
+    unsigned char opcode;       /**< Verbe (CodeVerbe), VERBE_AUCUN si la sous-phrase n'en a pas. */
+    unsigned char mesure;       /**< Nature de valeur (Mesure). */
+    unsigned char direction;    /**< CodeDirection. */
+    unsigned char objet;        /**< Objet visé (CodeObjet). */
+    unsigned char couleur;      /**< Couleur de l'objet visé (CodeCouleur). */
+    unsigned char objet2;       /**< Second objet : "trouve la boule ou le cube", "passe entre ... et ...". */
+    unsigned char couleur2;     /**< Couleur du second objet. */
+    unsigned char langue;       /**< Langue de la sous-phrase (LANGUE_FR, LANGUE_ES). */
+    bool negation;              /**< La sous-phrase est négative. */
+} ActionData;
 
-typedef struct node {
-    ActionData data;
-    struct node* next;
-} Node;
+/**
+ * @brief Forme texte d'une ActionData dans sa langue, pour l'affichage.
+ */
+typedef struct {
+    char action[32];
+    char param1[32];
+    char param2[32];
+    char type[32];
+} ActionTexte;
 
+/**
+ * @brief Mot d'une chaine désigné sans copie : pointeur vers son premier octet et longueur.
+ * La chaine n'a pas à être terminée par '\0' à la fin du segment.
+ */
 typedef struct {
-    Node* front;
-    Node* rear;
-    int size;
+    const char *debut;
+    size_t longueur;
+} Segment;
+
+#define PONCTUATION_PHRASE " ',.!?"    //Caractères séparant les mots d'une phrase.
+
+#define QUEUE_CAPACITE_INTEGREE 8    //Nombre d'actions stockées sans allocation.
+
+/**
+ * @brief File circulaire d'ActionData. Les actions sont rangées de façon contiguë, d'abord dans le tampon
+ * intégré à la file, puis dans un tampon alloué qui double de taille quand il est plein. Une file créée
+ * par createQueueFixe() ne dépasse jamais son tampon intégré.
+ */
+typedef struct {
+    ActionData *donnees;                          /**< Tampon alloué, NULL tant que le tampon intégré suffit. */
+    ActionData integre[QUEUE_CAPACITE_INTEGREE];  /**< Tampon intégré. */
+    int capacite;                                 /**< Capacité du tampon utilisé. */
+    int debut;                                    /**< Indice du premier élément. */
+    int size;                                     /**< Nombre d'éléments. */
+    bool fixe;                                    /**< La file ne s'agrandit jamais. */
 } Queue;
 
+/**
+ * @brief Automate de reconnaissance d'un nombre écrit en lettres, alimenté mot par mot.
+ */
+typedef struct {
+    long total;                    /**< Milliers déjà reconnus. */
+    long courant;                  /**< Groupe en cours (inférieur à mille). */
+    int dernier;                   /**< Valeur du dernier mot-nombre. */
+    bool actif;                    /**< Un nombre est en cours de reconnaissance. */
+    const EntreeLexique *liaison;  /**< Liaison ("et", "y") en attente du mot suivant. */
+} AutomateNombre;
+
+/**
+ * @brief Langue traitée par le moteur d'analyse : son vocabulaire (les mots du lexique marqués de cette
+ * langue) et les libellés utilisés dans les ActionData produites.
+ * GRAMMAIRE_AUTO accepte le vocabulaire de toutes les langues et choisit les libellés de la langue identifiée.
+ */
+typedef struct {
+    int langue;                    /**< Langue du vocabulaire dans le lexique. */
+    const char *code;              /**< Code de la langue ("fr", "es"). */
+    const char *type_negative;     /**< Type d'une sous-phrase négative ("Négative"). */
+    const char *type_affirmative;  /**< Type d'une sous-phrase affirmative ("Affirmative"). */
+    const char *unite_distance;    /**< Unité écrite après une distance ("mètres"). */
+    const char *unite_angle;       /**< Unité écrite après un angle ("degrés"). */
+} Grammaire;
+
+/**
+ * @brief Analyseur incrémental d'un texte reçu par morceaux (voir analyseurFlux_ajouter).
+ */
+typedef struct AnalyseurFlux AnalyseurFlux;
+
+extern const Grammaire GRAMMAIRE_FR;
+extern const Grammaire GRAMMAIRE_ES;
+extern const Grammaire GRAMMAIRE_AUTO;
+
 double convertDouble(char *str);
+bool segment_suivant(const char **curseur, const char *separateurs, Segment *s);
+double segment_nombre(Segment s);
 void toLowercase(char *str);
 
 Queue createQueue();
-void enqueue(Queue* q, ActionData data);
+Queue createQueueFixe();
+void destroyQueue(Queue* q);
+bool reserveQueue(Queue* q, int capacite);
+bool enqueue(Queue* q, ActionData data);
 ActionData dequeue(Queue* q);
-int isQueueEmpty(Queue q);
+int isQueueEmpty(const Queue* q);
+
+void nombre_initialiser(AutomateNombre *a);
+bool nombre_ajouter(AutomateNombre *a, const EntreeLexique *e);
+long nombre_terminer(AutomateNombre *a, const EntreeLexique **liaison);
 
 int str_to_num_fr(char *nombre);
 int str_to_num_es(char *nombre);
@@ -53,6 +142,13 @@ int num_to_chiffre_tot_es(char *str);
 bool detect_chiffre_fr(const char *word);
 bool detect_chiffre_es(const char *word);
 
-void afficher_Action_fr(char *phrase, Queue* q);
-void afficher_Action_es(char *phrase, Queue* q);
+void action_versTexte(const ActionData *a, ActionTexte *t);
+const Grammaire *grammaire_langue(int langue);
+const Grammaire *analyserPhrase(const Grammaire *g, const char *phrase, Queue *q);
+AnalyseurFlux *analyseurFlux_creer(const Grammaire *g, Queue *q);
+void analyseurFlux_detruire(AnalyseurFlux *f);
+void analyseurFlux_ajouter(AnalyseurFlux *f, const char *texte, size_t longueur);
+const Grammaire *analyseurFlux_terminer(AnalyseurFlux *f);
+void afficher_Action_fr(const char *phrase, Queue* q);
+void afficher_Action_es(const char *phrase, Queue* q);
 #endif
@@ -0,0 +1,393 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "trajectoire.h"
+
+/**
+ * @file
+ * @brief Ce fichier rassemble les fonctions du journal de trajectoire.
+ *
+ * Un journal est une suite de simulations enregistrées, chacune composée d'un entête puis d'enregistrements :
+ * @code
+ * entête      "MBTJ", version, options (bit 0 : obstacles), pas d'horloge et vitesses, numéro, nom, scène,
+ *             pose de départ exacte
+ * POSE        type, pas d'horloge écoulés, écarts de x, de y et du cap, quantifiés
+ * COMMANDE    type, opcode, couleur, sens, valeur exacte
+ * FIN         type, collisions, pose d'arrivée exacte
+ * @endcode
+ * Les entiers sont des varints (7 bits par octet, poids faibles d'abord), zigzag pour les entiers signés ; les
+ * flottants sont les 8 octets de leur représentation, petit-boutiste. Une pose qui suit un déplacement ou une
+ * rotation tient ainsi en 5 à 10 octets. Les poses sont quantifiées à partir de leurs valeurs absolues, les erreurs
+ * ne s'accumulent donc pas d'une pose à l'autre ; les commandes et les poses exactes permettent de rejouer la
+ * simulation à l'identique.
+ */
+
+/**
+ * @defgroup trajectoire Journal de trajectoire
+ * @brief Enregistrement compact et relecture des simulations.
+ * @{
+ */
+
+#define TRAJECTOIRE_TAILLE_ENTETE_MAX (6 + 3 * 8 + 2 * 10 + TRAJECTOIRE_NOM_MAX + 17 * 10 + 4 * 8)
+
+void journal_initialiser(JournalTrajectoire *j) {
+    j->donnees = NULL;
+    j->capacite = j->longueur = 0;
+    j->erreur = false;
+    j->pas = j->x = j->y = j->cap = 0;
+}
+
+void journal_detruire(JournalTrajectoire *j) {
+    free(j->donnees);
+    journal_initialiser(j);
+}
+
+/**
+ * @brief Réserve la place de taille octets de plus.
+ * @return Adresse de la place réservée, NULL si la mémoire manque.
+ */
+static unsigned char *reserver(JournalTrajectoire *j, size_t taille) {
+    if (j->erreur) {
+        return NULL;
+    }
+    if (j->longueur + taille > j->capacite) {
+        size_t capacite = (j->capacite > 0) ? 2 * j->capacite : 4096;
+        while (capacite < j->longueur + taille) {
+            capacite *= 2;
+        }
+        unsigned char *donnees = realloc(j->donnees, capacite);
+        if (donnees == NULL) {
+            j->erreur = true;
+            return NULL;
+        }
+        j->donnees = donnees;
+        j->capacite = capacite;
+    }
+    return j->donnees + j->longueur;
+}
+
+static unsigned char *ecrireVarint(unsigned char *p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (unsigned char) (v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (unsigned char) v;
+    return p;
+}
+
+static unsigned char *ecrireSigne(unsigned char *p, int64_t v) {
+    return ecrireVarint(p, ((uint64_t) v << 1) ^ (uint64_t) (v >> 63));
+}
+
+static unsigned char *ecrireReel(unsigned char *p, double valeur) {
+    uint64_t bits;
+    memcpy(&bits, &valeur, sizeof(bits));
+    for (int i = 0; i < 8; i++) {
+        *p++ = (unsigned char) (bits >> (8 * i));
+    }
+    return p;
+}
+
+static unsigned char *ecrirePose(unsigned char *p, const Pose *pose) {
+    p = ecrireReel(p, pose->x);
+    p = ecrireReel(p, pose->y);
+    p = ecrireReel(p, pose->ox);
+    return ecrireReel(p, pose->oy);
+}
+
+/**
+ * @brief Commence l'enregistrement d'une simulation : entête, puis pose de départ au pas sim->pas.
+ * @param numero, nom Identifient la simulation dans le journal (phrase, image de la scène...).
+ */
+void journal_commencer(JournalTrajectoire *j, const Simulation *sim, int numero, const char *nom) {
+    size_t longueur_nom = strnlen(nom, TRAJECTOIRE_NOM_MAX - 1);
+    unsigned char *p = reserver(j, TRAJECTOIRE_TAILLE_ENTETE_MAX);
+
+    if (p == NULL) {
+        return;
+    }
+    memcpy(p, TRAJECTOIRE_MAGIQUE, 4);
+    p[4] = TRAJECTOIRE_VERSION;
+    p[5] = (sim->carte != NULL) ? 1 : 0;
+    p = ecrireReel(p + 6, sim->horloge.pas);
+    p = ecrireReel(p, sim->horloge.vitesse_lineaire);
+    p = ecrireReel(p, sim->horloge.vitesse_angulaire);
+    p = ecrireVarint(p, (uint64_t) (numero > 0 ? numero : 0));
+    p = ecrireVarint(p, longueur_nom);
+    memcpy(p, nom, longueur_nom);
+    p += longueur_nom;
+    p = ecrireSigne(p, sim->scene.coin_HD[0]);
+    p = ecrireSigne(p, sim->scene.coin_HD[1]);
+    for (int c = 0; c < 5; c++) {
+        p = ecrireSigne(p, sim->scene.boules[c].rayon);
+        p = ecrireSigne(p, sim->scene.boules[c].milieu[0]);
+        p = ecrireSigne(p, sim->scene.boules[c].milieu[1]);
+    }
+    p = ecrirePose(p, &sim->pose);
+    j->longueur = (size_t) (p - j->donnees);
+    j->pas = j->x = j->y = j->cap = 0;
+    journal_pose(j, sim->pas, &sim->pose);
+}
+
+/**
+ * @brief Enregistre la pose du robot au pas d'horloge pas.
+ */
+void journal_pose(JournalTrajectoire *j, long long pas, const Pose *pose) {
+    unsigned char *p = reserver(j, 1 + 4 * 10);
+    long long x = llround(pose->x * TRAJECTOIRE_QUANTUM), y = llround(pose->y * TRAJECTOIRE_QUANTUM);
+    long long tour = llround(360.0 * TRAJECTOIRE_QUANTUM);
+    long long cap = llround(atan2(pose->oy, pose->ox) * (180.0 / M_PI) * TRAJECTOIRE_QUANTUM) % tour;
+    long long ecart_cap;
+
+    if (p == NULL) {
+        return;
+    }
+    cap = (cap < 0) ? cap + tour : cap;
+    //Ecart de cap ramené dans ]-180,180] degrés.
+    ecart_cap = (cap - j->cap) % tour;
+    if (ecart_cap > tour / 2) {
+        ecart_cap -= tour;
+    } else if (ecart_cap <= -tour / 2) {
+        ecart_cap += tour;
+    }
+    *p++ = TRAJECTOIRE_POSE;
+    p = ecrireVarint(p, (uint64_t) (pas > j->pas ? pas - j->pas : 0));
+    p = ecrireSigne(p, x - j->x);
+    p = ecrireSigne(p, y - j->y);
+    p = ecrireSigne(p, ecart_cap);
+    j->longueur = (size_t) (p - j->donnees);
+    j->pas = (pas > j->pas) ? pas : j->pas;
+    j->x = x;
+    j->y = y;
+    j->cap = cap;
+}
+
+/**
+ * @brief Enregistre une commande au moment où elle est exécutée.
+ */
+void journal_commande(JournalTrajectoire *j, const Commande *commande) {
+    unsigned char *p = reserver(j, 4 + 8);
+
+    if (p == NULL) {
+        return;
+    }
+    p[0] = TRAJECTOIRE_COMMANDE;
+    p[1] = commande->opcode;
+    p[2] = commande->couleur;
+    p[3] = (unsigned char) commande->sens;
+    p = ecrireReel(p + 4, commande->valeur);
+    j->longueur = (size_t) (p - j->donnees);
+}
+
+/**
+ * @brief Termine l'enregistrement de la simulation : nombre de collisions et pose d'arrivée.
+ */
+void journal_terminer(JournalTrajectoire *j, const Simulation *sim) {
+    unsigned char *p = reserver(j, 1 + 10 + 4 * 8);
+
+    if (p == NULL) {
+        return;
+    }
+    *p++ = TRAJECTOIRE_FIN;
+    p = ecrireVarint(p, (uint64_t) sim->collisions);
+    p = ecrirePose(p, &sim->pose);
+    j->longueur = (size_t) (p - j->donnees);
+}
+
+/**
+ * @brief Ecrit les simulations enregistrées dans un fichier et vide le journal, qui peut servir à nouveau.
+ * @return false si le journal est incomplet ou si l'écriture a échoué.
+ */
+bool journal_ecrire(JournalTrajectoire *j, FILE *f) {
+    bool ok = !j->erreur && fwrite(j->donnees, 1, j->longueur, f) == j->longueur;
+    j->longueur = 0;
+    j->erreur = false;
+    return ok;
+}
+
+/**
+ * @brief Lecture bornée d'un journal : toute lecture au-delà de la fin, ou de valeur hors limites, met erreur à true.
+ */
+typedef struct {
+    const unsigned char *p, *fin;
+    bool erreur;
+} Lecteur;
+
+static uint64_t lireVarint(Lecteur *l) {
+    uint64_t v = 0;
+    for (int decalage = 0; decalage < 64; decalage += 7) {
+        if (l->p >= l->fin) {
+            l->erreur = true;
+            return 0;
+        }
+        unsigned char octet = *l->p++;
+        v |= (uint64_t) (octet & 0x7f) << decalage;
+        if (!(octet & 0x80)) {
+            return v;
+        }
+    }
+    l->erreur = true;
+    return 0;
+}
+
+static int64_t lireSigne(Lecteur *l) {
+    uint64_t v = lireVarint(l);
+    return (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+}
+
+/**
+ * @brief Lit un entier signé compris entre min et max ; une valeur hors limites met erreur à true.
+ */
+static int lireEntier(Lecteur *l, int64_t min, int64_t max) {
+    int64_t v = lireSigne(l);
+    if (v < min || v > max) {
+        l->erreur = true;
+        return 0;
+    }
+    return (int) v;
+}
+
+static unsigned char lireOctet(Lecteur *l) {
+    if (l->p >= l->fin) {
+        l->erreur = true;
+        return 0;
+    }
+    return *l->p++;
+}
+
+static double lireReel(Lecteur *l) {
+    uint64_t bits = 0;
+    double valeur;
+    for (int i = 0; i < 8; i++) {
+        bits |= (uint64_t) lireOctet(l) << (8 * i);
+    }
+    memcpy(&valeur, &bits, sizeof(valeur));
+    return valeur;
+}
+
+static void lirePose(Lecteur *l, Pose *pose) {
+    pose->x = lireReel(l);
+    pose->y = lireReel(l);
+    pose->ox = lireReel(l);
+    pose->oy = lireReel(l);
+}
+
+/**
+ * @brief Ajoute un élément à un tableau dynamique dont la capacité double.
+ * @return Adresse du nouvel élément, NULL si la mémoire manque.
+ */
+static void *agrandir(void **tableau, int *nb, int *capacite, size_t taille) {
+    if (*nb == *capacite) {
+        int nouvelle = (*capacite > 0) ? 2 * *capacite : 64;
+        void *t = realloc(*tableau, (size_t) nouvelle * taille);
+        if (t == NULL) {
+            return NULL;
+        }
+        *tableau = t;
+        *capacite = nouvelle;
+    }
+    return (char *) *tableau + (size_t) (*nb)++ * taille;
+}
+
+/**
+ * @brief Vérifie que le pas et les vitesses relus sont des réels strictement positifs.
+ */
+static bool horlogeValide(const ParametresHorloge *h) {
+    return isfinite(h->pas) && h->pas > 0.0 && isfinite(h->vitesse_lineaire) && h->vitesse_lineaire > 0.0
+           && isfinite(h->vitesse_angulaire) && h->vitesse_angulaire > 0.0;
+}
+
+/**
+ * @brief Relit la première simulation d'un journal.
+ * @param t Reçoit la simulation ; à libérer par trajectoire_detruire, même en cas d'erreur.
+ * @return Nombre d'octets de la simulation, 0 si le journal est terminé, -1 s'il est invalide ou tronqué.
+ */
+long trajectoire_lire(const unsigned char *octets, size_t taille, TrajectoireLue *t) {
+    Lecteur l = {octets, octets + taille, false};
+    int capacite_poses = 0, capacite_commandes = 0;
+    long long pas = 0, x = 0, y = 0, cap = 0;
+    size_t longueur_nom;
+
+    memset(t, 0, sizeof(*t));
+    if (taille == 0) {
+        return 0;
+    }
+    if (taille < 6 || memcmp(octets, TRAJECTOIRE_MAGIQUE, 4) != 0 || octets[4] != TRAJECTOIRE_VERSION) {
+        return -1;
+    }
+    t->obstacles = octets[5] & 1;
+    l.p += 6;
+    t->horloge.pas = lireReel(&l);
+    t->horloge.vitesse_lineaire = lireReel(&l);
+    t->horloge.vitesse_angulaire = lireReel(&l);
+    t->numero = (int) lireVarint(&l);
+    longueur_nom = lireVarint(&l);
+    if (l.erreur || !horlogeValide(&t->horloge) || longueur_nom >= TRAJECTOIRE_NOM_MAX || longueur_nom > (size_t) (l.fin - l.p)) {
+        return -1;
+    }
+    memcpy(t->nom, l.p, longueur_nom);
+    l.p += longueur_nom;
+    //Une scène démesurée ferait construire une carte démesurée (simulation_construireCarte).
+    t->scene.coin_HD[0] = lireEntier(&l, 0, TRAJECTOIRE_DEMI_COTE_MAX);
+    t->scene.coin_HD[1] = lireEntier(&l, 0, TRAJECTOIRE_DEMI_COTE_MAX);
+    for (int c = 0; c < 5; c++) {
+        t->scene.boules[c].rayon = lireEntier(&l, -1, TRAJECTOIRE_DEMI_COTE_MAX);
+        t->scene.boules[c].milieu[0] = lireEntier(&l, -TRAJECTOIRE_DEMI_COTE_MAX, TRAJECTOIRE_DEMI_COTE_MAX);
+        t->scene.boules[c].milieu[1] = lireEntier(&l, -TRAJECTOIRE_DEMI_COTE_MAX, TRAJECTOIRE_DEMI_COTE_MAX);
+    }
+    lirePose(&l, &t->depart);
+    if (l.erreur) {
+        return -1;
+    }
+
+    while (!l.erreur) {
+        unsigned char type = lireOctet(&l);
+        if (type == TRAJECTOIRE_POSE) {
+            pas += (long long) lireVarint(&l);
+            x += lireSigne(&l);
+            y += lireSigne(&l);
+            cap += lireSigne(&l);
+            PoseDatee *pose = agrandir((void **) &t->poses, &t->nb_poses, &capacite_poses, sizeof(PoseDatee));
+            if (pose == NULL) {
+                return -1;
+            }
+            pose->temps = pas * t->horloge.pas;
+            pose->x = x / TRAJECTOIRE_QUANTUM;
+            pose->y = y / TRAJECTOIRE_QUANTUM;
+            pose->cap = cap / TRAJECTOIRE_QUANTUM;
+        } else if (type == TRAJECTOIRE_COMMANDE) {
+            Commande *c = agrandir((void **) &t->commandes, &t->nb_commandes, &capacite_commandes, sizeof(Commande));
+            if (c == NULL) {
+                return -1;
+            }
+            c->opcode = lireOctet(&l);
+            c->couleur = lireOctet(&l);
+            c->sens = (signed char) lireOctet(&l);
+            c->valeur = lireReel(&l);
+            if (c->couleur > COULEUR_ORANGE || !isfinite(c->valeur)) {    //La couleur indexe les boules de la scène.
+                return -1;
+            }
+        } else if (type == TRAJECTOIRE_FIN) {
+            t->collisions = (int) lireVarint(&l);
+            lirePose(&l, &t->arrivee);
+            return l.erreur ? -1 : (long) (l.p - octets);
+        } else {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+void trajectoire_detruire(TrajectoireLue *t) {
+    free(t->poses);
+    free(t->commandes);
+    t->poses = NULL;
+    t->commandes = NULL;
+    t->nb_poses = t->nb_commandes = 0;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,78 @@
+/**
+ * @file
+ * @brief Ce fichier contient les déclarations du journal de trajectoire.
+ * Chaque simulation peut enregistrer ce que fait le robot dans un format binaire compact : la scène, les commandes
+ * exécutées et la pose du robot après chaque mouvement, datée en pas d'horloge et codée par différence avec la
+ * précédente. Le journal permet de retracer ou de rejouer exactement la simulation (voir rejeu.c).
+ */
+
+#ifndef TRAJECTOIRE_H
+#define TRAJECTOIRE_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "simulation.h"
+
+#define TRAJECTOIRE_MAGIQUE "MBTJ"
+#define TRAJECTOIRE_VERSION 2
+#define TRAJECTOIRE_QUANTUM 1000.0        //Positions enregistrées au millième d'unité, caps au millième de degré.
+#define TRAJECTOIRE_NOM_MAX 256           //Taille maximale du nom d'une simulation, '\0' compris.
+#define TRAJECTOIRE_DEMI_COTE_MAX 1024    //Coordonnée maximale (en valeur absolue) d'une scène relue : coin, centres, rayons.
+
+/**
+ * @brief Type de chaque enregistrement qui suit l'entête d'une simulation.
+ */
+typedef enum {
+    TRAJECTOIRE_POSE = 0,       /**< Pas d'horloge écoulés, puis écarts de x, de y et du cap aux valeurs précédentes. */
+    TRAJECTOIRE_COMMANDE,       /**< Commande exécutée : opcode, couleur, sens et valeur exacte. */
+    TRAJECTOIRE_FIN             /**< Nombre de collisions, puis pose finale exacte. */
+} TypeTrajectoire;
+
+/**
+ * @brief Journal en cours d'écriture : les octets des simulations enregistrées depuis le dernier journal_ecrire.
+ */
+struct JournalTrajectoire {
+    unsigned char *donnees;
+    size_t capacite, longueur;
+    bool erreur;                        /**< true si la mémoire a manqué : le journal est incomplet. */
+    long long pas, x, y, cap;           /**< Dernière pose enregistrée, quantifiée. */
+};
+
+/**
+ * @brief Pose relue dans un journal, aux quanta près.
+ */
+typedef struct {
+    double temps;       /**< Secondes de simulation. */
+    double x, y, cap;
+} PoseDatee;
+
+/**
+ * @brief Simulation relue dans un journal.
+ */
+typedef struct {
+    int numero;
+    char nom[TRAJECTOIRE_NOM_MAX];
+    bool obstacles;                 /**< La simulation était arrêtée par les boules. */
+    ParametresHorloge horloge;      /**< Pas et vitesses de la simulation ; le facteur de temps réel n'est pas enregistré. */
+    Scene scene;
+    Pose depart;                    /**< Pose exacte au début de l'enregistrement. */
+    PoseDatee *poses;
+    int nb_poses;
+    Commande *commandes;
+    int nb_commandes;
+    Pose arrivee;                   /**< Pose exacte à la fin de l'enregistrement. */
+    int collisions;
+} TrajectoireLue;
+
+void journal_initialiser(JournalTrajectoire *j);
+void journal_detruire(JournalTrajectoire *j);
+void journal_commencer(JournalTrajectoire *j, const Simulation *sim, int numero, const char *nom);
+void journal_pose(JournalTrajectoire *j, long long pas, const Pose *pose);
+void journal_commande(JournalTrajectoire *j, const Commande *commande);
+void journal_terminer(JournalTrajectoire *j, const Simulation *sim);
+bool journal_ecrire(JournalTrajectoire *j, FILE *f);
+
+long trajectoire_lire(const unsigned char *octets, size_t taille, TrajectoireLue *t);
+void trajectoire_detruire(TrajectoireLue *t);
+
+#endif